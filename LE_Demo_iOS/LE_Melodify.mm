@@ -8,26 +8,35 @@
 
 #import <Foundation/Foundation.h>
 
+#include "le/audioio/decodedAudioCache.hpp"
 #include "le/audioio/device.hpp"
 #include "le/audioio/file.hpp"
 #include "le/audioio/outputWaveFile.hpp"
+#include "le/audioio/prefetchingFile.hpp"
+#include "le/audioio/resampler.hpp"
 
+#include "le/melodify/compiledMelody.hpp"
 #include "le/melodify/melodifyer.hpp"
+#include "le/melodify/offlineRenderer.hpp"
+#include "le/melodify/statistics.hpp"
+#include "le/melodify/stems.hpp"
 
 #include "le/utility/entryPoint.hpp"
 #include "le/utility/filesystem.hpp"
+#include "le/utility/parallel.hpp"
 #include "le/utility/trace.hpp"
 #include "le/utility/sleep.hpp"
 
 #include <algorithm>
 #include <cerrno>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
-#include <ctime>
 #include <memory>
 #include <new>
+#include <vector>
 
 class LE_Melodify {
     
@@ -54,6 +63,71 @@ class LE_Melodify {
     
     //------------------------------------------------------------------------------
     
+    static void printStatistics( LE::SW::ProcessingStatistics const & statistics, unsigned int const sampleRate )
+    {
+        using namespace LE;
+        for ( unsigned int stage( 0 ); stage < SW::ProcessingStatistics::NumberOfStages; ++stage )
+        {
+            SW::ProcessingStatistics::Stage    const stageID ( static_cast<SW::ProcessingStatistics::Stage>( stage ) );
+            SW::ProcessingStatistics::Counters const counters( statistics.counters( stageID )                      );
+            if ( !counters.calls )
+                continue;
+            Utility::Tracer::formattedMessage
+            (
+             "\t%-18s: %8.2f ms in %6llu calls (%.2f us/call, %.0fx real time).",
+             SW::ProcessingStatistics::stageName( stageID ),
+             counters.nanoseconds / 1e6,
+             static_cast<unsigned long long>( counters.calls ),
+             counters.nanoseconds / 1e3 / counters.calls,
+             counters.nanoseconds ? counters.samples * 1e9 / sampleRate / counters.nanoseconds : 0.0
+             );
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    
+    // Reads the whole file through the (already set up) resampler in chunks,
+    // skipping the resampler latency and flushing it at the end of the file,
+    // so no full length buffer at the original samplerate is needed.
+    static unsigned int readResampled( LE::AudioIO::PrefetchingFile & file, LE::AudioIO::Resampler & resampler, float * const pOutput, unsigned int const numberOfOutputFrames )
+    {
+        unsigned int const numberOfChannels( file.numberOfChannels() );
+        unsigned int const chunkFrames     ( 1024 / numberOfChannels );
+        float input  [ 1024 ];
+        float discard[ 1024 ];
+        
+        unsigned int skip     ( resampler.latencyInOutputFrames   () );
+        unsigned int flush    ( resampler.flushLengthInInputFrames() );
+        unsigned int available( 0 ), offset( 0 ), produced( 0 );
+        bool         endOfFile( false );
+        while ( produced < numberOfOutputFrames )
+        {
+            if ( offset == available )
+            {
+                offset    = 0;
+                available = endOfFile ? 0 : file.waitAndRead( input, chunkFrames );
+                if ( !available )
+                {
+                    endOfFile = true;
+                    if ( !flush )
+                        break;
+                    available = std::min( flush, chunkFrames );
+                    flush    -= available;
+                    std::fill_n( input, available * numberOfChannels, 0.0f );
+                }
+            }
+            unsigned int inputFrames ( available - offset                                              );
+            unsigned int outputFrames( skip ? std::min( skip, chunkFrames ) : numberOfOutputFrames - produced );
+            resampler.process( &input[ offset * numberOfChannels ], inputFrames, skip ? discard : &pOutput[ produced * numberOfChannels ], outputFrames );
+            offset += inputFrames;
+            if ( skip ) skip     -= outputFrames;
+            else        produced += outputFrames;
+        }
+        return produced;
+    }
+    
+    //------------------------------------------------------------------------------
+    
     bool processingExample()
     {
         ////////////////////////////////////////////////////////////////////////////
@@ -94,93 +168,153 @@ class LE_Melodify {
         typedef float sample_t;
         typedef std::auto_ptr<sample_t> Buffer;
         
-        AudioIO::File backgroundFile;
-        char const * pErrorMessage( backgroundFile.open<resourcesLocation>( inputBackgroundFileName ) );
+        // The (always the same) background is decoded only on the first run,
+        // later runs memory map the cached decoded samples. The voice is
+        // decoded ahead on a worker thread while this thread sets up and
+        // copies out the decoded data.
+        AudioIO::MappedWaveFile backgroundFile;
+        char const * pErrorMessage( AudioIO::DecodedAudioCache::open<resourcesLocation>( inputBackgroundFileName, backgroundFile ) );
         if ( pErrorMessage )
         {
             Utility::Tracer::formattedError( "Failed to open background input file: %s (%s, errno: %d).", inputBackgroundFileName, pErrorMessage, errno );
             return false;
         }
         
+        AudioIO::PrefetchingFile inputFile;
+        pErrorMessage = inputFile.open<resourcesLocation>( inputVoiceFileName );
+        if ( pErrorMessage )
+        {
+            Utility::Tracer::error( pErrorMessage );
+            return false;
+        }
+        
         auto const sampleRate               ( backgroundFile.sampleRate      () );
         auto const numberOfChannels         ( backgroundFile.numberOfChannels() );
         auto       numberOfBackgroundSamples( backgroundFile.lengthInSamples () );
         
+        // The Melodifyer processes mono or stereo data: for multichannel
+        // (e.g. 5.1) backgrounds a mono (downmixed) voice is melodified and
+        // then mixed into the background bed.
+        bool         const multichannelBed   ( numberOfChannels > 2                  );
+        unsigned int const processingChannels( multichannelBed ? 1 : numberOfChannels );
+        
 //        SW::Melodifyer melodifyer;
-        melodifyer.setup( sampleRate, numberOfChannels );
+        melodifyer.setup( sampleRate, processingChannels );
         
         // We are doing offline processing so we can use the latency information to
         // compensate for the inherent delay.
         auto const latency( melodifyer.latencyInSamples() );
         Buffer const pBackground( new sample_t[ ( latency + numberOfBackgroundSamples ) * numberOfChannels ] );
-        std::fill_n( pBackground.get(), latency, 0.0f );
-        numberOfBackgroundSamples = backgroundFile.read( &pBackground.get()[ latency ], numberOfBackgroundSamples );
+        std::fill_n( pBackground.get(), latency * numberOfChannels, 0.0f );
+        numberOfBackgroundSamples = backgroundFile.read( &pBackground.get()[ latency * numberOfChannels ], 0, numberOfBackgroundSamples );
         
         unsigned int const melodyTrack  ( 1 );
         unsigned int const melodyChannel( 0 );
-        pErrorMessage = melodifyer.setMelodyMIDIFile<resourcesLocation>( inputMIDIFileName, melodyTrack, melodyChannel );
+        // The melody is parsed only once and then shared by the offline
+        // renderer and the real time Melodifyer.
+        SW::CompiledMelody::Ptr pMelody;
+        pErrorMessage = SW::CompiledMelody::create<resourcesLocation>( inputMIDIFileName, melodyTrack, melodyChannel, pMelody );
+        if ( !pErrorMessage )
+            pErrorMessage = pMelody->attachTo( melodifyer );
         if ( pErrorMessage )
         {
             Utility::Tracer::error( pErrorMessage );
             return false;
         }
         
-        AudioIO::File inputFile;
-        pErrorMessage = inputFile.open<resourcesLocation>( inputVoiceFileName );
-        if ( pErrorMessage )
-        {
-            Utility::Tracer::error( pErrorMessage );
-            return false;
-        }
-        if ( inputFile.sampleRate() != sampleRate )
-        {
-            Utility::Tracer::error( "Voice and background inputs have mismatched samplerates." );
-            return false;
-        } else{
-            Utility::Tracer::formattedMessage( "Voice samplerates: %ld", inputFile.sampleRate());
-            Utility::Tracer::formattedMessage( "Background samplerates: %ld", sampleRate);
-        }
-        if ( inputFile.numberOfChannels() != numberOfChannels )
+        Utility::Tracer::formattedMessage( "Voice samplerates: %ld", inputFile.sampleRate());
+        Utility::Tracer::formattedMessage( "Background samplerates: %ld", sampleRate);
+        // A multichannel bed takes a mono or stereo voice (it gets downmixed),
+        // otherwise the voice and the background have to match.
+        auto const voiceChannels( inputFile.numberOfChannels() );
+        Utility::Tracer::formattedMessage( "Voice numberOfChannel: %ld", voiceChannels );
+        Utility::Tracer::formattedMessage( "Background numberOfChannel: %ld", numberOfChannels );
+        if ( multichannelBed ? ( voiceChannels > 2 ) : ( voiceChannels != numberOfChannels ) )
         {
             Utility::Tracer::error( "Voice and background inputs have mismatched number of channels." );
-            Utility::Tracer::formattedMessage( "Voice numberOfChannel: %ld", inputFile.numberOfChannels());
-            Utility::Tracer::formattedMessage( "Background numberOfChannel: %ld", numberOfChannels);
             return false;
-        } else {
-            Utility::Tracer::formattedMessage( "Voice numberOfChannel: %ld", inputFile.numberOfChannels());
-            Utility::Tracer::formattedMessage( "Background numberOfChannel: %ld", numberOfChannels);
         }
-        if ( numberOfChannels != 1 && numberOfChannels != 2 )
+        // A voice recorded at a different samplerate is converted to the
+        // background (processing) samplerate while it is being read.
+        AudioIO::Resampler voiceResampler;
+        bool const resampleVoice( inputFile.sampleRate() != sampleRate );
+        if ( resampleVoice )
         {
-            Utility::Tracer::error( "Only mono and stereo input is supported." );
-            return false;
+            pErrorMessage = voiceResampler.setup( inputFile.sampleRate(), sampleRate, voiceChannels );
+            if ( pErrorMessage )
+            {
+                Utility::Tracer::error( pErrorMessage );
+                return false;
+            }
         }
         
-        auto numberOfInputSamples( inputFile.lengthInSamples() );
+        auto numberOfInputSamples( resampleVoice ? voiceResampler.outputLength( inputFile.lengthInSamples() ) : inputFile.lengthInSamples() );
+        // (Sized for the background channel count: the output is rendered and,
+        // for multichannel beds, remixed in place.)
         Buffer const pMainInput( new sample_t[ numberOfChannels * numberOfInputSamples ] );
-        numberOfInputSamples = inputFile.read( pMainInput.get(), numberOfInputSamples );
-        
-        Buffer const pOutput( new sample_t[ numberOfChannels * numberOfBackgroundSamples ] );
+        numberOfInputSamples = resampleVoice
+            ? readResampled( inputFile, voiceResampler, pMainInput.get(), numberOfInputSamples )
+            : inputFile.waitAndRead( pMainInput.get(), numberOfInputSamples );
+        if ( multichannelBed )
+        {
+            // Downmix the voice in place (to the start of the buffer).
+            for ( unsigned int frame( 0 ); frame < numberOfInputSamples; ++frame )
+            {
+                float sum( 0 );
+                for ( unsigned int channel( 0 ); channel < voiceChannels; ++channel )
+                    sum += pMainInput.get()[ frame * voiceChannels + channel ];
+                pMainInput.get()[ frame ] = sum / voiceChannels;
+            }
+        }
+        sample_t * const pOutput( pMainInput.get() );
         
         Utility::Tracer::message( "Processing input data..." );
         
-        std::clock_t const startTime( std::clock() );
+        // The offline render is split into segments that are processed in
+        // parallel (each by its own Melodifyer), the output is already latency
+        // compensated so the background is passed without the latency padding.
+        // The voice buffer is not needed afterwards so the output is rendered
+        // in place (into the voice buffer) saving a full length output buffer.
+        Utility::WorkerPool workerPool;
+        
+        // Per stage timing (pass nullptr instead to disable the instrumentation).
+        SW::ProcessingStatistics statistics;
+        SW::OfflineRenderSettings renderSettings;
+        renderSettings.pStatistics = &statistics;
+        // Skip the Melodifyer for (practically) silent parts of the voice
+        // (below -60 dBFS), they get the plain background.
+        renderSettings.voiceActivityThreshold = 0.001f;
+        
+        auto const startTime( std::chrono::steady_clock::now() );
         
         unsigned int const numberOfOutputSamples( std::min( numberOfInputSamples, numberOfBackgroundSamples ) );
-        unsigned int processSize( 1024 );
-        for ( unsigned sample( 0 ); sample < numberOfOutputSamples; sample += processSize )
+        pErrorMessage = SW::renderOffline
+        (
+         pMelody->melody(),
+         sampleRate,
+         processingChannels,
+         pMainInput .get(),
+         multichannelBed ? nullptr : &pBackground.get()[ latency * numberOfChannels ],
+         pOutput,
+         numberOfOutputSamples,
+         workerPool,
+         renderSettings
+         );
+        if ( pErrorMessage )
         {
-            processSize = std::min<unsigned int>( processSize, numberOfOutputSamples - sample );
-            melodifyer.process
-            (
-             &pMainInput .get()[ sample * numberOfChannels ],
-             &pBackground.get()[ sample * numberOfChannels ],
-             &pOutput    .get()[ sample * numberOfChannels ],
-             processSize
-             );
+            Utility::Tracer::error( pErrorMessage );
+            return false;
+        }
+        // The mono voice is expanded (in place) into the multichannel bed,
+        // into the centre channel only (see SW::remixIntoBed()).
+        if ( multichannelBed )
+        {
+            std::vector<float> voiceChannelGains( numberOfChannels );
+            SW::centreVoiceGains( numberOfChannels, voiceChannelGains.data() );
+            SW::remixIntoBed( pOutput, &pBackground.get()[ latency * numberOfChannels ], pOutput, numberOfChannels, numberOfOutputSamples, voiceChannelGains.data() );
         }
         
-        float        const elapsedMilliseconds  ( ( std::clock() - startTime ) * 1000.0f / CLOCKS_PER_SEC                  );
+        float        const elapsedMilliseconds  ( std::chrono::duration<float, std::milli>( std::chrono::steady_clock::now() - startTime ).count() );
         float        const dataMilliseconds     ( numberOfOutputSamples        * 1000.0f / sampleRate                      );
         float        const processingSpeedRatio ( dataMilliseconds      / elapsedMilliseconds                              );
         unsigned int const totalProcessedSamples( numberOfOutputSamples * numberOfChannels * ( pBackground.get() ? 2 : 1 ) );
@@ -192,6 +326,7 @@ class LE_Melodify {
          processingSpeedRatio,
          totalProcessedSamples / elapsedMilliseconds
          );
+        printStatistics( statistics, sampleRate );
         
         
         ////////////////////////////////////////////////////////////////////////////
@@ -207,11 +342,7 @@ class LE_Melodify {
             }
             
             Utility::Tracer::formattedMessage( "Writing processed data to %s...\n", Utility::fullPath<resultsLocation>( outputFileName ) );
-            pErrorMessage = outputFile.write
-            (
-             &pOutput.get()[ numberOfChannels * latency ],
-             numberOfChannels * ( numberOfOutputSamples - latency )
-             );
+            pErrorMessage = outputFile.write( pOutput, numberOfOutputSamples );
             if ( pErrorMessage )
             {
                 Utility::Tracer::formattedError( "Failed to write output file (%s, errno: %d).", pErrorMessage, errno );
@@ -221,13 +352,28 @@ class LE_Melodify {
         
         Utility::Tracer::message( " * real time rendering through the hardware audio device..." );
         
+        // Real time rendering uses a single core.
+        // (Multichannel beds are only played back, the full duplex example
+        // assumes matching device input and output channel layouts.)
+        bool const slowPreset( multichannelBed || processingSpeedRatio / workerPool.numberOfThreads() < 1.5f );
+        
+        // The Melodifyer latency is fixed (by the SDK) so, for live monitoring,
+        // the only part of the total latency that can be traded off is the
+        // device buffering: ask for the smallest practical device buffer in the
+        // full duplex case (playback of preprocessed data is not latency
+        // sensitive so the library is left to pick a safe value there).
+        unsigned int const lowLatencyDeviceBufferHint( 256 );
 //        AudioIO::Device device;
-        if ( auto const err = device.setup( numberOfChannels, sampleRate, 0 ) ) { Utility::Tracer::error( err ); return false; }
+        if ( auto const err = device.setup( numberOfChannels, sampleRate, slowPreset ? 0 : lowLatencyDeviceBufferHint ) ) { Utility::Tracer::error( err ); return false; }
         
-        bool const slowPreset( processingSpeedRatio < 1.5f );
         if ( slowPreset )
         {
-            Utility::Tracer::message( "\t...device too slow for realtime processing, playing preprocessed data and skipping full duplex rendering..." );
+            Utility::Tracer::message
+            (
+             multichannelBed
+                ? "\t...multichannel background, playing preprocessed data and skipping full duplex rendering..."
+                : "\t...device too slow for realtime processing, playing preprocessed data and skipping full duplex rendering..."
+             );
             
             struct PreprocessedOutputContext
             {
@@ -261,7 +407,7 @@ class LE_Melodify {
                     context.pPreprocessedData += interleavedSamples;
                 }
             }; // struct PreprocessedOutputContext
-            PreprocessedOutputContext context = { device, pOutput.get(), numberOfOutputSamples, numberOfChannels };
+            PreprocessedOutputContext context = { device, pOutput, numberOfOutputSamples, numberOfChannels };
             if ( auto err = device.setCallback( &PreprocessedOutputContext::callback, &context ) ) { Utility::Tracer::error( err ); return false; }
             melodifyer.reset();
             context.blockingDevice.startAndWait();
@@ -274,6 +420,8 @@ class LE_Melodify {
                 
                 SW::Melodifyer & processor;
                 
+                SW::ProcessingStatistics * pStatistics;
+                
                 AudioIO::Device::InterleavedInputData pBackgroundData;
                 
                 unsigned int       numberOfSamples ;
@@ -293,13 +441,16 @@ class LE_Melodify {
                     
                     unsigned int const interleavedSamples( numberOfSamples * context.numberOfChannels );
                     
-                    context.processor.process
-                    (
-                     pInputBuffers,
-                     context.pBackgroundData,
-                     pOutputBuffers,
-                     numberOfSamples
-                     );
+                    {
+                        SW::ProcessingStatistics::Timer const timer( context.pStatistics, SW::ProcessingStatistics::Melodify, numberOfSamples );
+                        context.processor.process
+                        (
+                         pInputBuffers,
+                         context.pBackgroundData,
+                         pOutputBuffers,
+                         numberOfSamples
+                         );
+                    }
                     
                     context.numberOfSamples -= numberOfSamples;
                     if ( !context.numberOfSamples )
@@ -313,10 +464,20 @@ class LE_Melodify {
             }; // struct RealTimeInputOutputContext
             
             Utility::Tracer::message( " * full duplex real time rendering - please speak into the microphone - and listen yourself sing :)" );
-            RealTimeInputOutputContext context = { device, melodifyer, pBackground.get(), numberOfBackgroundSamples, numberOfChannels };
+            RealTimeInputOutputContext context = { device, melodifyer, &statistics, pBackground.get(), numberOfBackgroundSamples, numberOfChannels };
             if ( auto err = device.setCallback( &RealTimeInputOutputContext::callback, &context ) ) { Utility::Tracer::error( err ); return false; }
+            unsigned int const monitoringLatency( device.latency().first + latency );
+            Utility::Tracer::formattedMessage
+            (
+             "\t...monitoring latency: %u samples (%.1f ms, of which the Melodifyer contributes %u samples).",
+             monitoringLatency,
+             monitoringLatency * 1000.0f / sampleRate,
+             latency
+             );
             melodifyer.reset();
+            statistics.reset();
             context.blockingDevice.startAndWait();
+            printStatistics( statistics, sampleRate );
         }
         
         Utility::Tracer::message( "Done." );
@@ -0,0 +1,636 @@
+//
+//  FLACDecoderTests.mm
+//  LE_Demo_iOSTests
+//
+//  FLACDecoder decoding, seeking, corruption and truncation tests.
+//
+//  The fixtures are small FLAC streams of the signals below covering all the
+//  subframe types (constant, verbatim, fixed orders 0 - 4 and LPC), wasted
+//  bits, all the stereo decorrelation modes, 8 and 16 bit block size codes
+//  and fixed and variable block sizes (checked against libFLAC).
+//
+
+#import <XCTest/XCTest.h>
+
+#include "le/audioio/flacDecoder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    typedef std::vector<char> Bytes;
+
+    /// A frame of a fixture: its byte offset, first sample, block size and
+    /// header size (in bytes, including the CRC-8).
+    struct Frame { unsigned int offset, firstSample, blockSize, headerSize; };
+
+    /// 2 channels, 16 bit, 44.1 kHz, 1280 sample frames in fixed 128 sample
+    /// blocks.
+    int stereo16Signal( unsigned int const channel, unsigned int const frame )
+    {
+        if ( frame >= 600 && frame < 700 )
+            return 0;
+        int const t( frame % 100 );
+        if ( channel == 0 )
+            return ( t < 50 ? t : 100 - t ) * 300 - 7500;
+        return int( frame % 37 ) * 400 - 7200 + int( frame / 200 ) % 3;
+    }
+
+    /// 1 channel, 24 bit, 48 kHz, 1000 sample frames in variable blocks.
+    int mono24Signal( unsigned int /*channel*/, unsigned int const frame )
+    {
+        int const t( frame % 90 );
+        return ( t < 45 ? t : 90 - t ) * 150001 - 3375000 + int( frame % 7 ) * 3;
+    }
+
+    unsigned char const stereo16FLAC[ 3954 ] =
+    {
+        0x66, 0x4C, 0x61, 0x43, 0x00, 0x00, 0x00, 0x22, 0x00, 0x80, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x0A, 0xC4, 0x42, 0xF0, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x81, 0x00, 0x00, 0x25, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xFF, 0xF8, 0x6E, 0xA8, 0x00, 0x7F, 0x11, 0x3A, 0x56, 0x11, 0x85, 0x40, 0x25,
+        0xA8, 0x1D, 0x5C, 0x0B, 0xF2, 0x04, 0x9B, 0x07, 0x3D, 0x05, 0xDF, 0x04, 0x81, 0x0E, 0x46, 0x17,
+        0x14, 0x23, 0x38, 0xE1, 0x22, 0xD5, 0x88, 0x9A, 0x6E, 0xF2, 0xC8, 0x90, 0xCD, 0xB5, 0x55, 0xDD,
+        0x06, 0x75, 0xDD, 0x5D, 0x80, 0x15, 0x7B, 0x5E, 0x20, 0xD2, 0xBC, 0x36, 0xB1, 0x0D, 0x0B, 0x24,
+        0x6F, 0x01, 0x13, 0x85, 0xAC, 0xA1, 0xC2, 0x82, 0x34, 0x05, 0xC6, 0x0E, 0x48, 0x09, 0x04, 0xE0,
+        0xEB, 0x52, 0x89, 0x7B, 0xB6, 0xC7, 0xC3, 0x1A, 0x59, 0xA2, 0xBF, 0x42, 0xA3, 0x35, 0x21, 0x00,
+        0x8A, 0xC0, 0x6B, 0xE3, 0x78, 0x1C, 0x88, 0xEA, 0x87, 0x86, 0x3D, 0xC1, 0xFA, 0x84, 0x1C, 0x11,
+        0x38, 0x48, 0x01, 0x2C, 0x84, 0xE4, 0x14, 0x58, 0x54, 0x8A, 0x15, 0xE8, 0x5A, 0xC1, 0x77, 0x86,
+        0x10, 0x19, 0x08, 0x67, 0x41, 0xA9, 0x86, 0xD8, 0x1C, 0x28, 0x73, 0xC1, 0x5E, 0x45, 0x47, 0x14,
+        0x54, 0x4E, 0x31, 0x2C, 0x44, 0x7F, 0x11, 0x34, 0x41, 0xB3, 0xF4, 0x9E, 0xDC, 0xF0, 0xA7, 0x53,
+        0x39, 0x09, 0xBB, 0xCD, 0x7A, 0x68, 0xB3, 0x2C, 0x98, 0x9C, 0xBE, 0xA5, 0xC3, 0x2C, 0x89, 0x57,
+        0xE8, 0xA5, 0xA4, 0xFB, 0x26, 0x49, 0x25, 0xC8, 0xCA, 0xE0, 0xEB, 0x52, 0x89, 0x7B, 0xB6, 0xC7,
+        0xC3, 0x1A, 0x59, 0xA2, 0xBF, 0x42, 0xA3, 0x03, 0x21, 0x82, 0x72, 0x87, 0x87, 0x0C, 0x52, 0x13,
+        0x2C, 0x76, 0xD1, 0x83, 0xC4, 0xB1, 0x3A, 0x99, 0x7D, 0x49, 0x2E, 0xE7, 0x2B, 0xB6, 0x8F, 0xBC,
+        0x7E, 0xE0, 0xC6, 0x34, 0xF7, 0xFD, 0xAF, 0xF9, 0xCF, 0xF0, 0x7F, 0xDA, 0xBF, 0xA8, 0xFF, 0x38,
+        0xFE, 0x3F, 0xFC, 0x1A, 0xD6, 0xFF, 0xF2, 0x62, 0x00, 0x20, 0x07, 0xFF, 0xA0, 0x02, 0x00, 0x20,
+        0x04, 0xA0, 0x3E, 0xAC, 0xA3, 0x13, 0xBF, 0xAE, 0x9B, 0x4E, 0xBE, 0xAA, 0x69, 0x44, 0x08, 0x18,
+        0x96, 0x8A, 0xB8, 0xC0, 0x8D, 0x68, 0xEB, 0x84, 0x04, 0x25, 0x69, 0x25, 0x52, 0x81, 0x2A, 0xB2,
+        0xD5, 0x2F, 0xF3, 0x2B, 0x35, 0x53, 0x7F, 0x52, 0xD4, 0xAE, 0x9A, 0xFF, 0xB1, 0x4B, 0x29, 0x83,
+        0x35, 0x35, 0x28, 0x5C, 0xA5, 0x93, 0x38, 0x4B, 0x31, 0x28, 0xC4, 0x8C, 0x11, 0xD4, 0x45, 0xD1,
+        0x11, 0xC4, 0x32, 0x28, 0x21, 0xD0, 0x41, 0x01, 0xF9, 0x06, 0x8E, 0x19, 0x90, 0x53, 0xA1, 0x04,
+        0x0D, 0xCC, 0x90, 0xEF, 0x02, 0x94, 0x1B, 0x50, 0x90, 0x0C, 0x61, 0xF7, 0x2C, 0x4E, 0x71, 0x17,
+        0x2D, 0xAB, 0xBE, 0x20, 0xE1, 0x31, 0x05, 0x6C, 0x0C, 0x18, 0x0D, 0x6A, 0x89, 0xAA, 0x5F, 0xF0,
+        0xB7, 0xC2, 0x26, 0x9C, 0x88, 0xBE, 0xC4, 0xC2, 0x7A, 0x2F, 0xAD, 0x9D, 0xAA, 0x54, 0x18, 0x5E,
+        0x07, 0x18, 0x4F, 0xF7, 0x5C, 0x95, 0x2B, 0x74, 0x81, 0xCC, 0xBC, 0x4B, 0x23, 0x83, 0x0A, 0xAC,
+        0x3D, 0x50, 0x5F, 0xAA, 0x10, 0x9C, 0x55, 0x11, 0x9E, 0x47, 0xA3, 0x09, 0x96, 0x13, 0x24, 0x2F,
+        0x98, 0x61, 0xB5, 0x94, 0x8A, 0x53, 0x79, 0x53, 0x25, 0x61, 0x95, 0xDE, 0x58, 0xC9, 0x68, 0x69,
+        0x7A, 0x48, 0x03, 0x95, 0x2D, 0xA2, 0xAC, 0x27, 0x62, 0x58, 0x22, 0xA7, 0xF8, 0xF2, 0x90, 0x34,
+        0x02, 0xE8, 0x29, 0x42, 0x40, 0x7D, 0x8E, 0x51, 0xA0, 0x2E, 0xC0, 0x21, 0x03, 0xFF, 0xF8, 0x6D,
+        0x98, 0x01, 0x7F, 0xAC, 0x44, 0xB6, 0x16, 0x02, 0x8A, 0x01, 0x2C, 0x00, 0x89, 0x8A, 0x03, 0xE0,
+        0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x74, 0x23, 0x18, 0x0E, 0x74,
+        0x3F, 0x6A, 0x0C, 0x00, 0x00, 0x70, 0x81, 0x02, 0x04, 0x08, 0x10, 0x20, 0x03, 0xFC, 0x1F, 0xFF,
+        0x08, 0x03, 0x20, 0x00, 0x02, 0x74, 0x00, 0x00, 0x5C, 0xFC, 0x04, 0xE8, 0x20, 0x01, 0x00, 0x08,
+        0x00, 0x40, 0x00, 0x1F, 0xE7, 0x81, 0x00, 0x5A, 0x00, 0x2C, 0x60, 0x20, 0x20, 0x20, 0x20, 0x01,
+        0xFE, 0xC8, 0x00, 0x40, 0x02, 0x00, 0x10, 0x00, 0x80, 0x04, 0x00, 0x00, 0x4E, 0x80, 0x00, 0x0B,
+        0x9F, 0xA8, 0x00, 0x00, 0x00, 0x3D, 0x04, 0x00, 0x80, 0x10, 0x02, 0x00, 0x40, 0x08, 0x01, 0x00,
+        0x01, 0xFE, 0x0F, 0xF3, 0xC0, 0x40, 0x40, 0x00, 0x2B, 0xC0, 0x16, 0x10, 0x10, 0x10, 0x02, 0x5F,
+        0xCE, 0x02, 0x7A, 0x99, 0x06, 0x41, 0x90, 0x64, 0x19, 0x06, 0x41, 0x90, 0x81, 0x20, 0x12, 0x01,
+        0x20, 0x12, 0x01, 0x20, 0x12, 0x01, 0x20, 0x12, 0x0B, 0xB2, 0x0B, 0x20, 0xB2, 0x0B, 0x20, 0x00,
+        0x02, 0x1F, 0xEC, 0x82, 0xC8, 0x2C, 0x83, 0xD4, 0xC8, 0x32, 0x0C, 0x83, 0x20, 0xC8, 0x32, 0x0C,
+        0x83, 0x21, 0x02, 0x40, 0x24, 0x02, 0x40, 0x24, 0x02, 0x40, 0x24, 0x02, 0x40, 0x24, 0x1E, 0xA6,
+        0x41, 0x90, 0x64, 0x19, 0x06, 0x41, 0x90, 0x64, 0x19, 0x08, 0x12, 0x01, 0x20, 0x12, 0x01, 0x20,
+        0x12, 0x01, 0x20, 0x12, 0x01, 0x20, 0xBB, 0x20, 0x00, 0x02, 0x1F, 0xEC, 0x82, 0xC8, 0x2C, 0x82,
+        0xC8, 0x2C, 0x82, 0xC8, 0x20, 0x48, 0x04, 0x80, 0x48, 0x04, 0x80, 0x48, 0x04, 0x80, 0x48, 0x04,
+        0x82, 0x04, 0x88, 0x48, 0x04, 0x80, 0x48, 0x04, 0x80, 0x48, 0x04, 0x80, 0x48, 0x20, 0x48, 0x04,
+        0x80, 0x48, 0x04, 0x80, 0x48, 0x04, 0x80, 0x48, 0x04, 0x82, 0xEC, 0x82, 0xC8, 0x2C, 0x82, 0xC8,
+        0x2C, 0x82, 0xC8, 0x00, 0x00, 0x87, 0xFB, 0x20, 0x81, 0x20, 0x12, 0x01, 0x20, 0x12, 0x01, 0x20,
+        0x12, 0x01, 0x20, 0x12, 0x08, 0x12, 0x01, 0x20, 0x12, 0x01, 0x20, 0x12, 0x01, 0x20, 0x12, 0x01,
+        0x20, 0x81, 0x20, 0x12, 0x01, 0x20, 0x12, 0x01, 0x20, 0x12, 0x01, 0x20, 0x12, 0x08, 0x12, 0x01,
+        0x20, 0x12, 0x01, 0x20, 0x12, 0x01, 0x20, 0x12, 0x01, 0x20, 0xB6, 0xA3, 0xFF, 0xF8, 0x6E, 0x88,
+        0x02, 0x7F, 0x11, 0x3A, 0x1E, 0x15, 0x45, 0x91, 0x15, 0x18, 0x1F, 0x48, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x03, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3A, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xA0, 0x2F, 0xEA, 0x1F, 0xEA, 0x1F, 0xEF, 0x96, 0x2E, 0xDF, 0x16, 0x11,
+        0x8A, 0x59, 0xC4, 0xD5, 0x62, 0x3E, 0xF1, 0x09, 0x98, 0x79, 0xDC, 0x37, 0x76, 0x18, 0xFF, 0x0B,
+        0x21, 0x84, 0xE1, 0xC2, 0x19, 0x60, 0xE0, 0xF0, 0x5A, 0x98, 0x22, 0x5C, 0x0B, 0xB6, 0x03, 0x1F,
+        0x00, 0x31, 0xFF, 0x69, 0xFF, 0x5D, 0x7F, 0x82, 0xFF, 0xAB, 0x9F, 0xCA, 0xDF, 0xDF, 0xF7, 0xED,
+        0x3F, 0xF5, 0x41, 0xF9, 0xF1, 0xFC, 0xA1, 0x7E, 0x24, 0xFE, 0xFC, 0x9F, 0x73, 0x5F, 0xB4, 0x37,
+        0xD7, 0x5F, 0xEA, 0x51, 0xF4, 0x79, 0xF9, 0xE5, 0x7C, 0xC6, 0xF0, 0x1C, 0x18, 0x03, 0x1F, 0xFC,
+        0x17, 0xFB, 0x4F, 0xFC, 0x49, 0xFE, 0x0B, 0xFE, 0xF9, 0x7F, 0x76, 0x7F, 0xB8, 0x1F, 0xDA, 0x7F,
+        0xEC, 0x77, 0xF5, 0xD7, 0xFA, 0xB9, 0xFD, 0x43, 0xFE, 0x95, 0x7F, 0x44, 0x7F, 0x9F, 0x1F, 0xCD,
+        0xFF, 0xE6, 0x37, 0xF2, 0xB7, 0xF9, 0x29, 0xFC, 0x7B, 0xFE, 0x31, 0x7F, 0x12, 0x7F, 0x86, 0x1F,
+        0xC1, 0x7F, 0xDF, 0xF7, 0xEF, 0x97, 0xF7, 0x99, 0xFB, 0xB3, 0xFD, 0xCD, 0x7E, 0xE0, 0x7F, 0x6D,
+        0x1F, 0xB4, 0xFF, 0xD9, 0xB7, 0xEC, 0x77, 0xF6, 0x09, 0x89, 0x5F, 0xC4, 0xA3, 0x62, 0x4B, 0x71,
+        0x22, 0x98, 0x8F, 0xBC, 0x47, 0x16, 0x23, 0x27, 0x11, 0x61, 0x88, 0x97, 0xC4, 0x3F, 0x62, 0x19,
+        0x71, 0x09, 0x98, 0x83, 0x3C, 0x40, 0xD6, 0x20, 0x07, 0x0F, 0xD1, 0x87, 0xCF, 0xC3, 0xDB, 0x61,
+        0xC1, 0xF0, 0xCB, 0x18, 0x5A, 0x9C, 0x27, 0xD6, 0x11, 0x2F, 0x07, 0x39, 0x82, 0xED, 0xC1, 0x1F,
+        0x60, 0x63, 0xF0, 0x1C, 0x18, 0x03, 0x1F, 0xFC, 0x17, 0xFB, 0x4F, 0xFC, 0x49, 0xFD, 0x75, 0xFE,
+        0x63, 0x7F, 0x05, 0xFF, 0x6D, 0x1F, 0xAB, 0x9C, 0x43, 0xF6, 0x1F, 0x3F, 0x0E, 0x41, 0x86, 0x71,
+        0xC2, 0xE1, 0x61, 0x44, 0xF0, 0x8C, 0x98, 0x3B, 0x5C, 0x18, 0x36, 0x09, 0x5F, 0x03, 0x51, 0x80,
+        0xF9, 0xC0, 0x25, 0x7F, 0xE6, 0xF0, 0x42, 0xA4, 0xFF, 0xF8, 0x69, 0x90, 0x03, 0x7F, 0xA0, 0x02,
+        0xFD, 0xD9, 0xFE, 0x3D, 0xFE, 0xC7, 0x7F, 0x37, 0xFF, 0x86, 0x1F, 0xB8, 0x1F, 0xD6, 0x97, 0xE8,
+        0x8F, 0xF2, 0xE9, 0xF8, 0xC5, 0xFC, 0x0B, 0x7D, 0xD9, 0xFE, 0xD7, 0x1F, 0x60, 0x9F, 0xAA, 0xD7,
+        0xD2, 0xAF, 0xE7, 0xF9, 0x73, 0xE3, 0xB9, 0xE5, 0x5C, 0xEC, 0x6E, 0x73, 0x17, 0x37, 0xFB, 0x9B,
+        0x34, 0x07, 0x06, 0x03, 0x51, 0x01, 0x8F, 0x80, 0xBB, 0x40, 0x57, 0x60, 0x28, 0x90, 0x12, 0xB8,
+        0x08, 0x94, 0x03, 0xE6, 0x01, 0xC1, 0x00, 0xC7, 0x80, 0x57, 0x40, 0x25, 0x60, 0x0F, 0x90, 0x06,
+        0x38, 0x02, 0x54, 0x00, 0xC6, 0x00, 0x31, 0x7F, 0xFF, 0xBF, 0xF3, 0x5F, 0xF3, 0x6F, 0xF6, 0x97,
+        0xF9, 0xBB, 0xFC, 0x15, 0xFD, 0xA6, 0xFE, 0xA1, 0x7F, 0x37, 0xBF, 0x8F, 0x5F, 0xC1, 0x6F, 0xDD,
+        0x97, 0xED, 0x3B, 0xF5, 0xD5, 0xFA, 0x86, 0xFD, 0x11, 0x7E, 0x6F, 0xBF, 0x2B, 0x5F, 0x8F, 0x61,
+        0x93, 0x10, 0xC7, 0xF8, 0x63, 0x34, 0x31, 0x36, 0x18, 0x69, 0x0C, 0x1B, 0x86, 0x01, 0x42, 0xD4,
+        0xE1, 0x54, 0x90, 0x9F, 0x58, 0x4A, 0x34, 0x22, 0x5E, 0x0F, 0xD1, 0x07, 0x39, 0x83, 0x45, 0x41,
+        0x76, 0xE0, 0xA5, 0x90, 0x47, 0xD8, 0x1E, 0x74, 0x0C, 0x7E, 0x04, 0xE1, 0x01, 0xC1, 0x80, 0x89,
+        0x40, 0x18, 0xEF, 0xF6, 0x97, 0xF0, 0x5B, 0xF2, 0xB5, 0xF6, 0x9E, 0xF9, 0xF1, 0x7C, 0x49, 0xBD,
+        0xCD, 0x5E, 0xBA, 0xEF, 0x47, 0x97, 0x98, 0xDB, 0xC6, 0xF5, 0xE0, 0xBE, 0xEF, 0x01, 0x05, 0x45,
+        0x82, 0x4B, 0x40, 0xF9, 0xE0, 0x67, 0x10, 0x28, 0x98, 0x0E, 0xD4, 0x04, 0xAE, 0x00, 0xF9, 0x7F,
+        0xCD, 0xBF, 0x8F, 0x5F, 0x9B, 0xEF, 0xB8, 0x17, 0xD1, 0x1B, 0xE3, 0x15, 0xEE, 0xCE, 0xF6, 0x09,
+        0x7A, 0x55, 0xBC, 0xD3, 0x5E, 0x3D, 0xEF, 0x09, 0x17, 0x82, 0xFB, 0xC0, 0xB5, 0xDF, 0xF6, 0xEF,
+        0xC9, 0x77, 0xCB, 0xBB, 0xD9, 0x5D, 0xE6, 0x6E, 0xF0, 0x17, 0x76, 0x7B, 0xBA, 0x75, 0xDC, 0xD6,
+        0x02, 0xF9, 0xC1, 0xFB, 0x51, 0xFC, 0xE1, 0xFE, 0x71, 0x00, 0x01, 0x01, 0x91, 0x03, 0x21, 0x04,
+        0xB1, 0x06, 0x41, 0x07, 0xD1, 0x09, 0x61, 0x0A, 0xF1, 0x0C, 0x81, 0x0E, 0x11, 0x0F, 0xA1, 0x11,
+        0x31, 0x12, 0xC2, 0x14, 0x52, 0x15, 0xE2, 0x17, 0x72, 0x19, 0x02, 0x1A, 0x92, 0x1C, 0x22, 0xE3,
+        0xE2, 0xE5, 0x72, 0xE7, 0x02, 0xE8, 0x92, 0xEA, 0x22, 0xEB, 0xB2, 0xED, 0x42, 0xEE, 0xD2, 0xF0,
+        0x62, 0xF1, 0xF2, 0xF3, 0x82, 0xF5, 0x12, 0xF6, 0xA2, 0xF8, 0x32, 0xF9, 0xC2, 0xFB, 0x52, 0xFC,
+        0xE2, 0xFE, 0x72, 0x00, 0x02, 0x01, 0x92, 0x03, 0x22, 0x04, 0xB2, 0x06, 0x42, 0x07, 0xD2, 0x09,
+        0x62, 0x0A, 0xF2, 0x0C, 0x82, 0x0E, 0x12, 0x0F, 0xA2, 0x11, 0x32, 0x12, 0xC2, 0x14, 0x52, 0x15,
+        0xE2, 0x17, 0x72, 0x19, 0x02, 0x1A, 0x92, 0x1C, 0x22, 0xE3, 0xE2, 0xE5, 0x72, 0xE7, 0x02, 0xE8,
+        0x92, 0xEA, 0x22, 0xEB, 0xB2, 0xED, 0x42, 0xEE, 0xD2, 0xF0, 0x62, 0xF1, 0xF2, 0xF3, 0x82, 0xF5,
+        0x12, 0xF6, 0xA2, 0xF8, 0x32, 0xF9, 0xC2, 0xFB, 0x52, 0xFC, 0xE2, 0xFE, 0x72, 0x00, 0x02, 0x01,
+        0x92, 0x03, 0x22, 0x04, 0xB2, 0x06, 0x42, 0x07, 0xD2, 0x09, 0x62, 0x0A, 0xF2, 0x0C, 0x82, 0x0E,
+        0x12, 0x0F, 0xA2, 0x11, 0x32, 0x12, 0xC2, 0x14, 0x52, 0x15, 0xE2, 0x17, 0x72, 0x19, 0x02, 0x1A,
+        0x92, 0x1C, 0x22, 0xE3, 0xE2, 0xE5, 0x72, 0xE7, 0x02, 0xE8, 0x92, 0xEA, 0x22, 0xEB, 0xB2, 0xED,
+        0x42, 0xEE, 0xD2, 0xF0, 0x62, 0xF1, 0xF2, 0xF3, 0x82, 0xF5, 0x12, 0xF6, 0xA2, 0xF8, 0x32, 0xF9,
+        0xC2, 0xFB, 0x52, 0xFC, 0xE2, 0xFE, 0x72, 0x00, 0x02, 0x01, 0x92, 0x03, 0x22, 0x04, 0xB2, 0x06,
+        0x42, 0x07, 0xD2, 0x09, 0x62, 0x0A, 0xF2, 0x0C, 0x82, 0x0E, 0x12, 0x0F, 0xA2, 0x11, 0x32, 0x12,
+        0xC2, 0x00, 0x2E, 0xFF, 0xF8, 0x6D, 0x90, 0x04, 0x7F, 0xAC, 0x44, 0xE1, 0x19, 0xF7, 0x1C, 0xF7,
+        0x03, 0xF6, 0xEA, 0xF6, 0xD1, 0xA4, 0xB8, 0x00, 0x80, 0x00, 0x13, 0xA0, 0x00, 0x00, 0x0D, 0x6F,
+        0x00, 0x00, 0x06, 0xB8, 0x00, 0x9C, 0xF8, 0x00, 0x80, 0x08, 0x00, 0x80, 0x08, 0x00, 0x80, 0x08,
+        0x00, 0x80, 0x08, 0x00, 0x80, 0x08, 0x00, 0x80, 0x08, 0x00, 0x80, 0x08, 0x00, 0x80, 0x08, 0x00,
+        0x80, 0x08, 0x00, 0x80, 0x08, 0x00, 0x80, 0x05, 0x40, 0x08, 0x01, 0x00, 0x20, 0x04, 0x00, 0x80,
+        0x10, 0x03, 0x2B, 0xA5, 0x86, 0x57, 0x80, 0x00, 0x00, 0x5D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x5B, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x05, 0x70, 0x00, 0x02, 0xE7, 0xC0, 0x08, 0x01, 0x00, 0x20,
+        0x04, 0x00, 0x80, 0x10, 0x02, 0x00, 0x40, 0x08, 0x01, 0x00, 0x20, 0x04, 0x00, 0x80, 0x10, 0x02,
+        0x00, 0x40, 0x05, 0xC0, 0x04, 0x00, 0x40, 0x04, 0x00, 0x40, 0x04, 0x00, 0x40, 0x04, 0x00, 0x40,
+        0x04, 0x00, 0x40, 0x04, 0x00, 0x40, 0x04, 0x00, 0x40, 0x04, 0x00, 0x00, 0x9D, 0x00, 0x00, 0x00,
+        0x6B, 0x78, 0x00, 0x00, 0x35, 0xC0, 0x04, 0xE7, 0xC0, 0x04, 0x00, 0x40, 0x04, 0x00, 0x36, 0xB8,
+        0x39, 0x34, 0x2E, 0x49, 0x5E, 0x30, 0x01, 0x00, 0x10, 0x01, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
+        0x02, 0x14, 0x52, 0x15, 0xE2, 0x17, 0x72, 0x19, 0x02, 0x1A, 0x92, 0x1C, 0x22, 0xE3, 0xE2, 0xE5,
+        0x72, 0xE7, 0x02, 0xE8, 0x92, 0xEA, 0x22, 0xEB, 0xB2, 0xED, 0x42, 0xEE, 0xD2, 0xF0, 0x62, 0xF1,
+        0xF2, 0xF3, 0x82, 0xF5, 0x12, 0xF6, 0xA2, 0xF8, 0x32, 0xF9, 0xC2, 0xFB, 0x52, 0xFC, 0xE2, 0xFE,
+        0x72, 0x00, 0x02, 0x01, 0x92, 0x03, 0x22, 0x04, 0xB2, 0x06, 0x42, 0x07, 0xD2, 0x09, 0x62, 0x0A,
+        0xF2, 0x0C, 0x82, 0x0E, 0x12, 0x0F, 0xA2, 0x11, 0x32, 0x12, 0xC2, 0x14, 0x52, 0x15, 0xE2, 0x17,
+        0x72, 0x19, 0x02, 0x1A, 0x92, 0x1C, 0x22, 0xE3, 0xE2, 0xE5, 0x72, 0xE7, 0x02, 0xE8, 0x92, 0xEA,
+        0x22, 0xEB, 0xB2, 0xED, 0x42, 0xEE, 0xD2, 0xF0, 0x62, 0xF1, 0xF2, 0xF3, 0x82, 0xF5, 0x12, 0xF6,
+        0xA2, 0xF8, 0x32, 0xF9, 0xC2, 0xFB, 0x52, 0xFC, 0xE2, 0xFE, 0x72, 0x00, 0x02, 0x01, 0x92, 0x03,
+        0x22, 0x04, 0xB2, 0x06, 0x42, 0x07, 0xD2, 0x09, 0x62, 0x0A, 0xF2, 0x0C, 0x82, 0x0E, 0x12, 0x0F,
+        0xA2, 0x11, 0x32, 0x12, 0xC2, 0x14, 0x52, 0x15, 0xE2, 0x17, 0x72, 0x19, 0x02, 0x1A, 0x92, 0x1C,
+        0x22, 0xE3, 0xE2, 0xE5, 0x72, 0xE7, 0x02, 0xE8, 0x92, 0xEA, 0x22, 0xEB, 0xB2, 0xED, 0x42, 0xEE,
+        0xD2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0xA9, 0x17, 0xFF, 0xF8, 0x6E, 0x98, 0x05, 0x7F, 0x11, 0x3A, 0x4E, 0x19, 0x40, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0xF0, 0xFF, 0x0F, 0xF0, 0xFF, 0x0F, 0xF0, 0xFF, 0x0F, 0xFB,
+        0x80, 0x08, 0x00, 0x80, 0x08, 0x00, 0x16, 0x4A, 0x00, 0x4A, 0x00, 0x01, 0x21, 0xA0, 0x7E, 0xE5,
+        0x80, 0x1D, 0x6E, 0x00, 0x75, 0xC0, 0xCE, 0x78, 0x00, 0x80, 0x08, 0x00, 0x80, 0x08, 0x00, 0x0F,
+        0xF0, 0xFF, 0x0F, 0xFB, 0x80, 0x08, 0x00, 0x80, 0x08, 0x00, 0x19, 0xD0, 0x00, 0x75, 0xB8, 0x01,
+        0xD7, 0x03, 0x39, 0xD2, 0x10, 0x84, 0x21, 0x08, 0x00, 0x00, 0x1B, 0x50, 0x00, 0x03, 0x80, 0x05,
+        0x70, 0x41, 0x04, 0x10, 0x40, 0x1F, 0xE2, 0xA2, 0x00, 0x00, 0x00, 0x97, 0xC2, 0x00, 0x00, 0x00,
+        0x01, 0x60, 0x82, 0x08, 0x20, 0x82, 0x08, 0x20, 0x82, 0x08, 0x20, 0x82, 0x08, 0x20, 0x82, 0x08,
+        0x20, 0x82, 0x08, 0x20, 0x82, 0x08, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0xB6, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x84, 0x21, 0x08, 0x42, 0x10, 0x84, 0x21, 0x08, 0x42, 0x10,
+        0x84, 0x21, 0x08, 0x42, 0x10, 0x84, 0x21, 0x08, 0x42, 0x05, 0x82, 0x08, 0x20, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x72, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xEA, 0x08, 0x20, 0x82,
+        0x08, 0x20, 0x82, 0x08, 0x20, 0x82, 0x08, 0x20, 0x82, 0x08, 0x20, 0x82, 0x08, 0x20, 0x82, 0x08,
+        0x00, 0xE6, 0x98, 0xFF, 0xF8, 0x60, 0x18, 0x06, 0x7F, 0x1D, 0x19, 0x42, 0x0D, 0x07, 0x08, 0x17,
+        0x70, 0x4B, 0x14, 0x07, 0x83, 0xFC, 0x1F, 0xE0, 0xFF, 0x34, 0x00, 0xD8, 0x00, 0xAE, 0x1B, 0x20,
+        0x40, 0x81, 0x00, 0x1F, 0xE0, 0xFF, 0xF8, 0x01, 0xFF, 0xF0, 0x80, 0x1A, 0x04, 0x08, 0x01, 0xAC,
+        0x01, 0x60, 0x35, 0xC0, 0x81, 0xF0, 0x80, 0x7C, 0x20, 0x00, 0xFF, 0xF8, 0x40, 0x01, 0xFE, 0x24,
+        0x1F, 0x40, 0x8A, 0x59, 0x03, 0x20, 0x64, 0x0C, 0x81, 0x90, 0x32, 0x06, 0x40, 0xC8, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x27, 0xF6, 0x40, 0xC8, 0x19, 0x03, 0x20, 0x64, 0x0C, 0x81, 0x90,
+        0x32, 0x06, 0x40, 0xC8, 0x19, 0x03, 0x20, 0x64, 0x0C, 0x81, 0x90, 0x32, 0x06, 0x40, 0xC8, 0x19,
+        0x03, 0x20, 0x64, 0x0C, 0x81, 0x91, 0x32, 0x06, 0x40, 0xC8, 0x19, 0x03, 0x20, 0x64, 0x0C, 0x81,
+        0x90, 0x32, 0x06, 0x40, 0xC8, 0x19, 0x03, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9F,
+        0xD9, 0x03, 0x20, 0x64, 0x0C, 0x81, 0x90, 0x32, 0x06, 0x40, 0xC8, 0x19, 0x03, 0x20, 0x64, 0x0C,
+        0x81, 0x90, 0x32, 0x06, 0x40, 0xC8, 0x19, 0x02, 0x59, 0x03, 0x20, 0x64, 0x0C, 0x81, 0x90, 0x32,
+        0x06, 0x40, 0xC8, 0x19, 0x03, 0x20, 0x64, 0x0C, 0x81, 0x90, 0x32, 0x06, 0x40, 0xC8, 0x19, 0x03,
+        0x20, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x13, 0xFB, 0x20, 0x64, 0x0C, 0x81, 0x90,
+        0x32, 0x06, 0x40, 0xC8, 0x19, 0x03, 0x20, 0x64, 0x0C, 0x81, 0x90, 0x32, 0x06, 0x40, 0xC8, 0x19,
+        0x03, 0x20, 0x64, 0x0C, 0x81, 0x90, 0x32, 0x06, 0x40, 0xC8, 0x19, 0x03, 0x20, 0x64, 0x0C, 0x81,
+        0x90, 0x32, 0x06, 0x40, 0xC8, 0x19, 0x03, 0x20, 0x64, 0x0C, 0x81, 0x90, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x4F, 0xEC, 0x81, 0x90, 0x32, 0x06, 0x40, 0xC8, 0x19, 0x03, 0x20, 0xE6, 0x37,
+        0xFF, 0xF8, 0x6E, 0x88, 0x07, 0x7F, 0x11, 0x3A, 0x50, 0x7F, 0x79, 0xD9, 0xE6, 0x3B, 0x94, 0x3E,
+        0x3E, 0x38, 0xAD, 0xE3, 0xE3, 0x94, 0x3E, 0x63, 0xB9, 0xD9, 0xE8, 0x93, 0xA6, 0xFE, 0xAE, 0xBB,
+        0x05, 0xED, 0x43, 0xB9, 0xBE, 0xF9, 0xBC, 0x31, 0xF1, 0xF3, 0xCC, 0x7F, 0x44, 0xBD, 0x5D, 0xF6,
+        0xA3, 0xDF, 0x3F, 0x8F, 0xBE, 0x89, 0xFB, 0x53, 0xF1, 0xFF, 0xDA, 0xBF, 0xB5, 0x00, 0x00, 0x04,
+        0xB0, 0x25, 0xAD, 0x27, 0x3B, 0xC9, 0xBF, 0xFE, 0x00, 0x3F, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x20,
+        0x02, 0x00, 0x20, 0x06, 0x00, 0x60, 0x07, 0xFF, 0xDF, 0xFF, 0xFF, 0xBF, 0xFF, 0xFF, 0xE0, 0x01,
+        0xFF, 0xA0, 0x04, 0x00, 0x7F, 0xFA, 0x00, 0x20, 0x01, 0xFF, 0xE0, 0x03, 0xFF, 0xDF, 0xFE, 0x00,
+        0x60, 0x06, 0x00, 0x29, 0x00, 0xAF, 0x09, 0x0B, 0x0D, 0x0E, 0x0F, 0x04, 0x42, 0x61, 0x50, 0xB8,
+        0x64, 0x38, 0x1E, 0x04, 0x01, 0x20, 0x50, 0x17, 0x06, 0x41, 0xB0, 0x74, 0x1F, 0x02, 0x40, 0x50,
+        0x3F, 0x1B, 0x0B, 0x84, 0x87, 0x86, 0x85, 0x44, 0x4E, 0x08, 0x20, 0x68, 0xA1, 0x07, 0x9A, 0x59,
+        0x2E, 0x52, 0x39, 0x45, 0x77, 0x4A, 0x9B, 0x13, 0x19, 0x08, 0x86, 0x41, 0x10, 0x54, 0x19, 0x07,
+        0xC0, 0x98, 0x17, 0x03, 0x60, 0x7C, 0x05, 0x40, 0x64, 0x07, 0x4A, 0x10, 0x84, 0xA1, 0x58, 0x5E,
+        0x19, 0x86, 0xE1, 0xD8, 0x21, 0x04, 0xA1, 0x10, 0xCC, 0x56, 0x21, 0x39, 0x31, 0x27, 0x7E, 0xD5,
+        0x6A, 0x74, 0x3E, 0xF7, 0xBE, 0x77, 0xD3, 0x0C, 0x96, 0x69, 0xD0, 0xA7, 0xDC, 0x0F, 0xE8, 0x8E,
+        0x04, 0xC0, 0x10, 0x04, 0x00, 0x56, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40,
+        0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10,
+        0x04, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x07, 0x3F, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40,
+        0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10,
+        0x04, 0x00, 0x55, 0xF0, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C,
+        0xFC, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04,
+        0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01,
+        0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x0E, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xD0, 0x95, 0x94, 0x01,
+        0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00,
+        0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x00, 0x31, 0xA1, 0xFF, 0xF8, 0x6D,
+        0xA8, 0x08, 0x7F, 0xAC, 0x44, 0x46, 0x16, 0x04, 0xE3, 0x06, 0x41, 0x07, 0x9F, 0x0A, 0xA0, 0x04,
+        0x00, 0x80, 0x10, 0x02, 0x00, 0x40, 0x08, 0x01, 0x00, 0x20, 0x00, 0x00, 0x17, 0x3C, 0x00, 0x00,
+        0x00, 0x3D, 0x00, 0x00, 0x17, 0x3E, 0x00, 0x40, 0x08, 0x01, 0x00, 0x20, 0x04, 0x00, 0x80, 0x10,
+        0x02, 0x00, 0x40, 0x08, 0x01, 0x00, 0x32, 0xBE, 0x58, 0x80, 0x10, 0x02, 0x00, 0x4C, 0x01, 0x00,
+        0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40, 0x10, 0x04, 0x01, 0x00, 0x40,
+        0x10, 0x04, 0x00, 0x00, 0x00, 0x00, 0x1E, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xA0,
+        0x00, 0x00, 0x00, 0x0F, 0x3E, 0x00, 0x80, 0x20, 0x08, 0x02, 0x00, 0x80, 0x20, 0x08, 0x02, 0x00,
+        0x80, 0x20, 0x08, 0x03, 0xDE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x96, 0x7E,
+        0xD4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x18,
+        0x73, 0xA1, 0x8C, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x01, 0xEF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x06, 0x31, 0x87, 0x3A, 0x18, 0xC6, 0x00, 0x00, 0x7E, 0xD4, 0x7F, 0xFC,
+        0xF8, 0xFC, 0xDF, 0xFC, 0xC6, 0xFC, 0xAD, 0xFC, 0x94, 0xFC, 0x7B, 0xFC, 0x62, 0xFC, 0x49, 0xFC,
+        0x30, 0xFC, 0x17, 0xFB, 0xFE, 0xFB, 0xE5, 0x8A, 0x40, 0x8A, 0x27, 0x8A, 0x0E, 0x89, 0xF5, 0x89,
+        0xDC, 0x89, 0xC3, 0x89, 0xAA, 0x89, 0x91, 0x89, 0x78, 0x89, 0x5F, 0x89, 0x46, 0x89, 0x2D, 0x89,
+        0x14, 0x88, 0xFB, 0x88, 0xE2, 0x88, 0x33, 0x87, 0x84, 0x86, 0xD5, 0x86, 0x26, 0x85, 0x77, 0xDA,
+        0x4E, 0x6F, 0x93, 0x40, 0x04, 0x00, 0xC0, 0x04, 0x00, 0x7F, 0xF4, 0x00, 0x40, 0x0B, 0xFF, 0xBF,
+        0xF4, 0x00, 0x00, 0x0B, 0xFF, 0x80, 0x08, 0x00, 0x3F, 0xF8, 0x00, 0x00, 0x08, 0x00, 0x40, 0x0F,
+        0xFF, 0xC0, 0x04, 0x00, 0x80, 0x07, 0xFF, 0x7F, 0xF7, 0xFF, 0x80, 0x08, 0x00, 0xBF, 0xF8, 0x00,
+        0x41, 0x8B, 0x64, 0x0E, 0x03, 0x3B, 0xC6, 0xF1, 0x71, 0xB5, 0x59, 0xBE, 0x3F, 0xCB, 0xC9, 0x40,
+        0xD2, 0x34, 0xFD, 0x59, 0x5C, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x28, 0x80, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x10, 0xBF, 0xF7, 0x32, 0xBD, 0x26, 0x89, 0xCA, 0x21, 0xB6, 0x3A, 0x1C, 0x16,
+        0x3F, 0x73, 0xA9, 0xCD, 0x4F, 0x60, 0xD4, 0x35, 0xDE, 0x1F, 0xA3, 0xF6, 0xFD, 0xAF, 0xD6, 0x8F,
+        0xD3, 0xAA, 0x39, 0xFF, 0x67, 0xAE, 0xE7, 0xF1, 0xED, 0xFD, 0x7F, 0x67, 0xDF, 0xF8, 0x7E, 0x30,
+        0x00, 0x00, 0x01, 0xF4, 0x00, 0x00, 0x00, 0x4A, 0x76, 0x65, 0x61, 0x2C, 0x47, 0x90, 0xF4, 0xE5,
+        0x2B, 0x43, 0xD2, 0xB5, 0x55, 0x52, 0x4C, 0xD4, 0xD4, 0xB1, 0x27, 0x50, 0x54, 0x04, 0x8D, 0x13,
+        0x46, 0xB0, 0xDC, 0x77, 0x3C, 0xD3, 0x32, 0x3C, 0x19, 0x21, 0x40, 0x91, 0xCC, 0x07, 0x11, 0xC4,
+        0xF1, 0x5C, 0x5B, 0x18, 0x80, 0x00, 0x00, 0x07, 0x34, 0x00, 0x00, 0x02, 0xA1, 0x4F, 0x09, 0x62,
+        0x5B, 0xBE, 0x27, 0xFF, 0xF8, 0x60, 0x80, 0x09, 0x7F, 0x26, 0x15, 0x46, 0xBD, 0x19, 0xC8, 0x01,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xA8, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0A, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x54, 0x27, 0x17, 0xA1, 0x02, 0x0D, 0xD9, 0xBB, 0x37, 0x66, 0xEC, 0xDD,
+        0x9B, 0xB3, 0x76, 0x6E, 0xCD, 0xD9, 0xBB, 0x37, 0x66, 0xEC, 0xDD, 0x9B, 0xB3, 0x76, 0x6E, 0xCD,
+        0xD9, 0xBB, 0x37, 0x66, 0xEC, 0xDD, 0x9B, 0xB3, 0x76, 0x6E, 0xCD, 0xD9, 0xBB, 0x37, 0x66, 0xEC,
+        0xDD, 0x9B, 0xB3, 0x76, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x28, 0x6E, 0xCD, 0xD9, 0xBB,
+        0x37, 0x66, 0xEC, 0xDD, 0x9B, 0xB3, 0x76, 0x6E, 0xCD, 0xD9, 0xBB, 0x37, 0x66, 0xEC, 0xDD, 0x9B,
+        0xB3, 0x73, 0x63, 0xB1, 0xD8, 0xEC, 0x76, 0x3B, 0x1D, 0x8E, 0xC7, 0x63, 0xB1, 0xD8, 0xEC, 0x76,
+        0x3B, 0x1D, 0x8E, 0xC7, 0x63, 0xB1, 0xD8, 0xEC, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B,
+        0x65, 0x8E, 0xC7, 0x63, 0xB1, 0xD8, 0xEC, 0x76, 0x3B, 0x1D, 0x8E, 0xC7, 0x63, 0xB1, 0xD8, 0xEC,
+        0x76, 0x3B, 0x1D, 0x8E, 0xC7, 0x63, 0xB1, 0xD8, 0xEC, 0x76, 0x3B, 0x1D, 0x8E, 0xC7, 0x63, 0xB1,
+        0xD8, 0xCD, 0xD9, 0xBB, 0x37, 0x66, 0xEC, 0xDD, 0x9B, 0xB3, 0x76, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x02, 0x28, 0x6E, 0xCD, 0xD9, 0xBB, 0x37, 0x66, 0xEC, 0xDD, 0x9B, 0xB3, 0x76, 0x6E, 0xCD,
+        0xD9, 0xBB, 0x37, 0x66, 0xEC, 0xDD, 0x9B, 0xB3, 0x76, 0x6E, 0xCD, 0xD9, 0xBB, 0x37, 0x66, 0xEC,
+        0x7E, 0xAF
+    };
+
+    Frame const stereo16Frames[] =
+    {
+        {   83,    0, 128, 9 },
+        {  541,  128, 128, 9 },
+        {  876,  256, 128, 9 },
+        { 1272,  384, 128, 7 },
+        { 1811,  512, 128, 9 },
+        { 2259,  640, 128, 9 },
+        { 2483,  768, 128, 7 },
+        { 2752,  896, 128, 9 },
+        { 3181, 1024, 128, 9 },
+        { 3683, 1152, 128, 7 }
+    };
+
+    unsigned char const mono24FLAC[ 2066 ] =
+    {
+        0x66, 0x4C, 0x61, 0x43, 0x00, 0x00, 0x00, 0x22, 0x00, 0x39, 0x01, 0x2C, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x0B, 0xB8, 0x01, 0x70, 0x00, 0x00, 0x03, 0xE8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x81, 0x00, 0x00, 0x25, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xFF, 0xF9, 0x6A, 0x0C, 0x00, 0x63, 0xC0, 0x16, 0xCC, 0x80, 0x68, 0xCE, 0xCA,
+        0x5C, 0xD1, 0x14, 0x50, 0x45, 0xB0, 0x00, 0x40, 0x01, 0x00, 0x04, 0x00, 0x10, 0x14, 0xC0, 0xA9,
+        0x01, 0x4C, 0x00, 0x10, 0x00, 0x40, 0x01, 0x00, 0x04, 0x05, 0x30, 0x2A, 0x40, 0x53, 0x00, 0x04,
+        0x00, 0x10, 0x00, 0x40, 0x01, 0x01, 0x4C, 0x0A, 0x90, 0x14, 0xC0, 0x01, 0x00, 0x04, 0x00, 0x10,
+        0x00, 0x40, 0x53, 0x02, 0xA4, 0x05, 0x30, 0x00, 0x40, 0x01, 0x00, 0x04, 0x00, 0x10, 0x14, 0xC0,
+        0xA9, 0x01, 0x4C, 0x00, 0x10, 0x00, 0x40, 0x01, 0x00, 0x04, 0x05, 0x30, 0x2A, 0x40, 0x53, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x7C, 0x30, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x04, 0xF8, 0x90, 0x00, 0x40, 0x52, 0xD8, 0x15, 0x20, 0x29, 0x80, 0x02,
+        0x00, 0x08, 0x00, 0x20, 0x00, 0x80, 0xA6, 0x05, 0x48, 0x0A, 0x60, 0x00, 0x80, 0x02, 0x00, 0x08,
+        0x00, 0x20, 0x29, 0x81, 0x52, 0x02, 0x98, 0x00, 0x20, 0x00, 0x80, 0x02, 0x00, 0x08, 0x0A, 0x60,
+        0x54, 0x80, 0xA6, 0x00, 0x08, 0x00, 0x20, 0x00, 0x80, 0x02, 0x02, 0x98, 0x15, 0x20, 0x29, 0x80,
+        0x02, 0x00, 0x08, 0x00, 0x20, 0x00, 0x80, 0xA6, 0x05, 0x48, 0x0A, 0x60, 0x00, 0x80, 0x02, 0x00,
+        0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x13, 0xCD, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x27, 0x6F, 0x80, 0xA6, 0x00, 0x08, 0x00, 0x20, 0x00, 0x80,
+        0x02, 0x02, 0x98, 0x15, 0x00, 0x89, 0x56, 0xFF, 0xF9, 0x7C, 0x0C, 0x64, 0x01, 0x2B, 0x30, 0x32,
+        0x16, 0xE3, 0x63, 0xD8, 0xE5, 0xAD, 0xCC, 0xE7, 0xF7, 0xC0, 0x45, 0xB0, 0x00, 0x40, 0x01, 0x01,
+        0x4C, 0x0A, 0x90, 0x14, 0xC0, 0x01, 0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x53, 0x02, 0xA4, 0x05,
+        0x30, 0x00, 0x40, 0x01, 0x00, 0x04, 0x00, 0x10, 0x14, 0xC0, 0xA9, 0x01, 0x4C, 0x00, 0x10, 0x00,
+        0x40, 0x01, 0x00, 0x04, 0x05, 0x30, 0x2A, 0x40, 0x53, 0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x01,
+        0x01, 0x4C, 0x0A, 0x90, 0x14, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x27, 0xC3,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4F, 0x89, 0x00, 0x04, 0x00, 0x10, 0x14,
+        0xC0, 0xA9, 0x01, 0x4C, 0x00, 0x10, 0x00, 0x40, 0x01, 0x00, 0x04, 0x05, 0x30, 0x2A, 0x40, 0x53,
+        0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x01, 0x01, 0x4C, 0x0A, 0x90, 0x14, 0xC0, 0x01, 0x00, 0x04,
+        0x00, 0x10, 0x00, 0x40, 0x53, 0x02, 0xA4, 0x05, 0x30, 0x00, 0x40, 0x01, 0x00, 0x04, 0x00, 0x10,
+        0x14, 0xC0, 0xA9, 0x01, 0x4C, 0x00, 0x10, 0x00, 0x40, 0x01, 0x00, 0x04, 0x05, 0x30, 0x2A, 0x40,
+        0x53, 0x00, 0x04, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x27,
+        0xC4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xDB, 0x02, 0xA4, 0x05, 0x30,
+        0x00, 0x40, 0x01, 0x00, 0x04, 0x00, 0x10, 0x14, 0xC0, 0xA9, 0x01, 0x4C, 0x00, 0x10, 0x00, 0x40,
+        0x01, 0x00, 0x04, 0x05, 0x30, 0x2A, 0x40, 0x53, 0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x01, 0x01,
+        0x4C, 0x0A, 0x90, 0x14, 0xC0, 0x01, 0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x53, 0x02, 0xA4, 0x05,
+        0x30, 0x00, 0x40, 0x01, 0x00, 0x04, 0x00, 0x10, 0x14, 0xC0, 0xA9, 0x01, 0x4C, 0x00, 0x10, 0x00,
+        0x40, 0x01, 0x00, 0x04, 0x05, 0x30, 0x2A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x27, 0xED, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4F, 0x89, 0x00, 0x04, 0x00,
+        0x10, 0x00, 0x40, 0x53, 0x02, 0xA4, 0x05, 0x30, 0x00, 0x40, 0x01, 0x00, 0x04, 0x00, 0x10, 0x14,
+        0xC0, 0xA9, 0x01, 0x4C, 0x00, 0x10, 0x00, 0x40, 0x01, 0x00, 0x04, 0x05, 0x30, 0x2A, 0x40, 0x53,
+        0x00, 0x04, 0x00, 0x0D, 0x80, 0x02, 0x00, 0x08, 0x0A, 0x60, 0x54, 0x80, 0xA6, 0x00, 0x08, 0x00,
+        0x20, 0x00, 0x80, 0x02, 0x02, 0x98, 0x15, 0x20, 0x29, 0x80, 0x02, 0x00, 0x08, 0x00, 0x20, 0x00,
+        0x80, 0xA6, 0x05, 0x48, 0x0A, 0x60, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01, 0x3E, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x7C, 0x38, 0x0A,
+        0x60, 0x54, 0x80, 0xA6, 0x00, 0x08, 0x00, 0x20, 0x00, 0x80, 0x02, 0x02, 0x98, 0x15, 0x20, 0x29,
+        0x80, 0x02, 0x00, 0x08, 0x00, 0x20, 0x00, 0x80, 0xA6, 0x05, 0x48, 0x0A, 0x60, 0x00, 0x80, 0x02,
+        0x00, 0x08, 0x00, 0x20, 0x29, 0x81, 0x52, 0x02, 0x98, 0x00, 0x20, 0x00, 0x80, 0x02, 0x00, 0x08,
+        0x0A, 0x60, 0x54, 0x80, 0xA6, 0x00, 0x08, 0x00, 0x20, 0x00, 0x80, 0x02, 0x02, 0x98, 0x15, 0x20,
+        0x29, 0x80, 0x02, 0x00, 0x08, 0x00, 0x20, 0x00, 0x80, 0xA4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x01, 0x3B, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x79, 0xA8,
+        0x00, 0x20, 0x00, 0x80, 0x02, 0x00, 0x08, 0x0A, 0x60, 0x54, 0x80, 0xA6, 0x00, 0x08, 0x00, 0x20,
+        0x00, 0x80, 0x02, 0x02, 0x98, 0x15, 0x20, 0x29, 0x80, 0x02, 0x00, 0x08, 0x00, 0x20, 0x00, 0x80,
+        0xA6, 0x05, 0x48, 0x0A, 0x60, 0x00, 0x80, 0x02, 0x00, 0x08, 0x00, 0x20, 0x29, 0x81, 0x52, 0x02,
+        0x98, 0x00, 0x20, 0x00, 0x80, 0x02, 0x00, 0x08, 0x0A, 0x60, 0x54, 0x80, 0xA6, 0x00, 0x08, 0x00,
+        0x20, 0x00, 0x80, 0x02, 0x02, 0x98, 0x15, 0x20, 0x29, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x01, 0x3E, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x7C,
+        0x38, 0x00, 0x20, 0x29, 0x81, 0x52, 0x02, 0x98, 0x00, 0x20, 0x00, 0x80, 0x02, 0x00, 0x08, 0x0A,
+        0x60, 0x54, 0x80, 0xA6, 0x00, 0x08, 0x00, 0x20, 0x00, 0x80, 0x02, 0x02, 0x98, 0x15, 0x20, 0x29,
+        0x80, 0x02, 0x00, 0x08, 0x00, 0x20, 0x00, 0x80, 0xA6, 0x05, 0x48, 0x0A, 0x60, 0x00, 0x80, 0x02,
+        0x00, 0x08, 0x00, 0x20, 0x29, 0x81, 0x52, 0x02, 0x98, 0x00, 0x20, 0x00, 0x80, 0x02, 0x00, 0x08,
+        0x0A, 0x40, 0x08, 0x92, 0xFF, 0xF9, 0x6E, 0x00, 0xC6, 0x90, 0x38, 0x12, 0xC0, 0xBD, 0x14, 0x28,
+        0x0E, 0x13, 0x2A, 0x58, 0x07, 0x03, 0x60, 0x00, 0x80, 0x02, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x13, 0xF6, 0xC0, 0x55, 0x00, 0x04, 0x00, 0x10, 0x00, 0x40,
+        0x01, 0x00, 0x04, 0x05, 0x30, 0x15, 0x40, 0x01, 0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x01, 0x01,
+        0x4C, 0x05, 0x50, 0x00, 0x40, 0x01, 0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x53, 0x01, 0x54, 0x00,
+        0x10, 0x00, 0x40, 0x01, 0x00, 0x04, 0x00, 0x10, 0x14, 0xC0, 0x55, 0x00, 0x04, 0x00, 0x10, 0x00,
+        0x40, 0x01, 0x00, 0x04, 0x05, 0x30, 0x15, 0x40, 0x01, 0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x01,
+        0x01, 0x4C, 0x05, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x27, 0xC4,
+        0x80, 0x02, 0x00, 0x08, 0x00, 0x20, 0x29, 0x80, 0xA8, 0xDD, 0xAB, 0xFF, 0xF9, 0x6E, 0x0C, 0xC7,
+        0x89, 0xF9, 0x12, 0xC0, 0x13, 0x14, 0xDC, 0x86, 0x05, 0xDE, 0xCF, 0xF9, 0x45, 0x90, 0x00, 0x80,
+        0x04, 0x00, 0x20, 0x53, 0x02, 0xA8, 0x00, 0x40, 0x02, 0x00, 0x10, 0x00, 0x80, 0x04, 0x0A, 0x60,
+        0x55, 0x00, 0x08, 0x00, 0x40, 0x02, 0x00, 0x10, 0x00, 0x81, 0x4C, 0x0A, 0xA0, 0x01, 0x00, 0x08,
+        0x00, 0x40, 0x02, 0x00, 0x10, 0x29, 0x81, 0x54, 0x00, 0x20, 0x01, 0x00, 0x08, 0x00, 0x40, 0x02,
+        0x05, 0x30, 0x2A, 0x80, 0x04, 0x00, 0x20, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xF8, 0x70, 0x29, 0x81,
+        0x54, 0x00, 0x20, 0x01, 0x00, 0x08, 0x00, 0x40, 0x02, 0x05, 0x30, 0x2A, 0x80, 0x04, 0x00, 0x20,
+        0x01, 0x00, 0x08, 0x00, 0x40, 0xA6, 0x05, 0x50, 0x00, 0x80, 0x04, 0x00, 0x20, 0x01, 0x00, 0x08,
+        0x14, 0xC0, 0xAA, 0x00, 0x10, 0x00, 0x80, 0x04, 0x00, 0x20, 0x01, 0x02, 0x98, 0x15, 0x40, 0x02,
+        0x00, 0x10, 0x00, 0x80, 0x04, 0x00, 0x20, 0x53, 0x02, 0xA8, 0x00, 0x40, 0x02, 0x00, 0x10, 0x00,
+        0x80, 0x04, 0x0A, 0x60, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5F, 0x12, 0x00, 0x10, 0x00, 0x80, 0x04, 0x00, 0x20,
+        0x53, 0x02, 0xA8, 0x00, 0x40, 0x02, 0x00, 0x10, 0x00, 0x80, 0x04, 0x0A, 0x60, 0x55, 0x00, 0x08,
+        0x00, 0x40, 0x02, 0x00, 0x10, 0x00, 0x81, 0x4C, 0x0A, 0xA0, 0x01, 0x00, 0x08, 0x00, 0x40, 0x02,
+        0x00, 0x10, 0x29, 0x81, 0x54, 0x00, 0x20, 0x01, 0x00, 0x08, 0x00, 0x40, 0x02, 0x05, 0x30, 0x2A,
+        0x80, 0x04, 0x00, 0x20, 0x01, 0x00, 0x08, 0x00, 0x40, 0xA5, 0x90, 0x2A, 0x80, 0x04, 0x00, 0x20,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x5F, 0x0E, 0x00, 0x10, 0x29, 0x81, 0x54, 0x00, 0x20, 0x01, 0x00, 0x08, 0x00,
+        0x40, 0x02, 0x05, 0x30, 0x2A, 0x80, 0x04, 0x00, 0x20, 0x01, 0x00, 0x08, 0x00, 0x40, 0xA6, 0x05,
+        0x50, 0x00, 0x80, 0x04, 0x00, 0x20, 0x01, 0x00, 0x08, 0x14, 0xC0, 0xAA, 0x00, 0x10, 0x00, 0x80,
+        0x04, 0x00, 0x20, 0x01, 0x02, 0x98, 0x15, 0x40, 0x02, 0x00, 0x10, 0x00, 0x80, 0x04, 0x00, 0x20,
+        0x53, 0x02, 0xA8, 0x00, 0x40, 0x02, 0x00, 0x10, 0x00, 0x80, 0x04, 0x0A, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B, 0xF7,
+        0x40, 0x02, 0x00, 0x10, 0x00, 0x80, 0x04, 0x00, 0x20, 0x53, 0x02, 0xA8, 0x00, 0x40, 0x02, 0x00,
+        0x10, 0x00, 0x80, 0x04, 0x0A, 0x60, 0x55, 0x00, 0x08, 0x00, 0x40, 0x02, 0x00, 0x10, 0x00, 0x81,
+        0x4C, 0x0A, 0xA0, 0x01, 0x00, 0x08, 0x00, 0x40, 0x02, 0x00, 0x10, 0x29, 0x81, 0x54, 0x00, 0x20,
+        0x01, 0x00, 0x08, 0x00, 0x40, 0x02, 0x05, 0x30, 0x2A, 0x80, 0x04, 0x00, 0x20, 0x01, 0x00, 0x08,
+        0x00, 0x40, 0xA6, 0x05, 0x50, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x7C, 0x38, 0x00, 0x40, 0x02, 0x05,
+        0x30, 0x2A, 0x80, 0x04, 0x00, 0x20, 0x01, 0x00, 0x08, 0x00, 0x40, 0xA6, 0x05, 0x50, 0x00, 0x80,
+        0x04, 0x00, 0x20, 0x01, 0x00, 0x08, 0x14, 0xC0, 0xAA, 0x00, 0x10, 0x00, 0x80, 0x04, 0x00, 0x20,
+        0x01, 0x02, 0x98, 0x15, 0x40, 0x02, 0x00, 0x10, 0x00, 0x80, 0x04, 0x00, 0x00, 0xAD, 0x17, 0xFF,
+        0xF9, 0x6D, 0x0C, 0xCB, 0x83, 0xBF, 0xBB, 0x80, 0xE6, 0x14, 0xEA, 0x41, 0xA5, 0xE7, 0xF7, 0xB7,
+        0x50, 0x52, 0x49, 0x00, 0x0A, 0x00, 0x69, 0x23, 0xA0, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x0C, 0xF3, 0x50, 0x0A, 0xA0, 0x00, 0x40, 0x00, 0x80, 0x01, 0x00, 0x02, 0x00, 0x04, 0x02, 0x98,
+        0x05, 0x50, 0x00, 0x05, 0x24, 0x80, 0x05, 0x00, 0x34, 0x92, 0x40, 0x02, 0x88, 0x00, 0xD2, 0x49,
+        0x00, 0x0A, 0x00, 0x69, 0x24, 0x74, 0x00, 0x08, 0x05, 0x30, 0x0A, 0xA0, 0x00, 0x40, 0x00, 0x80,
+        0x01, 0x00, 0x02, 0x00, 0x04, 0x02, 0x98, 0x05, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x3E,
+        0x1F, 0xCC, 0x00, 0x00, 0x56, 0xA8, 0x00, 0x00, 0x00, 0x15, 0xAA, 0x29, 0x24, 0x80, 0x05, 0x00,
+        0x34, 0x92, 0x41, 0x82, 0x41, 0x51, 0x11, 0x10, 0x09, 0x05, 0x44, 0x47, 0xE8, 0x00, 0x00, 0x00,
+        0x00, 0x01, 0xFF, 0xFD, 0x60, 0x00, 0x2A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x92, 0x7C, 0x5F, 0xFF, 0xD6, 0x00, 0x02, 0xA0, 0x00, 0x00, 0x29, 0x24, 0x00, 0x28, 0x01,
+        0xA4, 0x92, 0x00, 0x14, 0x40, 0x06, 0x92, 0x48, 0x00, 0x50, 0x03, 0x49, 0x20, 0xE0, 0x12, 0x0A,
+        0x88, 0x88, 0x80, 0x48, 0x2A, 0x21, 0xD0, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80, 0x53, 0x00, 0xA8,
+        0x00, 0x00, 0x00, 0x00, 0x33, 0xE1, 0xC0, 0x00, 0x80, 0x01, 0x00, 0x02, 0x00, 0x04, 0x02, 0x98,
+        0x05, 0x42, 0x92, 0x48, 0x00, 0x50, 0x03, 0x49, 0x24, 0x18, 0x24, 0x15, 0x11, 0x11, 0x00, 0x90,
+        0x54, 0x44, 0x0E, 0x20, 0x12, 0x0A, 0x88, 0x88, 0x80, 0x48, 0x2A, 0x00, 0xB6, 0x7A, 0xFF, 0xF9,
+        0x6D, 0x0C, 0xCE, 0x83, 0x63, 0xBB, 0x80, 0xDE, 0x14, 0xCE, 0xCA, 0x62, 0xCC, 0x80, 0x74, 0x49,
+        0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0xF1, 0x20, 0x00, 0x80, 0xA6, 0x02,
+        0xA8, 0x00, 0x20, 0x00, 0x80, 0x02, 0x00, 0x08, 0x00, 0x20, 0x29, 0x80, 0xAA, 0x00, 0x08, 0x00,
+        0x20, 0x00, 0x80, 0x02, 0x00, 0x08, 0x0A, 0x60, 0x2A, 0x80, 0x02, 0x00, 0x08, 0x00, 0x20, 0x00,
+        0x80, 0x01, 0xB0, 0x14, 0xC0, 0x55, 0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x01, 0x00, 0x04, 0x05,
+        0x30, 0x15, 0x40, 0x01, 0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x01, 0x01, 0x4C, 0x05, 0x50, 0x00,
+        0x40, 0x01, 0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x52, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x9E, 0x66, 0x00, 0x08, 0x00, 0x05, 0x24, 0x00, 0x28, 0x01, 0xA4, 0x92, 0x00, 0x14,
+        0x00, 0xD2, 0x49, 0x00, 0x0A, 0x00, 0x69, 0x24, 0x80, 0x05, 0x6C, 0x05, 0x50, 0x00, 0x40, 0x01,
+        0x00, 0x04, 0x00, 0x10, 0x00, 0x40, 0x53, 0x01, 0x54, 0x00, 0x10, 0x00, 0x40, 0x01, 0x00, 0x04,
+        0x00, 0x10, 0x14, 0xC0, 0x55, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x09, 0xF1, 0x20, 0x00, 0x80, 0x02, 0x02, 0x98, 0x0A, 0xA0, 0x00, 0x80, 0x02, 0x00, 0x00,
+        0xC5, 0x8F, 0xFF, 0xF9, 0x6D, 0x0C, 0xCF, 0xA7, 0x00, 0xBB, 0x80, 0x52, 0x00, 0xE1, 0x19, 0xF0,
+        0x49, 0x0C
+    };
+
+    Frame const mono24Frames[] =
+    {
+        {   83,   0, 100,  7 },
+        {  311, 100, 300,  9 },
+        {  964, 400,  57, 10 },
+        { 1099, 457, 250, 10 },
+        { 1615, 707, 192, 10 },
+        { 1854, 899, 100, 10 },
+        { 2050, 999,   1, 10 }
+    };
+
+    struct Fixture
+    {
+        unsigned char const * pBegin;
+        std::size_t           size;
+        Frame const         * pFrames;
+        unsigned int          numberOfFrames;
+        unsigned int          channels;
+        unsigned int          bits;
+        unsigned int          sampleRate;
+        unsigned int          length;
+        int                (* signal)( unsigned int channel, unsigned int frame );
+
+        Bytes bytes() const { return Bytes( pBegin, pBegin + size ); }
+        float sample( unsigned int const channel, unsigned int const frame ) const { return float( signal( channel, frame ) ) / float( 1 << ( bits - 1 ) ); }
+    };
+
+    Fixture const stereo16{ stereo16FLAC, sizeof( stereo16FLAC ), stereo16Frames, sizeof( stereo16Frames ) / sizeof( Frame ), 2, 16, 44100, 1280, &stereo16Signal };
+    Fixture const mono24  { mono24FLAC  , sizeof( mono24FLAC   ), mono24Frames  , sizeof( mono24Frames   ) / sizeof( Frame ), 1, 24, 48000, 1000, &mono24Signal   };
+
+    char const * open( LE::AudioIO::FLACDecoder & decoder, Bytes const & stream ) { return decoder.open( stream.data(), stream.data() + stream.size() ); }
+
+    /// Decodes everything (in uneven chunks) from the current position.
+    std::vector<float> decodeAll( LE::AudioIO::FLACDecoder & decoder )
+    {
+        std::vector<float> samples;
+        float chunk[ 8 * 333 ];
+        for ( unsigned int frames( 1 ); ; frames = frames * 7 % 331 + 1 )
+        {
+            unsigned int const framesRead( decoder.read( chunk, frames ) );
+            if ( !framesRead )
+                break;
+            samples.insert( samples.end(), chunk, chunk + framesRead * decoder.numberOfChannels() );
+        }
+        return samples;
+    }
+
+    /// \return Whether the sample frames [begin, end) of the decoded samples
+    /// hold the fixture's signal (or silence).
+    bool matches( std::vector<float> const & samples, Fixture const & fixture, unsigned int const begin, unsigned int const end, bool const silence = false )
+    {
+        for ( unsigned int frame( begin ); frame < end; ++frame )
+            for ( unsigned int channel( 0 ); channel < fixture.channels; ++channel )
+                if ( samples[ frame * fixture.channels + channel ] != ( silence ? 0 : fixture.sample( channel, frame ) ) )
+                    return false;
+        return true;
+    }
+}
+
+@interface FLACDecoderTests : XCTestCase
+@end
+
+@implementation FLACDecoderTests
+
+- (void)testDecodesExactly
+{
+    for ( Fixture const & fixture : { stereo16, mono24 } )
+    {
+        Bytes const stream( fixture.bytes() );
+        LE::AudioIO::FLACDecoder decoder;
+        XCTAssertTrue( open( decoder, stream ) == nullptr );
+        XCTAssertTrue( decoder.numberOfChannels() == fixture.channels   );
+        XCTAssertTrue( decoder.bitsPerSample   () == fixture.bits       );
+        XCTAssertTrue( decoder.sampleRate      () == fixture.sampleRate );
+        XCTAssertTrue( decoder.lengthInSamples () == fixture.length     );
+
+        std::vector<float> const samples( decodeAll( decoder ) );
+        XCTAssertTrue( samples.size() == fixture.length * fixture.channels );
+        XCTAssertTrue( matches( samples, fixture, 0, fixture.length ) );
+        XCTAssertTrue( decoder.position() == fixture.length );
+    }
+}
+
+- (void)testSeeksAreSampleExact
+{
+    for ( Fixture const & fixture : { stereo16, mono24 } )
+    {
+        Bytes const stream( fixture.bytes() );
+        LE::AudioIO::FLACDecoder decoder;
+        XCTAssertTrue( open( decoder, stream ) == nullptr );
+        std::vector<float> samples( 200 * fixture.channels );
+        // Backwards and forwards, across and onto frame boundaries.
+        for ( unsigned int step( 0 ); step < 2 * fixture.length; step += 13 )
+        {
+            unsigned int const target( step < fixture.length ? fixture.length - 1 - step : step - fixture.length );
+            decoder.setSamplePosition( target );
+            XCTAssertTrue( decoder.position() == target );
+            unsigned int const framesRead( decoder.read( &samples[ 0 ], 200 ) );
+            XCTAssertTrue( framesRead == std::min( 200U, fixture.length - target ) );
+            bool exact( true );
+            for ( unsigned int frame( 0 ); frame < framesRead; ++frame )
+                for ( unsigned int channel( 0 ); channel < fixture.channels; ++channel )
+                    exact &= samples[ frame * fixture.channels + channel ] == fixture.sample( channel, target + frame );
+            XCTAssertTrue( exact );
+        }
+        for ( unsigned int frame( 0 ); frame < fixture.numberOfFrames; ++frame )
+        {
+            decoder.setSamplePosition( fixture.pFrames[ frame ].firstSample );
+            XCTAssertTrue( decoder.read( &samples[ 0 ], 1 ) == 1 );
+            XCTAssertTrue( samples[ 0 ] == fixture.sample( 0, fixture.pFrames[ frame ].firstSample ) );
+        }
+        decoder.setSamplePosition( fixture.length + 5 );
+        XCTAssertTrue( decoder.read( &samples[ 0 ], 200 ) == 0 );
+    }
+}
+
+- (void)testConcealsMultiFrameLossesInPlace
+{
+    // Frames 2 - 4 (sample frames 256 - 639) and, in the variable block size
+    // stream, frames 1 - 2 (sample frames 100 - 456) lose their sync codes.
+    struct Loss { Fixture const * pFixture; unsigned int firstFrame, lastFrame; };
+    for ( Loss const & loss : { Loss{ &stereo16, 2, 4 }, Loss{ &mono24, 1, 2 } } )
+    {
+        Fixture const & fixture( *loss.pFixture );
+        Bytes stream( fixture.bytes() );
+        for ( unsigned int frame( loss.firstFrame ); frame <= loss.lastFrame; ++frame )
+            stream[ fixture.pFrames[ frame ].offset ] = 0;
+        unsigned int const lostBegin( fixture.pFrames[ loss.firstFrame ].firstSample );
+        unsigned int const lostEnd  ( fixture.pFrames[ loss.lastFrame + 1 ].firstSample );
+
+        LE::AudioIO::FLACDecoder decoder;
+        XCTAssertTrue( open( decoder, stream ) == nullptr );
+        std::vector<float> const samples( decodeAll( decoder ) );
+        XCTAssertTrue( samples.size() == fixture.length * fixture.channels );
+        XCTAssertTrue( matches( samples, fixture, 0        , lostBegin      ) );
+        XCTAssertTrue( matches( samples, fixture, lostBegin, lostEnd  , true ) );
+        XCTAssertTrue( matches( samples, fixture, lostEnd  , fixture.length ) );
+
+        // Seeking into and past the gap.
+        float frame[ 2 ];
+        decoder.setSamplePosition( lostEnd - 1 );
+        XCTAssertTrue( decoder.read( frame, 1 ) == 1 && frame[ 0 ] == 0 );
+        decoder.setSamplePosition( lostEnd + 3 );
+        XCTAssertTrue( decoder.read( frame, 1 ) == 1 && frame[ 0 ] == fixture.sample( 0, lostEnd + 3 ) );
+    }
+}
+
+- (void)testConcealsCorruptFrames
+{
+    // Frame 6 (sample frames 768 - 895) gets an invalid subframe header.
+    Frame const & corrupt( stereo16Frames[ 6 ] );
+    Bytes stream( stereo16.bytes() );
+    std::memset( &stream[ corrupt.offset + corrupt.headerSize ], 0xFF, stereo16Frames[ 7 ].offset - corrupt.offset - corrupt.headerSize );
+
+    LE::AudioIO::FLACDecoder decoder;
+    XCTAssertTrue( open( decoder, stream ) == nullptr );
+    std::vector<float> const samples( decodeAll( decoder ) );
+    XCTAssertTrue( samples.size() == stereo16.length * stereo16.channels );
+    XCTAssertTrue( matches( samples, stereo16, 0                                      , corrupt.firstSample                           ) );
+    XCTAssertTrue( matches( samples, stereo16, corrupt.firstSample                    , corrupt.firstSample + corrupt.blockSize, true ) );
+    XCTAssertTrue( matches( samples, stereo16, corrupt.firstSample + corrupt.blockSize, stereo16.length                               ) );
+}
+
+- (void)testTruncatedStreamsKeepTheirLength
+{
+    for ( Fixture const & fixture : { stereo16, mono24 } )
+    {
+        for ( unsigned int frame( 1 ); frame < fixture.numberOfFrames; ++frame )
+        {
+            // Cut at, inside the header of (including just after the 8 or 16
+            // bit block size) and inside the subframes of the frame.
+            for ( unsigned int const cut : { 0U, 1U, 5U, 6U, 7U, fixture.pFrames[ frame ].headerSize + 2 } )
+            {
+                Bytes const stream( fixture.pBegin, fixture.pBegin + fixture.pFrames[ frame ].offset + cut );
+                unsigned int const lostBegin( fixture.pFrames[ frame ].firstSample );
+
+                LE::AudioIO::FLACDecoder decoder;
+                XCTAssertTrue( open( decoder, stream ) == nullptr );
+                XCTAssertTrue( decoder.lengthInSamples() == fixture.length );
+                std::vector<float> const samples( decodeAll( decoder ) );
+                XCTAssertTrue( samples.size() == fixture.length * fixture.channels );
+                XCTAssertTrue( matches( samples, fixture, 0        , lostBegin            ) );
+                XCTAssertTrue( matches( samples, fixture, lostBegin, fixture.length, true ) );
+            }
+        }
+    }
+}
+
+@end
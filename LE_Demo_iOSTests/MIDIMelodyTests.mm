@@ -0,0 +1,163 @@
+//
+//  MIDIMelodyTests.mm
+//  LE_Demo_iOSTests
+//
+//  Standard MIDI File parsing, serialization and trimming tests (the parser
+//  does not call into the SDK so the melodies are checked through
+//  serialize()).
+//
+
+#import <XCTest/XCTest.h>
+
+#include "le/melodify/midiMelody.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    typedef std::vector<unsigned char> Bytes;
+
+    Bytes chunk( char const * const pID, Bytes const & payload )
+    {
+        Bytes result( pID, pID + 4 );
+        for ( unsigned int byte( 4 ); byte--; )
+            result.push_back( static_cast<unsigned char>( payload.size() >> ( byte * 8 ) ) );
+        result.insert( result.end(), payload.begin(), payload.end() );
+        return result;
+    }
+
+    /// A format 1, 480 PPQN file with the given track payloads.
+    Bytes smf( std::vector<Bytes> const & tracks )
+    {
+        Bytes file( chunk( "MThd", Bytes{ 0, 1, 0, static_cast<unsigned char>( tracks.size() ), 0x01, 0xE0 } ) );
+        for ( Bytes const & track : tracks )
+        {
+            Bytes const trackChunk( chunk( "MTrk", track ) );
+            file.insert( file.end(), trackChunk.begin(), trackChunk.end() );
+        }
+        return file;
+    }
+
+    Bytes const tempoTrack{ 0x00, 0xFF, 0x51, 0x03, 0x07, 0xA1, 0x20, /*120 BPM*/ 0x00, 0xFF, 0x2F, 0x00 };
+
+    char const * parse( LE::SW::MIDIMelody & melody, Bytes const & file, unsigned int const track = 1, unsigned int const channel = 0 )
+    {
+        return melody.parse( &file[ 0 ], &file[ 0 ] + file.size(), track, channel );
+    }
+
+    /// The payload of the melody track of a serialize()d melody.
+    Bytes melodyTrack( LE::SW::MIDIMelody const & melody )
+    {
+        Bytes const file( melody.serialize() );
+        std::size_t const tempoTrackSize( LE::SW::Detail::readBigEndian( &file[ 14 + 4 ], 4 ) );
+        std::size_t const melodyTrackStart( 14 + 8 + tempoTrackSize + 8 );
+        return Bytes( file.begin() + melodyTrackStart, file.end() );
+    }
+}
+
+@interface MIDIMelodyTests : XCTestCase
+@end
+
+@implementation MIDIMelodyTests
+
+- (void)testExtractsTheRequestedTrackAndChannel
+{
+    Bytes const track
+    {
+        0x00, 0x90, 0x3C, 0x64,       // note on
+        0x83, 0x60, 0x3C, 0x00,       // (running status) note off, 480 ticks later
+        0x00, 0x91, 0x40, 0x64,       // other channel
+        0x00, 0xC0, 0x05,             // program change (one data byte)
+        0x00, 0xFF, 0x2F, 0x00
+    };
+    LE::SW::MIDIMelody melody;
+    XCTAssertTrue( parse( melody, smf( { tempoTrack, track } ) ) == nullptr );
+    XCTAssertEqualWithAccuracy( melody.lengthInSeconds(), 0.5, 1e-9 );
+
+    Bytes const expected
+    {
+        0x00, 0x90, 0x3C, 0x64,
+        0x83, 0x60, 0x90, 0x3C, 0x00,
+        0x00, 0xC0, 0x05,
+        0x00, 0xFF, 0x2F, 0x00
+    };
+    XCTAssertTrue( melodyTrack( melody ) == expected );
+
+    // The other channel and a missing track.
+    XCTAssertTrue( parse( melody, smf( { tempoTrack, track } ), 1, 1 ) == nullptr );
+    XCTAssertTrue( melodyTrack( melody ) == Bytes( { 0x83, 0x60, 0x91, 0x40, 0x64, 0x00, 0xFF, 0x2F, 0x00 } ) );
+    XCTAssertTrue( parse( melody, smf( { tempoTrack, track } ), 2, 0 ) != nullptr );
+}
+
+- (void)testSerializedMelodiesParseBack
+{
+    Bytes const track{ 0x00, 0x90, 0x3C, 0x64, 0x81, 0x70, 0x80, 0x3C, 0x40, 0x00, 0xE0, 0x00, 0x50, 0x00, 0xFF, 0x2F, 0x00 };
+    LE::SW::MIDIMelody melody;
+    XCTAssertTrue( parse( melody, smf( { tempoTrack, track } ) ) == nullptr );
+    Bytes const serialized( melody.serialize() );
+    LE::SW::MIDIMelody copy;
+    XCTAssertTrue( parse( copy, serialized, LE::SW::MIDIMelody::track ) == nullptr );
+    XCTAssertTrue( copy.serialize() == serialized );
+}
+
+- (void)testAppendedMelodiesParseBack
+{
+    LE::SW::MIDIMelody melody;
+    XCTAssertTrue( melody.reset( 480, 500000, 16 ) != nullptr );
+    XCTAssertTrue( melody.reset( 480, 500000,  2 ) == nullptr );
+    melody.append(   0, 0x90, 0x3C, 0x64 );
+    melody.append( 480, 0x80, 0x3C       );
+    XCTAssertEqualWithAccuracy( melody.lengthInSeconds(), 0.5, 1e-9 );
+    XCTAssertTrue( melodyTrack( melody ) == Bytes( { 0x00, 0x92, 0x3C, 0x64, 0x83, 0x60, 0x82, 0x3C, 0x00, 0x00, 0xFF, 0x2F, 0x00 } ) );
+
+    Bytes const serialized( melody.serialize() );
+    LE::SW::MIDIMelody copy;
+    XCTAssertTrue( parse( copy, serialized, LE::SW::MIDIMelody::track, 2 ) == nullptr );
+    XCTAssertTrue( copy.serialize() == serialized );
+}
+
+- (void)testRunningStatusDoesNotSurviveMetaAndSysExEvents
+{
+    Bytes const afterMeta { 0x00, 0x90, 0x3C, 0x64, 0x00, 0xFF, 0x01, 0x00,       0x00, 0x3C, 0x00, 0x00, 0xFF, 0x2F, 0x00 };
+    Bytes const afterSysEx{ 0x00, 0x90, 0x3C, 0x64, 0x00, 0xF0, 0x02, 0x7E, 0xF7, 0x00, 0x3C, 0x00, 0x00, 0xFF, 0x2F, 0x00 };
+    LE::SW::MIDIMelody melody;
+    XCTAssertTrue( parse( melody, smf( { tempoTrack, afterMeta  } ) ) != nullptr );
+    XCTAssertTrue( parse( melody, smf( { tempoTrack, afterSysEx } ) ) != nullptr );
+    XCTAssertTrue( !melody );
+}
+
+- (void)testRejectsTruncatedFiles
+{
+    Bytes const track{ 0x00, 0x90, 0x3C, 0x64, 0x83, 0x60, 0x3C, 0x00, 0x00, 0xFF, 0x2F, 0x00 };
+    Bytes const file( smf( { tempoTrack, track } ) );
+    LE::SW::MIDIMelody melody;
+    for ( std::size_t size( 0 ); size < file.size(); ++size )
+    {
+        Bytes const truncated( file.begin(), file.begin() + size );
+        XCTAssertTrue( melody.parse( truncated.data(), truncated.data() + truncated.size(), 1, 0 ) != nullptr );
+    }
+    XCTAssertTrue( parse( melody, file ) == nullptr );
+}
+
+- (void)testTrimmingRetriggersSoundingNotes
+{
+    Bytes const track
+    {
+        0x00, 0xB0, 0x07, 0x50,       // volume
+        0x00, 0x90, 0x3C, 0x64,       // note on
+        0x87, 0x40, 0x80, 0x3C, 0x00, // note off, 960 ticks (1 s) later
+        0x00, 0xFF, 0x2F, 0x00
+    };
+    LE::SW::MIDIMelody melody;
+    XCTAssertTrue( parse( melody, smf( { tempoTrack, track } ) ) == nullptr );
+    LE::SW::MIDIMelody const trimmed( melody.trimmed( 0.5 ) );
+    XCTAssertEqualWithAccuracy( trimmed.lengthInSeconds(), 0.5, 1e-6 );
+
+    Bytes const events( melodyTrack( trimmed ) );
+    Bytes const retriggered{ 0x00, 0xB0, 0x07, 0x50, 0x00, 0x90, 0x3C, 0x64 };
+    XCTAssertTrue( events.size() > retriggered.size() );
+    XCTAssertTrue( std::equal( retriggered.begin(), retriggered.end(), events.begin() ) );
+}
+
+@end
@@ -0,0 +1,559 @@
+//
+//  MP3DecoderTests.mm
+//  LE_Demo_iOSTests
+//
+//  MP3Decoder decoding, gapless length, seeking, tag/junk skipping,
+//  truncation and format rejection tests.
+//
+//  The fixtures are small LAME encoded streams (with the Info/LAME gapless
+//  header) of the signals below: an MPEG-1 mono stream and an MPEG-2 joint
+//  (MS) stereo stream, both also using start, short and stop blocks. The
+//  references are every 49th sample (frame) decoded by FFmpeg.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "le/audioio/mp3Decoder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    typedef std::vector<char> Bytes;
+
+    /// 1 channel, 44.1 kHz, 64 kbps, 11025 sample frames of
+    /// 0.5 sin( 2 pi 1000 t ).
+    unsigned char const mono44MP3[ 2506 ] =
+    {
+        0xFF, 0xFB, 0x50, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x6E, 0x66, 0x6F, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
+        0x0B, 0x00, 0x00, 0x09, 0xCA, 0x00, 0x2A, 0x2A, 0x2A, 0x2A, 0x2A, 0x2A, 0x2A, 0x2A, 0x2A, 0x3F,
+        0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x6A, 0x6A, 0x6A, 0x6A, 0x6A, 0x6A, 0x6A, 0x6A, 0x6A, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F,
+        0x7F, 0x7F, 0x7F, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF, 0xD5, 0xD5,
+        0xD5, 0xD5, 0xD5, 0xD5, 0xD5, 0xD5, 0xD5, 0xEA, 0xEA, 0xEA, 0xEA, 0xEA, 0xEA, 0xEA, 0xEA, 0xEA,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x4C, 0x61, 0x76,
+        0x63, 0x36, 0x31, 0x2E, 0x33, 0x2E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x24, 0x04, 0x2F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0xCA, 0xF0, 0xE7, 0x11,
+        0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xFF, 0xFB, 0x50, 0xC4, 0x00, 0x00, 0x09, 0xD8, 0x43, 0x48, 0x55, 0x84, 0x80, 0x01, 0x7B, 0x15,
+        0x68, 0xC7, 0x39, 0x10, 0x00, 0x07, 0xAA, 0xF5, 0x4E, 0xA9, 0xD5, 0x3A, 0xA7, 0x54, 0xEB, 0x1D,
+        0xC7, 0x86, 0xDA, 0xDA, 0x82, 0x40, 0xA8, 0x0B, 0x33, 0xB4, 0xE7, 0x53, 0xBD, 0x4E, 0x6D, 0x34,
+        0x85, 0x2B, 0xC1, 0x85, 0x02, 0x80, 0x00, 0x0C, 0x02, 0x02, 0x82, 0x46, 0x1B, 0x5D, 0x1A, 0x34,
+        0x68, 0xC1, 0xF3, 0x40, 0x80, 0x20, 0x08, 0x62, 0x70, 0x7F, 0x82, 0x0E, 0x9C, 0xE9, 0xF7, 0x72,
+        0xFE, 0x73, 0xA7, 0xDD, 0xD3, 0xEE, 0xE5, 0xC1, 0xF7, 0xC3, 0xE0, 0x81, 0xCA, 0x80, 0x61, 0xFD,
+        0x20, 0x87, 0x4F, 0xB8, 0x08, 0x20, 0x04, 0x83, 0x0C, 0x22, 0x18, 0xDE, 0xFF, 0x66, 0x2D, 0x22,
+        0x18, 0xB0, 0xA3, 0xA3, 0x01, 0xA0, 0x3C, 0xC0, 0x64, 0xF3, 0xE3, 0x48, 0x0C, 0x5E, 0x40, 0x30,
+        0xFD, 0x7C, 0x90, 0x10, 0x7C, 0xD7, 0xA1, 0x89, 0xC1, 0x20, 0x23, 0x81, 0xC2, 0xAE, 0x00, 0x04,
+        0x3F, 0x60, 0xCB, 0x5F, 0x86, 0x46, 0x1C, 0x91, 0x64, 0x8A, 0xD7, 0xFC, 0x87, 0x0E, 0x70, 0xCB,
+        0x13, 0x24, 0x57, 0xFF, 0x20, 0x26, 0x44, 0x58, 0x8B, 0x18, 0x97, 0x7F, 0xFC, 0x8A, 0x99, 0x17,
+        0x89, 0xA3, 0x12, 0xE9, 0x77, 0xF8, 0x34, 0x15, 0x05, 0x44, 0x47, 0xBF, 0xD6, 0x0A, 0x88, 0x82,
+        0xA0, 0xA9, 0x65, 0xD6, 0x59, 0x4D, 0x85, 0x80, 0x06, 0x30, 0x2C, 0x80, 0x45, 0x30, 0x30, 0x01,
+        0xFF, 0xFB, 0x52, 0xC4, 0x06, 0x83, 0xCA, 0x2C, 0x2D, 0x0E, 0x1D, 0xFD, 0x80, 0x01, 0x07, 0x05,
+        0xA2, 0x01, 0xBF, 0xF1, 0x08, 0x7F, 0x30, 0x70, 0x01, 0x83, 0x30, 0x54, 0x00, 0xAB, 0x30, 0x41,
+        0x82, 0x2B, 0x30, 0xE7, 0x06, 0x81, 0x32, 0x54, 0x09, 0x8B, 0x32, 0x5C, 0xBD, 0xA9, 0x39, 0x19,
+        0x93, 0x0C, 0x31, 0x81, 0x42, 0x7F, 0x30, 0xB1, 0x01, 0x53, 0x30, 0x54, 0x01, 0xB5, 0x30, 0x3C,
+        0x80, 0x7E, 0x34, 0xC8, 0xC3, 0xAF, 0x4A, 0x32, 0x12, 0x62, 0xD1, 0xA7, 0x90, 0xF6, 0x7F, 0xFF,
+        0xFD, 0x3F, 0xFF, 0xFF, 0xFF, 0xFC, 0x9F, 0xFF, 0xFD, 0xBF, 0xFF, 0x91, 0x00, 0xD1, 0xBE, 0x0E,
+        0x98, 0xE9, 0x41, 0x99, 0x22, 0x9A, 0x9A, 0x91, 0xC3, 0xCA, 0x18, 0x18, 0x40, 0x7E, 0x98, 0x30,
+        0x61, 0x32, 0x18, 0xB0, 0x96, 0xA5, 0x9F, 0x2B, 0x03, 0x76, 0x18, 0x5D, 0x00, 0xC3, 0x9C, 0x15,
+        0x44, 0x67, 0x41, 0xF8, 0x41, 0x08, 0x44, 0x09, 0x30, 0x58, 0x28, 0x0C, 0x05, 0x57, 0x5E, 0xCF,
+        0xFF, 0xFF, 0xFD, 0x3F, 0xFF, 0xFF, 0xFF, 0xFD, 0xBF, 0xFF, 0xF6, 0xAA, 0xFF, 0xDD, 0xC2, 0x43,
+        0x86, 0xD8, 0xF9, 0x83, 0x58, 0x64, 0xA0, 0x9B, 0x38, 0x47, 0xBF, 0x11, 0x81, 0x78, 0x04, 0x79,
+        0x83, 0x1E, 0x0A, 0x31, 0x8B, 0xA0, 0xC3, 0xF9, 0xF9, 0x08, 0x1D, 0x91, 0x86, 0x28, 0x06, 0x19,
+        0xC6, 0xC8, 0x00, 0x68, 0x69, 0x8E, 0x41, 0x60, 0x10, 0xC8, 0xA8, 0x40, 0xBC, 0xAD, 0x6B, 0x5F,
+        0xFF, 0xFF, 0xFB, 0x52, 0xC4, 0x1A, 0x83, 0xC7, 0xE0, 0x2F, 0x12, 0x0D, 0x7F, 0x88, 0x40, 0xCB,
+        0x85, 0xE2, 0x41, 0xAF, 0xF1, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFA, 0xFF, 0xFF, 0xEB,
+        0xFF, 0xDD, 0xC2, 0xC2, 0x01, 0xD4, 0x65, 0x55, 0xC2, 0x08, 0x26, 0x55, 0xA1, 0xDB, 0x64, 0x60,
+        0x5C, 0x00, 0x32, 0x2C, 0x19, 0xF1, 0x8C, 0x3C, 0x13, 0x91, 0xFF, 0x74, 0x02, 0x39, 0x86, 0x80,
+        0x00, 0x31, 0xCB, 0xC1, 0xA6, 0x98, 0x0C, 0x19, 0x34, 0x56, 0x61, 0x31, 0x28, 0x20, 0x2C, 0x3A,
+        0x01, 0x7A, 0x35, 0xFF, 0xFD, 0x12, 0xB8, 0x7D, 0xBE, 0x61, 0x50, 0x61, 0xEA, 0x55, 0x70, 0xA7,
+        0x23, 0x02, 0x78, 0x05, 0x63, 0x05, 0xF4, 0x14, 0x13, 0x16, 0xE9, 0xA2, 0x83, 0xEF, 0x78, 0x3F,
+        0x53, 0x0C, 0x30, 0x0D, 0xE3, 0x8F, 0x9A, 0x4D, 0x28, 0x46, 0x32, 0xA8, 0xFC, 0xC4, 0x22, 0xB3,
+        0x07, 0x05, 0x0B, 0x3E, 0xD6, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xA3, 0xFF,
+        0xFE, 0x8F, 0xFD, 0xD4, 0x1D, 0x20, 0x39, 0x72, 0x33, 0x24, 0x2A, 0x32, 0xF2, 0xF0, 0x12, 0x21,
+        0x86, 0xA5, 0x98, 0x12, 0x40, 0x7A, 0x18, 0x31, 0x61, 0x5C, 0x98, 0xC2, 0x9A, 0x83, 0x1F, 0xF5,
+        0x04, 0x0F, 0x98, 0x68, 0x00, 0xEC, 0x1C, 0xDD, 0xC2, 0x6A, 0xA4, 0x41, 0x9C, 0x4C, 0xE6, 0x3D,
+        0x1D, 0x98, 0xA8, 0x34, 0x60, 0xF0, 0x0A, 0x96, 0x33, 0xA7, 0xDB, 0xFF, 0xFF, 0x6F, 0x6F, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFB, 0x52, 0xC4, 0x3F, 0x83, 0xC7, 0xD0, 0x2D, 0x12, 0x0C, 0xFF, 0x88, 0x41,
+        0x13, 0x85, 0xA1, 0xC1, 0xBF, 0xF1, 0x08, 0xFF, 0x47, 0xFF, 0xFD, 0x0A, 0xFF, 0xFC, 0x07, 0x41,
+        0x0E, 0x8C, 0x1C, 0xCA, 0x02, 0x00, 0x4E, 0xE6, 0x78, 0x16, 0x63, 0x8E, 0x66, 0x01, 0x20, 0x23,
+        0x06, 0x06, 0x18, 0x5E, 0x66, 0x1A, 0xC7, 0x17, 0x47, 0x1D, 0x51, 0x16, 0x66, 0x0E, 0x30, 0x3F,
+        0x07, 0x53, 0xD2, 0x6C, 0x50, 0x86, 0x96, 0xA6, 0x65, 0xE4, 0x66, 0x50, 0x0C, 0x18, 0x3E, 0xA4,
+        0x3D, 0x3E, 0xDF, 0xFF, 0xFB, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xA3, 0xFF, 0xFE, 0x8F, 0xFF, 0xE4,
+        0x28, 0xA5, 0x7C, 0x79, 0x74, 0xD0, 0xC1, 0x0D, 0x48, 0xBC, 0xD4, 0x25, 0x4C, 0x03, 0x10, 0x4E,
+        0x0C, 0x01, 0x20, 0xCA, 0xCC, 0x01, 0x4F, 0x14, 0x8C, 0x2E, 0x62, 0x50, 0x4C, 0x01, 0x00, 0x86,
+        0x0C, 0x2F, 0xCC, 0xC6, 0x20, 0x0C, 0xA5, 0x14, 0xC9, 0x43, 0xC3, 0x94, 0x09, 0x88, 0xD4, 0x41,
+        0x1D, 0x3E, 0xDF, 0xFF, 0xFB, 0x7A, 0x3F, 0xFF, 0xFF, 0xFF, 0xFA, 0x3F, 0xFF, 0xE8, 0xFF, 0xFC,
+        0x47, 0x40, 0xCE, 0x94, 0x10, 0xCA, 0x83, 0xCD, 0x04, 0xA8, 0xD6, 0x11, 0xCD, 0xD2, 0x84, 0xC0,
+        0x87, 0x04, 0xC8, 0xC0, 0xE8, 0x0C, 0x14, 0xC3, 0x3D, 0xE4, 0xE8, 0xE1, 0xD1, 0x23, 0x1C, 0xC1,
+        0xAB, 0x07, 0xE0, 0xE1, 0xB7, 0xCC, 0x95, 0xB0, 0x42, 0x52, 0x34, 0x4E, 0x18, 0x7A, 0x24, 0x3C,
+        0xA8, 0x51, 0xD3, 0xFF, 0xFB, 0x52, 0xC4, 0x5B, 0x83, 0xC8, 0x30, 0x2D, 0x10, 0x0D, 0xFF, 0x68,
+        0x41, 0x02, 0x05, 0xA2, 0x01, 0xBF, 0xED, 0x08, 0xFF, 0xFF, 0xFF, 0xA3, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xB3, 0xFF, 0xFE, 0xCF, 0xFD, 0x55, 0x1D, 0x1F, 0x39, 0xB2, 0x03, 0x28, 0x31, 0x34, 0x14, 0xE3,
+        0x64, 0x61, 0x39, 0xCB, 0x13, 0x03, 0x6C, 0x13, 0x03, 0x06, 0xA0, 0x2E, 0x13, 0x18, 0x07, 0x62,
+        0x63, 0xF9, 0x04, 0x84, 0xD3, 0x0C, 0xAC, 0x1D, 0xA3, 0x8E, 0x32, 0xCC, 0xFA, 0x54, 0x31, 0x00,
+        0x0C, 0x1A, 0x08, 0x30, 0xA0, 0x3C, 0x04, 0x16, 0x52, 0xDD, 0xF5, 0xFF, 0xFF, 0xFF, 0xF7, 0x7F,
+        0xFF, 0xFF, 0xFF, 0xEA, 0xFF, 0xFF, 0xAA, 0xFF, 0xFD, 0x92, 0x9D, 0x38, 0x27, 0x8C, 0x32, 0xB3,
+        0x2F, 0x00, 0xDB, 0x43, 0x3E, 0x1A, 0x4C, 0x0B, 0xB0, 0x27, 0x0C, 0x18, 0x80, 0x5B, 0xCC, 0x5B,
+        0x36, 0xDE, 0x8F, 0xB4, 0xF1, 0x0A, 0xCC, 0x30, 0x30, 0x37, 0x8E, 0x24, 0x4F, 0x34, 0x18, 0x18,
+        0xC6, 0x80, 0x40, 0x60, 0x58, 0x40, 0x0F, 0x2E, 0x73, 0x59, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xEC, 0xFF, 0xFF, 0xB3, 0xFF, 0x57, 0x4B, 0x02, 0x10, 0xB8, 0x88, 0x70, 0x5E, 0x0D,
+        0x20, 0x18, 0x68, 0x72, 0x65, 0xE1, 0xE9, 0xAF, 0x46, 0x07, 0x9E, 0x22, 0x98, 0xC3, 0xA2, 0x99,
+        0x1F, 0xF5, 0xE0, 0x5B, 0x98, 0x67, 0xE0, 0x05, 0x06, 0x96, 0x0D, 0x2E, 0x11, 0x32, 0x50, 0x98,
+        0xC2, 0x02, 0x40, 0xA8, 0xFF, 0xFB, 0x52, 0xC4, 0x78, 0x83, 0xC8, 0x10, 0x2D, 0x10, 0x0D, 0xFF,
+        0x68, 0x41, 0x0D, 0x05, 0xE1, 0xC1, 0xBF, 0xF1, 0x08, 0x54, 0x90, 0x00, 0xF4, 0xEE, 0xFF, 0xFB,
+        0xA4, 0x8E, 0x9E, 0x0F, 0x00, 0x6B, 0x02, 0x6C, 0x22, 0x84, 0x1F, 0xE9, 0x81, 0x4A, 0x02, 0x19,
+        0x83, 0x08, 0x08, 0xB1, 0x8B, 0xB2, 0xB8, 0xB9, 0xFA, 0x02, 0x1B, 0xD1, 0x86, 0x36, 0x06, 0x19,
+        0xC8, 0x8B, 0x86, 0x97, 0x20, 0x99, 0x50, 0x78, 0x61, 0xE1, 0x51, 0x82, 0xC2, 0xA1, 0x40, 0x03,
+        0x5B, 0x6F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x9F, 0xFF, 0xFA, 0x7F, 0xFF, 0x32,
+        0x03, 0x67, 0xE0, 0xE1, 0x99, 0x4A, 0x68, 0x95, 0x19, 0x50, 0xA6, 0x51, 0x91, 0x81, 0x12, 0x06,
+        0x19, 0x82, 0xD4, 0x11, 0xF1, 0x8B, 0x2B, 0x61, 0xC9, 0xF4, 0xF6, 0x36, 0x01, 0x85, 0xF6, 0x0C,
+        0x39, 0xC6, 0x97, 0x06, 0x99, 0x38, 0x99, 0x80, 0xA8, 0x63, 0x01, 0x81, 0x88, 0x42, 0xE0, 0x20,
+        0x62, 0xBB, 0x6F, 0x47, 0xFF, 0xFF, 0xFE, 0xCF, 0xFF, 0xFF, 0xFF, 0xFE, 0x9F, 0xFF, 0xFA, 0x6A,
+        0xFF, 0xFC, 0xC6, 0x03, 0xCE, 0xE0, 0x38, 0xCC, 0x44, 0xCD, 0x08, 0x30, 0xD1, 0x41, 0x8C, 0x5D,
+        0xF8, 0xC0, 0x41, 0x04, 0xE4, 0xC1, 0x02, 0x0D, 0x28, 0xC4, 0x43, 0xFC, 0xCC, 0xED, 0x23, 0x26,
+        0xC8, 0xC2, 0x47, 0x08, 0xDC, 0xDB, 0x50, 0x83, 0x3F, 0xA6, 0x4C, 0xBC, 0x64, 0x31, 0xD0, 0xC0,
+        0xC6, 0x60, 0xF0, 0x70, 0xA1, 0xFF, 0xFB, 0x52, 0xC4, 0x94, 0x83, 0xC7, 0xD8, 0x2D, 0x12, 0x0D,
+        0x7F, 0x88, 0x40, 0xCC, 0x05, 0xE2, 0x41, 0xCF, 0xF1, 0x44, 0x2E, 0xD3, 0xD1, 0xEC, 0xFF, 0xFF,
+        0xB3, 0xA7, 0xFF, 0xFF, 0xFF, 0xFF, 0xA7, 0xFF, 0xFE, 0x9F, 0xFF, 0xEB, 0xB2, 0x36, 0xB8, 0x4C,
+        0xBE, 0x06, 0x85, 0x34, 0xF2, 0x83, 0x4B, 0x90, 0x30, 0x07, 0x81, 0x37, 0x00, 0x06, 0x4C, 0x60,
+        0x70, 0xF8, 0x62, 0x65, 0x54, 0x92, 0x74, 0x60, 0x3B, 0x84, 0x2E, 0x65, 0x9E, 0x86, 0x4F, 0x06,
+        0x65, 0xC9, 0x06, 0x4C, 0x24, 0x10, 0xA6, 0x44, 0x40, 0xA1, 0x69, 0xE8, 0xF6, 0x7F, 0xFF, 0xD9,
+        0xD3, 0xFF, 0xFF, 0xFF, 0xFF, 0xD3, 0xFF, 0xFF, 0x4D, 0xFF, 0xFC, 0x90, 0xE0, 0x74, 0xC0, 0x26,
+        0x5A, 0x14, 0x68, 0x44, 0xA6, 0xB2, 0x84, 0x6E, 0x34, 0x06, 0x03, 0xD0, 0x26, 0xE6, 0x06, 0x58,
+        0x62, 0x06, 0x16, 0x87, 0x46, 0xA6, 0xEB, 0xC1, 0x1D, 0x86, 0x0B, 0x70, 0x40, 0x66, 0xDF, 0xC8,
+        0x62, 0xCE, 0x20, 0x02, 0xE0, 0xC2, 0xC1, 0x24, 0x21, 0x61, 0xD5, 0x44, 0x9E, 0x8F, 0xFF, 0xFF,
+        0xFD, 0x3F, 0xFF, 0xFF, 0xFF, 0xFC, 0x9F, 0xFF, 0xFD, 0xA5, 0xD4, 0x00, 0x06, 0xFD, 0xB5, 0x8C,
+        0x80, 0x1F, 0xF7, 0x2C, 0xC0, 0x60, 0x15, 0x5E, 0x62, 0x23, 0x11, 0xAF, 0x99, 0x46, 0x22, 0x15,
+        0x01, 0x87, 0x0C, 0x8C, 0xB2, 0x05, 0xED, 0x31, 0x69, 0x44, 0xCA, 0x7F, 0x93, 0xFA, 0x23, 0x8C,
+        0xE8, 0x38, 0x05, 0x06, 0x17, 0xE4, 0xFF, 0xFB, 0x52, 0xC4, 0xB9, 0x83, 0xC7, 0xE8, 0x2D, 0x12,
+        0x0C, 0xFF, 0x88, 0x41, 0x08, 0x05, 0xA2, 0x01, 0xAF, 0xF1, 0x08, 0x3E, 0xED, 0xD0, 0x58, 0xB0,
+        0x22, 0x08, 0x31, 0xA2, 0x83, 0x32, 0x32, 0x32, 0x81, 0x00, 0x4A, 0xF9, 0xEA, 0x71, 0x1E, 0x74,
+        0xC1, 0xAA, 0x01, 0x18, 0xD9, 0xE9, 0xA2, 0x9C, 0x87, 0x1D, 0x98, 0x51, 0x11, 0x92, 0x06, 0x01,
+        0x49, 0x4D, 0x71, 0x90, 0xD7, 0x93, 0x0C, 0xC8, 0x59, 0x00, 0xA6, 0x22, 0x42, 0x65, 0x66, 0x26,
+        0x62, 0x56, 0x63, 0xE0, 0xE2, 0x81, 0x06, 0x56, 0x56, 0x64, 0x61, 0xE9, 0x7C, 0x60, 0x81, 0x01,
+        0x01, 0x03, 0x20, 0x66, 0x22, 0x2E, 0x02, 0x27, 0x0A, 0x07, 0x19, 0x99, 0xB9, 0x88, 0x84, 0xA1,
+        0x5B, 0x74, 0x42, 0x41, 0x78, 0x13, 0x01, 0xC4, 0xA1, 0x72, 0x27, 0x5C, 0x36, 0xBF, 0x2E, 0x56,
+        0xC2, 0xEE, 0x29, 0x62, 0xF3, 0x30, 0x20, 0x40, 0x50, 0x23, 0x34, 0x70, 0xD7, 0x7B, 0x5F, 0x9F,
+        0xF9, 0x5C, 0x62, 0x31, 0x18, 0xB1, 0x5D, 0xDB, 0x72, 0xE1, 0xF8, 0xE3, 0x0F, 0x6B, 0xF4, 0x72,
+        0x88, 0xC5, 0xEA, 0xF6, 0xF0, 0x8D, 0xCB, 0xED, 0xFD, 0x4A, 0x4A, 0x4B, 0x1B, 0xA4, 0xB1, 0xBC,
+        0xF3, 0xD5, 0x4C, 0x33, 0x8C, 0x4B, 0x1C, 0x1E, 0x3F, 0x3F, 0xF8, 0xED, 0x07, 0xBC, 0x42, 0x68,
+        0x00, 0x00, 0x09, 0x08, 0xC5, 0xA3, 0x51, 0xA8, 0xB0, 0x40, 0x10, 0x00, 0x03, 0xD0, 0xF4, 0xFA,
+        0xF2, 0x69, 0x50, 0xDF, 0xF8, 0x88, 0x49, 0xFF, 0xFB, 0x52, 0xC4, 0xD6, 0x83, 0xC8, 0x90, 0x2D,
+        0x0E, 0x0D, 0xFF, 0x88, 0x40, 0xFC, 0x85, 0xA2, 0x01, 0xBF, 0xED, 0x08, 0x8C, 0xA7, 0x66, 0xAF,
+        0xF9, 0xFA, 0xCE, 0x68, 0x83, 0x61, 0x6B, 0xFC, 0x03, 0x98, 0x80, 0x33, 0xA1, 0x09, 0x88, 0x9E,
+        0x07, 0x20, 0xF8, 0x1B, 0x88, 0xE0, 0xD5, 0x80, 0xBC, 0x32, 0x37, 0xE0, 0x69, 0xEA, 0x81, 0x8B,
+        0x1E, 0x14, 0xF2, 0x14, 0xB4, 0x2E, 0x51, 0x1C, 0x90, 0x01, 0x42, 0xF8, 0x1D, 0x3A, 0x40, 0x66,
+        0xA6, 0x80, 0x64, 0x40, 0x42, 0x98, 0x0D, 0x58, 0xB2, 0x02, 0x5C, 0x3E, 0x43, 0x8C, 0xFE, 0x06,
+        0xB0, 0x40, 0x1A, 0x42, 0xE0, 0x66, 0x4E, 0x00, 0x83, 0x60, 0x60, 0x0E, 0x81, 0x86, 0x18, 0x3A,
+        0x89, 0xA4, 0xCC, 0x0C, 0x55, 0xF8, 0x36, 0x0B, 0x0C, 0x14, 0x0D, 0x89, 0x0C, 0x54, 0x16, 0x34,
+        0x18, 0xF8, 0x5F, 0xC3, 0x14, 0x54, 0xBD, 0x5F, 0xC8, 0x80, 0xD2, 0x1D, 0xA2, 0xB5, 0x19, 0xE1,
+        0x9F, 0x29, 0x8F, 0x03, 0xBF, 0xFF, 0xFF, 0x36, 0x31, 0x39, 0x0C, 0x04, 0x24, 0x12, 0x4C, 0x41,
+        0x4D, 0x45, 0x33, 0x2E, 0x31, 0x30, 0x30, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xFF, 0xFB, 0x52, 0xC4, 0xF2, 0x80, 0x08, 0x0C,
+        0x2D, 0x10, 0x0D, 0xFF, 0x68, 0x43, 0x41, 0x1D, 0xE8, 0x76, 0xB9, 0xB0, 0x07, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xFF, 0xFB, 0x52, 0xC4, 0xC8, 0x00, 0x13,
+        0x39, 0x03, 0x53, 0xB9, 0xAA, 0x00, 0x18, 0x00, 0x00, 0x34, 0x83, 0x80, 0x00, 0x04, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA
+    };
+    unsigned int const mono44Frames[] = { 0, 208, 416, 625, 834, 1043, 1252, 1461, 1670, 1879, 2088, 2297 };
+
+    float const mono44Reference[ 225 ] =
+    {
+        +0.009044f, +0.305149f, +0.466467f, +0.410465f, +0.162598f, -0.160363f, -0.412287f, -0.467920f,
+        -0.304518f, +0.000435f, +0.305381f, +0.466621f, +0.410496f, +0.162193f, -0.162434f, -0.411355f,
+        -0.467736f, -0.305296f, +0.000005f, +0.305319f, +0.467762f, +0.411359f, +0.162484f, -0.162419f,
+        -0.411381f, -0.467794f, -0.305342f, -0.000001f, +0.305365f, +0.467800f, +0.411324f, +0.162449f,
+        -0.162467f, -0.411385f, -0.467782f, -0.305310f, +0.000031f, +0.305322f, +0.467756f, +0.411296f,
+        +0.162375f, -0.162452f, -0.411308f, -0.467736f, -0.305329f, -0.000022f, +0.305298f, +0.467783f,
+        +0.411361f, +0.162463f, -0.162429f, -0.411339f, -0.467751f, -0.305313f, -0.000014f, +0.305291f,
+        +0.467768f, +0.411349f, +0.162400f, -0.162516f, -0.411364f, -0.467758f, -0.305302f, +0.000058f,
+        +0.305351f, +0.467734f, +0.411345f, +0.162451f, -0.162456f, -0.411352f, -0.467777f, -0.305333f,
+        -0.000002f, +0.305357f, +0.467812f, +0.411396f, +0.162459f, -0.162470f, -0.411359f, -0.467800f,
+        -0.305359f, +0.000011f, +0.305353f, +0.467798f, +0.411402f, +0.162439f, -0.162463f, -0.411395f,
+        -0.467762f, -0.305296f, +0.000035f, +0.305363f, +0.467818f, +0.411335f, +0.162454f, -0.162432f,
+        -0.411330f, -0.467791f, -0.305345f, -0.000001f, +0.305326f, +0.467773f, +0.411363f, +0.162455f,
+        -0.162450f, -0.411353f, -0.467751f, -0.305344f, +0.000005f, +0.305327f, +0.467808f, +0.411354f,
+        +0.162454f, -0.162432f, -0.411380f, -0.467792f, -0.305302f, +0.000011f, +0.305319f, +0.467747f,
+        +0.411323f, +0.162451f, -0.162428f, -0.411349f, -0.467783f, -0.305331f, -0.000003f, +0.305378f,
+        +0.467812f, +0.411372f, +0.162464f, -0.162462f, -0.411364f, -0.467845f, -0.305387f, +0.000002f,
+        +0.305382f, +0.467826f, +0.411361f, +0.162465f, -0.162456f, -0.411371f, -0.467723f, -0.305205f,
+        +0.000033f, +0.305309f, +0.467784f, +0.411362f, +0.162448f, -0.162481f, -0.411323f, -0.467750f,
+        -0.305312f, +0.000018f, +0.305270f, +0.467705f, +0.411324f, +0.162428f, -0.162462f, -0.411423f,
+        -0.467763f, -0.305280f, +0.000005f, +0.305343f, +0.467803f, +0.411374f, +0.162457f, -0.162492f,
+        -0.411371f, -0.467830f, -0.305337f, -0.000018f, +0.305305f, +0.467750f, +0.411397f, +0.162515f,
+        -0.162491f, -0.411372f, -0.467808f, -0.305349f, +0.000002f, +0.305301f, +0.467767f, +0.411342f,
+        +0.162450f, -0.162452f, -0.411354f, -0.467756f, -0.305292f, +0.000033f, +0.305362f, +0.467799f,
+        +0.411351f, +0.162433f, -0.162439f, -0.411359f, -0.467791f, -0.305357f, -0.000000f, +0.305359f,
+        +0.467790f, +0.411391f, +0.162505f, -0.162455f, -0.411379f, -0.467734f, -0.305273f, -0.000059f,
+        +0.304991f, +0.467006f, +0.411138f, +0.162637f, -0.162788f, -0.411385f, -0.467145f, -0.305562f,
+        -0.000735f, +0.305401f, +0.467039f, +0.411628f, +0.164064f, -0.161534f, -0.411076f, -0.467779f,
+        -0.304181f
+    };
+    /// 2 channels, 22.05 kHz, 32 kbps, 6615 sample frames of 0.1 s of silence
+    /// followed by 0.5 sin( 2 pi 500 t ) (left) and 0.25 sin( 2 pi 500 t ) +
+    /// 0.2 sin( 2 pi 1500 t ) (right).
+    unsigned char const stereo22MP3[ 1645 ] =
+    {
+        0xFF, 0xF3, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x6E, 0x66, 0x6F, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
+        0x0E, 0x00, 0x00, 0x06, 0x6D, 0x00, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x3C, 0x3C, 0x3C,
+        0x3C, 0x3C, 0x3C, 0x3C, 0x4D, 0x4D, 0x4D, 0x4D, 0x4D, 0x4D, 0x4D, 0x5D, 0x5D, 0x5D, 0x5D, 0x5D,
+        0x5D, 0x5D, 0x6D, 0x6D, 0x6D, 0x6D, 0x6D, 0x6D, 0x6D, 0x7D, 0x7D, 0x7D, 0x7D, 0x7D, 0x7D, 0x7D,
+        0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0xAE,
+        0xAE, 0xAE, 0xAE, 0xAE, 0xAE, 0xAE, 0xBE, 0xBE, 0xBE, 0xBE, 0xBE, 0xBE, 0xBE, 0xCF, 0xCF, 0xCF,
+        0xCF, 0xCF, 0xCF, 0xCF, 0xDF, 0xDF, 0xDF, 0xDF, 0xDF, 0xDF, 0xDF, 0xEF, 0xEF, 0xEF, 0xEF, 0xEF,
+        0xEF, 0xEF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x4C, 0x61, 0x76,
+        0x63, 0x36, 0x31, 0x2E, 0x33, 0x2E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x24, 0x03, 0x69, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x6D, 0x40, 0x01, 0x6F,
+        0x4B, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xF3, 0x40, 0x64, 0x00, 0x00, 0x00, 0x01, 0xA4, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x48, 0x00, 0x00, 0x00, 0x00, 0x4C, 0x41, 0x4D, 0x45, 0x33,
+        0x2E, 0x31, 0x30, 0x30, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xFF, 0xC3, 0x35, 0x44, 0xFF, 0xF3,
+        0x42, 0x64, 0x53, 0x00, 0x00, 0x01, 0xA4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x48, 0x00,
+        0x00, 0x00, 0x00, 0x94, 0x3F, 0xF9, 0xD1, 0x04, 0x06, 0x3C, 0x77, 0xFD, 0xFA, 0x43, 0xB3, 0xC2,
+        0x89, 0x79, 0x52, 0x80, 0x6D, 0xA3, 0x24, 0x48, 0xF6, 0xCD, 0x6F, 0xEC, 0xE8, 0x1A, 0x0B, 0x78,
+        0x37, 0xC1, 0x99, 0x19, 0x9F, 0xD9, 0xB2, 0x68, 0xC4, 0x99, 0x32, 0x3B, 0xFD, 0xBF, 0x31, 0x38,
+        0xB3, 0x15, 0x0B, 0xFF, 0xC4, 0x62, 0xC1, 0x70, 0x4F, 0xFF, 0xE8, 0x3E, 0x65, 0x0F, 0x33, 0xE4,
+        0x91, 0x2D, 0xD8, 0x66, 0xC6, 0x16, 0xE8, 0x01, 0x85, 0x06, 0x53, 0xB5, 0x00, 0xE6, 0x8C, 0x11,
+        0x1B, 0xB2, 0x90, 0x1C, 0xA3, 0x98, 0xA3, 0xFF, 0xF3, 0x40, 0x64, 0xA7, 0x00, 0x00, 0x01, 0xA4,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x48, 0x00, 0x00, 0x00, 0x00, 0xFB, 0xB8, 0x65, 0x00,
+        0x37, 0x8E, 0x61, 0xCD, 0xFF, 0x97, 0x52, 0x06, 0x59, 0xF9, 0x61, 0x61, 0x55, 0x15, 0x9C, 0x00,
+        0x6F, 0x1C, 0x7F, 0x2C, 0xB3, 0x94, 0xC6, 0x6F, 0xBF, 0xAC, 0xF8, 0x2E, 0x14, 0x1E, 0xF2, 0x61,
+        0x00, 0x2C, 0x96, 0xC4, 0x35, 0x66, 0xB5, 0x36, 0x40, 0x52, 0xC1, 0xC1, 0x16, 0x22, 0xEA, 0x3D,
+        0xC4, 0x5D, 0x41, 0xCA, 0x00, 0x31, 0x00, 0xE0, 0x01, 0x68, 0xA3, 0x49, 0x2A, 0x28, 0xD1, 0x2C,
+        0x0C, 0x70, 0x2D, 0x34, 0x59, 0x26, 0xAC, 0x92, 0x2A, 0x49, 0xD2, 0xA2, 0x8A, 0x3E, 0x97, 0xFF,
+        0xF3, 0x42, 0x64, 0xAB, 0x00, 0x00, 0x01, 0xA4, 0x00, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x03, 0x48,
+        0x01, 0x40, 0x00, 0x00, 0x45, 0x15, 0x8E, 0x40, 0x52, 0x00, 0xE1, 0x35, 0x18, 0x7A, 0xF8, 0x89,
+        0xDA, 0x83, 0x8A, 0xFF, 0xFD, 0x12, 0x87, 0x0C, 0x76, 0x1F, 0x30, 0x10, 0xA0, 0xC0, 0x63, 0x52,
+        0xA8, 0x70, 0xA0, 0xE4, 0x69, 0xE2, 0xB1, 0xDF, 0x68, 0x26, 0x2D, 0xD3, 0x45, 0x07, 0xDE, 0xF0,
+        0x7E, 0xA6, 0x18, 0x60, 0x1B, 0xC7, 0x1F, 0x34, 0x9A, 0x50, 0x8C, 0x65, 0x51, 0xF9, 0x88, 0x45,
+        0x66, 0x0E, 0x0A, 0x16, 0x7D, 0xAC, 0x6B, 0xFF, 0xFE, 0x48, 0xE3, 0xC4, 0x20, 0x39, 0x24, 0x1E,
+        0x8E, 0x06, 0x02, 0xE0, 0x1E, 0x61, 0x3C, 0x65, 0xFF, 0xF3, 0x40, 0x64, 0xFF, 0x07, 0xFC, 0xA5,
+        0x58, 0x00, 0xCC, 0xC0, 0x00, 0x0A, 0x28, 0xF2, 0xB0, 0x01, 0x92, 0x68, 0x00, 0x46, 0xEC, 0x40,
+        0xCA, 0x60, 0x90, 0x00, 0x41, 0xC0, 0x2E, 0x9A, 0x8C, 0x4D, 0xFF, 0x8C, 0x57, 0xC3, 0xFD, 0x32,
+        0xE0, 0x4B, 0x86, 0x09, 0xE3, 0x40, 0x22, 0x07, 0x08, 0x41, 0x00, 0x48, 0xBA, 0x62, 0xA7, 0xA0,
+        0x7A, 0x54, 0x5A, 0x62, 0x10, 0xA0, 0x60, 0x28, 0x2A, 0x14, 0x00, 0x13, 0x9D, 0x76, 0x3B, 0x91,
+        0x79, 0xCE, 0xD5, 0xFF, 0xFD, 0x27, 0x70, 0x18, 0xAE, 0x04, 0x00, 0x18, 0x04, 0x02, 0x88, 0x82,
+        0x10, 0x69, 0x8A, 0x0A, 0x06, 0x8D, 0x83, 0x98, 0x4C, 0x0A, 0xA4, 0x1B, 0x32, 0x01, 0x99, 0x98,
+        0xFF, 0xF3, 0x42, 0x44, 0xE9, 0x04, 0xD0, 0x2D, 0x54, 0x2C, 0xED, 0x84, 0x01, 0x0A, 0x78, 0xAA,
+        0xBD, 0xB9, 0xD4, 0xA0, 0x02, 0x27, 0x80, 0x56, 0x1E, 0xB9, 0x26, 0xC9, 0x31, 0x9B, 0x2E, 0x61,
+        0xC3, 0x83, 0x80, 0x2B, 0xB8, 0x73, 0xFF, 0xFE, 0xE3, 0xCF, 0x49, 0x4F, 0x62, 0x6D, 0x5B, 0x00,
+        0x20, 0x26, 0x60, 0x94, 0x6B, 0x46, 0x81, 0x80, 0xDA, 0x60, 0x34, 0x00, 0x48, 0xFE, 0xCB, 0x1D,
+        0xF8, 0xDD, 0x26, 0x7C, 0xFF, 0x41, 0xD0, 0x0E, 0x07, 0x02, 0x48, 0xAA, 0x83, 0xC6, 0x00, 0x80,
+        0x86, 0x09, 0x05, 0x66, 0x36, 0xC1, 0x47, 0xE0, 0xA4, 0xA6, 0x29, 0x83, 0xC0, 0x20, 0x55, 0x30,
+        0x9C, 0x59, 0xEA, 0xB4, 0xD8, 0xAA, 0xFF, 0xFC, 0x07, 0xFF, 0xF3, 0x40, 0x44, 0xEC, 0x06, 0x78,
+        0x2F, 0x12, 0x00, 0x73, 0xFC, 0x30, 0x11, 0x98, 0xC6, 0x54, 0x00, 0xF3, 0x7A, 0xC4, 0x40, 0x43,
+        0x28, 0xC0, 0x73, 0x0A, 0x00, 0x80, 0x10, 0xEE, 0x61, 0xE0, 0x16, 0x60, 0xE0, 0xE6, 0x61, 0x22,
+        0x30, 0x66, 0x1D, 0xE6, 0x61, 0xAC, 0x71, 0x74, 0x71, 0xD5, 0x11, 0x66, 0x60, 0xE3, 0x03, 0xF0,
+        0x75, 0x3D, 0x26, 0xC5, 0x08, 0x69, 0x6A, 0x66, 0x5E, 0x46, 0x65, 0x00, 0xC1, 0x83, 0xEA, 0x43,
+        0xD3, 0xED, 0xFF, 0xFF, 0xB7, 0xFF, 0xFE, 0x68, 0x88, 0x3B, 0xA8, 0xDF, 0xB6, 0xA9, 0x6A, 0x30,
+        0x50, 0xC3, 0xE3, 0x30, 0x72, 0x91, 0x83, 0x5A, 0xE1, 0x51, 0x30, 0x30, 0x03, 0x83, 0x00, 0x30,
+        0x0D, 0xFF, 0xF3, 0x42, 0x44, 0xC4, 0x05, 0xB8, 0x2D, 0x1C, 0x00, 0x73, 0xFA, 0x30, 0x0F, 0xD8,
+        0xC2, 0x60, 0x00, 0xF1, 0xFA, 0xC4, 0x2E, 0xA2, 0x81, 0xB5, 0xF7, 0x52, 0x47, 0x63, 0xFF, 0xFF,
+        0xFF, 0x5B, 0xA8, 0xF1, 0xAB, 0x61, 0x80, 0xA0, 0x0D, 0x05, 0x40, 0x3D, 0x17, 0x08, 0x80, 0x6C,
+        0xC1, 0x30, 0x0C, 0x0C, 0x53, 0x4A, 0xFC, 0xE8, 0xE4, 0x63, 0x0E, 0x12, 0x31, 0x32, 0x50, 0x18,
+        0x14, 0x37, 0x08, 0x06, 0x20, 0x0D, 0x61, 0xDD, 0x89, 0x5E, 0x15, 0xFF, 0xFE, 0x42, 0x8A, 0x15,
+        0xF1, 0xE1, 0x74, 0xC4, 0x30, 0x10, 0xC5, 0x20, 0xBC, 0xC5, 0x02, 0x54, 0xC3, 0x14, 0xE0, 0xC1,
+        0x2C, 0xAC, 0xC0, 0x14, 0xF1, 0x48, 0xC2, 0xE6, 0x25, 0x04, 0xFF, 0xF3, 0x40, 0x44, 0xAA, 0x07,
+        0x38, 0x2D, 0x10, 0x00, 0x77, 0xFB, 0x30, 0x14, 0x28, 0xC6, 0x48, 0x00, 0xD7, 0xB8, 0x74, 0xC0,
+        0x10, 0x08, 0x60, 0xC2, 0xFC, 0xCC, 0x62, 0x00, 0xCA, 0x51, 0x4C, 0x94, 0x3C, 0x39, 0x40, 0x98,
+        0x8D, 0x44, 0x11, 0xD3, 0xED, 0xFF, 0xFF, 0xB7, 0xA3, 0xFF, 0xFE, 0xF9, 0x58, 0xD4, 0x98, 0x02,
+        0x24, 0x12, 0x30, 0x70, 0x04, 0xC1, 0xC2, 0xB3, 0x01, 0x9B, 0x02, 0x93, 0x50, 0xA3, 0x07, 0x06,
+        0x08, 0xC0, 0x75, 0x21, 0x60, 0x31, 0x84, 0x20, 0xA2, 0x0C, 0x02, 0x20, 0x08, 0x05, 0x97, 0xCD,
+        0x12, 0x18, 0xFC, 0x1D, 0xFF, 0xFB, 0xFE, 0xF2, 0xFC, 0x99, 0xA1, 0x91, 0x02, 0x61, 0x10, 0xEC,
+        0x00, 0x83, 0xFF, 0xF3, 0x42, 0x44, 0x72, 0x07, 0x18, 0x2D, 0x10, 0x00, 0x77, 0xFB, 0x30, 0x18,
+        0x80, 0xC6, 0x2C, 0x00, 0xE7, 0xFC, 0x60, 0x18, 0xC1, 0x60, 0x0A, 0xCC, 0x12, 0x82, 0x8C, 0xC0,
+        0x84, 0x70, 0x0C, 0x05, 0xFC, 0x34, 0xC9, 0xE6, 0x2D, 0x8C, 0x07, 0xC6, 0x24, 0x28, 0x14, 0xC1,
+        0x50, 0x57, 0x02, 0x01, 0x61, 0x80, 0x28, 0x09, 0x83, 0x80, 0x1C, 0x78, 0x01, 0x17, 0x1C, 0x99,
+        0xFF, 0xFC, 0x52, 0x5C, 0x0C, 0x79, 0x18, 0x34, 0x02, 0x98, 0x5A, 0x0C, 0x18, 0x7C, 0x17, 0x98,
+        0xA4, 0x3A, 0x98, 0xC2, 0x73, 0x19, 0x59, 0x26, 0x98, 0x4F, 0x36, 0x0D, 0x1B, 0x41, 0xA3, 0x5E,
+        0x98, 0x28, 0x60, 0xBF, 0x1B, 0x05, 0x29, 0x8B, 0xA6, 0x0A, 0x8C, 0xFF, 0xF3, 0x40, 0x44, 0x2B,
+        0x06, 0x50, 0x2D, 0x14, 0x00, 0x77, 0xFB, 0x30, 0x0E, 0x20, 0xC2, 0x68, 0x00, 0xE9, 0x7A, 0xA8,
+        0x8F, 0x07, 0x89, 0x10, 0x8B, 0x05, 0x33, 0x5F, 0xFF, 0xFD, 0xBD, 0xD6, 0x65, 0xD1, 0x97, 0x65,
+        0x55, 0x84, 0x40, 0x89, 0x82, 0xB9, 0x61, 0xBA, 0xA3, 0x28, 0x14, 0x00, 0x65, 0x31, 0x2B, 0xAE,
+        0x39, 0xDB, 0xFD, 0x44, 0x80, 0x14, 0x55, 0x56, 0xE5, 0x85, 0x2F, 0x09, 0x81, 0x60, 0x51, 0x8C,
+        0x08, 0x89, 0xED, 0xC4, 0x91, 0x89, 0x00, 0x28, 0x70, 0x1C, 0xAF, 0x5E, 0x69, 0xCA, 0x95, 0x72,
+        0xFF, 0xFD, 0xCD, 0xA9, 0x78, 0x04, 0x01, 0xD3, 0x38, 0x08, 0x00, 0x86, 0x02, 0x60, 0x1A, 0x17,
+        0x03, 0x63, 0x0B, 0xFF, 0xF3, 0x42, 0x44, 0x13, 0x05, 0xAC, 0x2D, 0x32, 0x00, 0xAF, 0x00, 0x00,
+        0x0B, 0x98, 0xB2, 0x9D, 0x81, 0x54, 0xD0, 0x01, 0x61, 0x12, 0x31, 0x18, 0x59, 0x43, 0x60, 0xB1,
+        0xBB, 0x31, 0x7F, 0x0D, 0x73, 0x05, 0x10, 0x1B, 0x16, 0x00, 0xE0, 0x70, 0x06, 0x23, 0xC3, 0xEA,
+        0xE5, 0xBF, 0x66, 0x01, 0x01, 0x7A, 0xCD, 0xCC, 0xDC, 0xC0, 0xBE, 0x47, 0x00, 0x80, 0x00, 0x60,
+        0x37, 0x01, 0xFB, 0x22, 0x01, 0x45, 0xC7, 0x19, 0xF3, 0x43, 0x05, 0xA6, 0xFF, 0xFF, 0xFF, 0xFE,
+        0xD3, 0xCA, 0xE5, 0xEE, 0xC2, 0xC2, 0x18, 0x05, 0x07, 0xB8, 0xEB, 0xD1, 0x28, 0x77, 0x2F, 0x00,
+        0x69, 0xCE, 0xE3, 0x6A, 0xC1, 0xB2, 0xDD, 0x86, 0x46, 0xEA, 0x80, 0x0D, 0xFF, 0xF3, 0x40, 0x44,
+        0x0B, 0x04, 0xFC, 0x53, 0x5E, 0x00, 0xCD, 0x28, 0x00, 0x0A, 0x40, 0xDE, 0xC8, 0x01, 0x98, 0x88,
+        0x00, 0xDC, 0xF3, 0xAA, 0x41, 0x93, 0x99, 0xE0, 0xEC, 0xFB, 0x5B, 0x1B, 0x99, 0x01, 0x61, 0x06,
+        0x22, 0x3B, 0xE6, 0x13, 0x92, 0x7F, 0x25, 0x0E, 0x1D, 0xF0, 0xA8, 0xB3, 0x7F, 0x33, 0xFA, 0x96,
+        0xC5, 0xB5, 0xF8, 0x4A, 0xE7, 0x52, 0x37, 0x5E, 0x1A, 0x29, 0xF4, 0x71, 0xB9, 0xFE, 0xF9, 0xB5,
+        0x7F, 0x65, 0x9A, 0x13, 0x7A, 0xC2, 0x50, 0x88, 0xA0, 0xC1, 0xB3, 0x08, 0xD8, 0xAA, 0x4E, 0xEA,
+        0xFC, 0xC9, 0x61, 0x23, 0xFF, 0x99, 0x34, 0x17, 0xE0, 0x00, 0x1C, 0x0C, 0x4A, 0xC8, 0x80, 0x51,
+        0x62, 0x44, 0x48, 0x91, 0xFF, 0xF3, 0x42, 0x64, 0x0D, 0x05, 0xA0, 0x30, 0xF4, 0x0B, 0xE3, 0x08,
+        0x00, 0x06, 0xB0, 0x95, 0xD8, 0x01, 0xC3, 0x18, 0x01, 0xC3, 0x89, 0x24, 0xE4, 0x74, 0xD4, 0x72,
+        0x92, 0x0A, 0x82, 0xDE, 0x22, 0x3C, 0x0A, 0x8C, 0x3C, 0x0D, 0x15, 0x0D, 0x16, 0x77, 0x86, 0xA7,
+        0x8A, 0xE5, 0xAD, 0xCF, 0x7E, 0x46, 0xEF, 0xFF, 0xED, 0x8C, 0xDA, 0xAA, 0xF1, 0x40, 0x44, 0x90,
+        0x60, 0x21, 0x54, 0x2B, 0x7F, 0xFC, 0x38, 0x04, 0x28, 0xC2, 0x80, 0xAC, 0x0C, 0xAE, 0xFF, 0xD6,
+        0x26, 0x85, 0x36, 0x2E, 0x4C, 0x41, 0x4D, 0x45, 0x33, 0x2E, 0x31, 0x30, 0x30, 0xAA, 0xAA, 0xAA,
+        0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA
+    };
+    unsigned int const stereo22Frames[] = { 0, 182, 286, 391, 495, 600, 704, 809, 913, 1018, 1122, 1227, 1331, 1436, 1540 };
+
+    float const stereo22Reference[ 270 ] =
+    {
+        +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f,
+        +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f,
+        +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f,
+        +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f,
+        +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f,
+        +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f,
+        +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f,
+        +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f, +0.000000f,
+        +0.000000f, +0.000000f, -0.000000f, -0.000000f, -0.000001f, -0.000001f, +0.000006f, -0.000002f,
+        -0.000020f, -0.000046f, +0.000132f, +0.000100f, -0.000874f, -0.000913f, +0.001287f, +0.000273f,
+        +0.002781f, -0.000851f, +0.004875f, -0.000607f, +0.000564f, +0.000786f, +0.004771f, -0.000303f,
+        -0.004743f, -0.004150f, +0.008667f, +0.026633f, +0.298056f, +0.316981f, +0.469567f, +0.074574f,
+        +0.415301f, +0.209020f, +0.166499f, +0.258635f, -0.163340f, -0.248362f, -0.414366f, -0.207829f,
+        -0.470249f, -0.063385f, -0.308410f, -0.324803f, +0.001075f, -0.005975f, +0.308490f, +0.321391f,
+        +0.471684f, +0.071499f, +0.411673f, +0.199482f, +0.162991f, +0.249169f, -0.162334f, -0.250173f,
+        -0.410544f, -0.203862f, -0.467655f, -0.070383f, -0.302959f, -0.318669f, +0.001434f, +0.001789f,
+        +0.305725f, +0.317596f, +0.467736f, +0.069246f, +0.411329f, +0.205450f, +0.162447f, +0.245732f,
+        -0.162470f, -0.245565f, -0.411338f, -0.205731f, -0.467798f, -0.069453f, -0.305273f, -0.317177f,
+        +0.000040f, +0.000048f, +0.305341f, +0.317180f, +0.467852f, +0.069191f, +0.411425f, +0.205771f,
+        +0.162630f, +0.245708f, -0.162416f, -0.245702f, -0.411400f, -0.206005f, -0.467928f, -0.069490f,
+        -0.305405f, -0.317470f, -0.000020f, -0.000021f, +0.305384f, +0.317081f, +0.467877f, +0.069384f,
+        +0.411447f, +0.205786f, +0.162473f, +0.245667f, -0.162472f, -0.245806f, -0.411405f, -0.205550f,
+        -0.467768f, -0.069154f, -0.305296f, -0.317217f, +0.000033f, +0.000197f, +0.305367f, +0.317125f,
+        +0.467814f, +0.069261f, +0.411337f, +0.205517f, +0.162456f, +0.245566f, -0.162437f, -0.245842f,
+        -0.411325f, -0.205636f, -0.467794f, -0.069376f, -0.305345f, -0.317109f, +0.000001f, -0.000048f,
+        +0.305322f, +0.317224f, +0.467775f, +0.069499f, +0.411368f, +0.205691f, +0.162459f, +0.245518f,
+        -0.162460f, -0.245763f, -0.411394f, -0.205819f, -0.467808f, -0.069555f, -0.305328f, -0.317525f,
+        +0.000023f, -0.000111f, +0.305310f, +0.317232f, +0.467820f, +0.069879f, +0.411346f, +0.205605f,
+        +0.162426f, +0.245959f, -0.162427f, -0.245468f, -0.411433f, -0.206475f, -0.467990f, -0.069135f,
+        -0.305588f, -0.317087f, -0.000283f, +0.000358f, +0.305570f, +0.316364f, +0.468116f, +0.071674f,
+        +0.411538f, +0.206855f, +0.162401f, +0.245954f, -0.162559f, -0.246246f, -0.410998f, -0.204749f,
+        -0.467754f, -0.066613f, -0.305446f, -0.317257f, -0.000233f, -0.000020f, +0.305188f, +0.318915f,
+        +0.467546f, +0.068019f, +0.410454f, +0.208477f, +0.166460f, +0.249460f, -0.166488f, -0.239832f,
+        -0.411322f, -0.213382f, -0.455007f, -0.064904f, -0.297353f, -0.301941f
+    };
+    unsigned int const referenceStep = 49;
+
+    struct Fixture
+    {
+        unsigned char const * pBegin;
+        std::size_t           size;
+        unsigned int  const * pFrames; // byte offsets (the first one is the Info header frame)
+        unsigned int          numberOfFrames;
+        unsigned int          channels;
+        unsigned int          sampleRate;
+        unsigned int          length;
+        float         const * pReference;
+
+        Bytes bytes() const { return Bytes( pBegin, pBegin + size ); }
+    };
+
+    Fixture const mono44  { mono44MP3  , sizeof( mono44MP3   ), mono44Frames  , sizeof( mono44Frames   ) / sizeof( unsigned int ), 1, 44100, 11025, mono44Reference   };
+    Fixture const stereo22{ stereo22MP3, sizeof( stereo22MP3 ), stereo22Frames, sizeof( stereo22Frames ) / sizeof( unsigned int ), 2, 22050,  6615, stereo22Reference };
+
+    char const * open( LE::AudioIO::MP3Decoder & decoder, Bytes const & stream ) { return decoder.open( stream.data(), stream.data() + stream.size() ); }
+
+    /// Decodes everything (in uneven chunks) from the current position.
+    std::vector<float> decodeAll( LE::AudioIO::MP3Decoder & decoder )
+    {
+        std::vector<float> samples;
+        float chunk[ 2 * 1333 ];
+        for ( unsigned int frames( 1 ); ; frames = frames * 7 % 1331 + 1 )
+        {
+            unsigned int const framesRead( decoder.read( chunk, frames ) );
+            if ( !framesRead )
+                break;
+            samples.insert( samples.end(), chunk, chunk + framesRead * decoder.numberOfChannels() );
+        }
+        return samples;
+    }
+
+    std::vector<float> decodeAll( Fixture const & fixture )
+    {
+        Bytes const stream( fixture.bytes() );
+        LE::AudioIO::MP3Decoder decoder;
+        open( decoder, stream );
+        return decodeAll( decoder );
+    }
+} // anonymous namespace
+
+@interface MP3DecoderTests : XCTestCase
+@end
+
+@implementation MP3DecoderTests
+
+- (void)testDecodesLikeTheReference
+{
+    for ( Fixture const & fixture : { mono44, stereo22 } )
+    {
+        Bytes const stream( fixture.bytes() );
+        LE::AudioIO::MP3Decoder decoder;
+        XCTAssertTrue( open( decoder, stream ) == nullptr );
+        XCTAssertTrue( decoder.numberOfChannels() == fixture.channels   );
+        XCTAssertTrue( decoder.sampleRate      () == fixture.sampleRate );
+        // The encoder delay and padding are removed: exactly the source length.
+        XCTAssertTrue( decoder.lengthInSamples () == fixture.length     );
+
+        std::vector<float> const samples( decodeAll( decoder ) );
+        XCTAssertTrue( samples.size() == fixture.length * fixture.channels );
+        XCTAssertTrue( decoder.position() == fixture.length );
+        float maximumError( 0 );
+        for ( unsigned int frame( 0 ), reference( 0 ); frame < fixture.length; frame += referenceStep )
+            for ( unsigned int channel( 0 ); channel < fixture.channels; ++channel )
+                maximumError = std::max( maximumError, std::abs( samples[ frame * fixture.channels + channel ] - fixture.pReference[ reference++ ] ) );
+        XCTAssertTrue( maximumError < 1e-4f );
+    }
+}
+
+- (void)testSeeksAreSampleExact
+{
+    for ( Fixture const & fixture : { mono44, stereo22 } )
+    {
+        std::vector<float> const continuous( decodeAll( fixture ) );
+        Bytes const stream( fixture.bytes() );
+        LE::AudioIO::MP3Decoder decoder;
+        XCTAssertTrue( open( decoder, stream ) == nullptr );
+        std::vector<float> samples( 200 * fixture.channels );
+        // Backwards and forwards: the restarted decoding reproduces the
+        // continuous one bit for bit.
+        for ( unsigned int step( 0 ); step < 2 * fixture.length; step += 97 )
+        {
+            unsigned int const target( step < fixture.length ? fixture.length - 1 - step : step - fixture.length );
+            decoder.setSamplePosition( target );
+            XCTAssertTrue( decoder.position() == target );
+            unsigned int const framesRead( decoder.read( &samples[ 0 ], 200 ) );
+            XCTAssertTrue( framesRead == std::min( 200U, fixture.length - target ) );
+            XCTAssertTrue( std::equal( samples.begin(), samples.begin() + framesRead * fixture.channels, continuous.begin() + target * fixture.channels ) );
+            XCTAssertTrue( decoder.position() == target + framesRead );
+        }
+        decoder.setSamplePosition( fixture.length + 5 );
+        XCTAssertTrue( decoder.read( &samples[ 0 ], 200 ) == 0 );
+        decoder.setSamplePosition( 0 );
+        XCTAssertTrue( decodeAll( decoder ) == continuous );
+    }
+}
+
+- (void)testSkipsTagsAndJunk
+{
+    for ( Fixture const & fixture : { mono44, stereo22 } )
+    {
+        // An ID3v2.4 tag (with 128 bytes of padding) in front and junk between
+        // two frames.
+        unsigned char const id3[ 10 ] = { 'I', 'D', '3', 4, 0, 0, 0, 0, 1, 0 };
+        Bytes stream( id3, id3 + sizeof( id3 ) );
+        stream.resize( sizeof( id3 ) + 128 );
+        unsigned int const junkOffset( fixture.pFrames[ 5 ] );
+        stream.insert( stream.end(), fixture.pBegin, fixture.pBegin + junkOffset );
+        stream.insert( stream.end(), 77, 'j' );
+        stream.insert( stream.end(), fixture.pBegin + junkOffset, fixture.pBegin + fixture.size );
+
+        LE::AudioIO::MP3Decoder decoder;
+        XCTAssertTrue( open( decoder, stream ) == nullptr );
+        XCTAssertTrue( decoder.lengthInSamples() == fixture.length );
+        XCTAssertTrue( decodeAll( decoder ) == decodeAll( fixture ) );
+    }
+}
+
+- (void)testTruncatedStreamsDecodeTheirCompleteFrames
+{
+    for ( Fixture const & fixture : { mono44, stereo22 } )
+    {
+        std::vector<float> const complete( decodeAll( fixture ) );
+        for ( unsigned int frame( 2 ); frame < fixture.numberOfFrames; ++frame )
+        {
+            // Cut at, inside the header of and inside the frame.
+            for ( unsigned int const cut : { 0U, 1U, 3U, 30U } )
+            {
+                Bytes const stream( fixture.pBegin, fixture.pBegin + fixture.pFrames[ frame ] + cut );
+                LE::AudioIO::MP3Decoder decoder;
+                XCTAssertTrue( open( decoder, stream ) == nullptr );
+                XCTAssertTrue( decoder.lengthInSamples() < fixture.length );
+                std::vector<float> const samples( decodeAll( decoder ) );
+                XCTAssertTrue( samples.size() == decoder.lengthInSamples() * fixture.channels );
+                XCTAssertTrue( std::equal( samples.begin(), samples.end(), complete.begin() ) );
+            }
+        }
+    }
+}
+
+- (void)testConcealsCorruptMainData
+{
+    // Frame 5's main data is overwritten: the stream keeps its length.
+    Bytes stream( stereo22.bytes() );
+    std::fill( &stream[ stereo22.pFrames[ 5 ] + 4 + 17 ], &stream[ stereo22.pFrames[ 6 ] ], char( 0xFF ) );
+    LE::AudioIO::MP3Decoder decoder;
+    XCTAssertTrue( open( decoder, stream ) == nullptr );
+    std::vector<float> const samples( decodeAll( decoder ) );
+    XCTAssertTrue( samples.size() == stereo22.length * stereo22.channels );
+    bool finite( true );
+    for ( float const sample : samples )
+        finite &= std::isfinite( sample );
+    XCTAssertTrue( finite );
+}
+
+- (void)testRejectsOtherStreams
+{
+    LE::AudioIO::MP3Decoder decoder;
+    // MPEG-1 Layer II, 128 kbps, 44.1 kHz (417 byte frames).
+    Bytes layer2( 3 * 417 );
+    for ( unsigned int frame( 0 ); frame < 3; ++frame )
+    {
+        unsigned char const header[ 4 ] = { 0xFF, 0xFD, 0x90, 0x00 };
+        std::copy( header, header + 4, &layer2[ frame * 417 ] );
+    }
+    char const * pError( open( decoder, layer2 ) );
+    XCTAssertTrue( pError && std::strstr( pError, "Layer III" ) );
+    XCTAssertTrue( !decoder );
+
+    // Free format (bitrate index 0).
+    Bytes freeFormat( layer2 );
+    for ( unsigned int frame( 0 ); frame < 3; ++frame )
+    {
+        freeFormat[ frame * 417 + 1 ] = char( 0xFB );
+        freeFormat[ frame * 417 + 2 ] = 0x00;
+    }
+    pError = open( decoder, freeFormat );
+    XCTAssertTrue( pError && std::strstr( pError, "free format" ) );
+
+    XCTAssertTrue( open( decoder, Bytes( 1000, 0 ) ) != nullptr );
+    XCTAssertTrue( open( decoder, Bytes( mono44.pBegin, mono44.pBegin + 100 ) ) != nullptr );
+    XCTAssertTrue( !decoder );
+}
+
+@end
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file decoderBenchmark.cpp
+/// --------------------------
+///
+/// Decoding throughput of PortableFile (the header only WAVE, FLAC and MP3
+/// decoders) against File (the OS decoders).
+///
+/// Usage:
+///     decoderBenchmark <audio file> [more audio files]
+///
+/// (relative paths are resolved against the current working directory). The
+/// prebuilt SDK libraries are iOS only so the tool is built for and run in the
+/// iOS Simulator, see benchmark/Makefile (which also converts the demo's MP3
+/// samples to WAVE and FLAC with afconvert).
+///
+/// Every file is opened and read to the end (in blockSize sample frame reads)
+/// with each decoder, alternating between the two, until each has been timed
+/// for at least minimumRuns runs and minimumSeconds (or until maximumRuns runs
+/// have been made). The fastest run of each is reported (as decoded sample
+/// frames per second and real time factor) together with the open() time, the
+/// reported and the actually read length and the PortableFile/File throughput
+/// ratio, as JSON to stdout.
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "signals.hpp"
+
+#include "le/audioio/file.hpp"
+#include "le/audioio/portableFile.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace
+{
+//------------------------------------------------------------------------------
+
+using namespace LE;
+using namespace Benchmark;
+
+unsigned int const blockSize      = 4096;
+unsigned int const minimumRuns    = 5   ;
+unsigned int const maximumRuns    = 1000; // (for files too short to reach minimumSeconds)
+double       const minimumSeconds = 2   ; // of timed decoding per decoder and file
+
+typedef std::chrono::steady_clock Clock;
+
+struct Result
+{
+    unsigned int runs                  ;
+    unsigned int reportedLength        ; ///< lengthInSamples() after open()
+    unsigned int decodedLength         ; ///< sample frames actually read
+    unsigned int sampleRate            ;
+    unsigned int numberOfChannels      ;
+    double       openMilliseconds      ; ///< fastest
+    double       megaFramesPerSecond   ; ///< fastest run
+    double       realTimeFactor        ;
+    double       totalSeconds          ; ///< of timed decoding
+}; // struct Result
+
+
+/// <B>Effect:</B> Opens and decodes the whole file once, accumulating the
+/// timings into <VAR>result</VAR>.<BR>
+template <class Decoder>
+char const * run( char const * const path, Signal & buffer, Result & result )
+{
+    Decoder decoder;
+    Clock::time_point const openStart( Clock::now() );
+    if ( char const * const pError = decoder.template open<Utility::AbsolutePath>( path ) )
+        return pError;
+    Clock::time_point const readStart( Clock::now() );
+    unsigned int const channels( decoder.numberOfChannels() );
+    buffer.resize( std::size_t( blockSize ) * channels );
+    unsigned int frames( 0 );
+    while ( unsigned int const framesRead = decoder.read( buffer.data(), blockSize ) )
+        frames += framesRead;
+    Clock::time_point const readEnd( Clock::now() );
+
+    double const openSeconds( std::chrono::duration<double>( readStart - openStart ).count() );
+    double const readSeconds( std::chrono::duration<double>( readEnd   - readStart ).count() );
+    double const framesPerSecond( frames / std::max( readSeconds, 1e-9 ) );
+    if ( !result.runs++ )
+    {
+        result.reportedLength   = decoder.lengthInSamples();
+        result.decodedLength    = frames;
+        result.sampleRate       = decoder.sampleRate();
+        result.numberOfChannels = channels;
+        result.openMilliseconds = openSeconds * 1000;
+    }
+    result.openMilliseconds    = std::min( result.openMilliseconds   , openSeconds * 1000     );
+    result.megaFramesPerSecond = std::max( result.megaFramesPerSecond, framesPerSecond / 1e6  );
+    result.realTimeFactor      = result.megaFramesPerSecond * 1e6 / std::max( result.sampleRate, 1U );
+    result.totalSeconds       += readSeconds;
+    return nullptr;
+}
+
+
+void print( char const * const name, Result const & result )
+{
+    std::printf
+    (
+        "\"%s\": { \"runs\": %u, \"channels\": %u, \"sampleRate\": %u, \"reportedLength\": %u, \"decodedLength\": %u, \"openMilliseconds\": %.3f, \"megaFramesPerSecond\": %.2f, \"realTimeFactor\": %.0f }",
+        name, result.runs, result.numberOfChannels, result.sampleRate, result.reportedLength, result.decodedLength, result.openMilliseconds, result.megaFramesPerSecond, result.realTimeFactor
+    );
+}
+
+//------------------------------------------------------------------------------
+} // anonymous namespace
+//------------------------------------------------------------------------------
+
+int main( int const argc, char const * const argv[] )
+{
+    if ( argc < 2 )
+    {
+        std::fprintf( stderr, "Usage: %s <audio file> [more audio files]\n", argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    Signal buffer;
+    std::printf( "{\n  \"blockSize\": %u,\n  \"results\": [", blockSize );
+    for ( int argument( 1 ); argument < argc; ++argument )
+    {
+        std::string const path( absolutePath( argv[ argument ] ) );
+        std::fprintf( stderr, "%s...\n", argv[ argument ] );
+        Result file     = Result();
+        Result portable = Result();
+        // Alternating (so that both see the same thermal/cache conditions).
+        while
+        (
+            ( file    .runs < minimumRuns || file    .totalSeconds < minimumSeconds ||
+              portable.runs < minimumRuns || portable.totalSeconds < minimumSeconds ) && file.runs < maximumRuns
+        )
+        {
+            char const * pError( run<AudioIO::File>( path.c_str(), buffer, file ) );
+            if ( !pError )
+                pError = run<AudioIO::PortableFile>( path.c_str(), buffer, portable );
+            if ( pError )
+            {
+                std::fprintf( stderr, "Failed to decode %s (%s).\n", argv[ argument ], pError );
+                return EXIT_FAILURE;
+            }
+        }
+        std::printf( "%s\n    { \"path\": \"%s\", ", argument > 1 ? "," : "", argv[ argument ] );
+        print( "file", file );
+        std::printf( ", " );
+        print( "portableFile", portable );
+        std::printf( ", \"portableToFileThroughput\": %.2f }", portable.megaFramesPerSecond / file.megaFramesPerSecond );
+    }
+    std::printf( "\n  ]\n}\n" );
+    return EXIT_SUCCESS;
+}
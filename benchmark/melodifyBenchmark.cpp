@@ -0,0 +1,236 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file melodifyBenchmark.cpp
+/// ---------------------------
+///
+/// Headless Melodifyer throughput benchmark.
+///
+/// Usage:
+///     melodifyBenchmark <melody.mid> [seconds per run] [voice file] [background file]
+///
+/// (relative paths are resolved against the current working directory). The
+/// prebuilt SDK libraries are iOS only so the benchmark is built for and run
+/// in the iOS Simulator, see benchmark/Makefile.
+///
+/// Sweeps block sizes (32 - 65536), mono/stereo, 22.05/44.1/48 kHz and
+/// with/without background and prints the results as JSON to stdout (progress
+/// and errors go to stderr). Every configuration is timed for at least the
+/// given number of seconds of audio and at least 1000 process() calls (the
+/// input is looped, see minimumCalls) unless a single configuration takes more
+/// than maximumWallSeconds. Each result reports its number of timed calls and
+/// a latency percentile is reported (as null otherwise) only if at least 10
+/// calls lie above it. Without input files synthetic signals are used.
+/// Sample file inputs are downmixed to mono and then reused (looped) for every
+/// configuration: only the sample values, not the nominal file sample rate,
+/// matter for throughput.
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "signals.hpp"
+
+#include "le/melodify/compiledMelody.hpp"
+#include "le/melodify/melodifyer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace
+{
+//------------------------------------------------------------------------------
+
+using namespace LE;
+using namespace Benchmark;
+
+struct Configuration
+{
+    unsigned int sampleRate      ;
+    unsigned int numberOfChannels;
+    unsigned int blockSize       ;
+    bool         background      ;
+}; // struct Configuration
+
+struct Result
+{
+    unsigned int calls               ;
+    double       kiloSamplesPerSecond;
+    double       realTimeFactor      ;
+    double       p50Microseconds     ; ///< negative if unreliable (see percentile())
+    double       p90Microseconds     ;
+    double       p99Microseconds     ;
+    double       maxMicroseconds     ;
+}; // struct Result
+
+
+unsigned int const minimumCalls       = 1000   ; // timed process() calls per configuration
+unsigned int const minimumCallsAbove  = 10     ; // calls above a percentile for it to be reported
+double       const maximumWallSeconds = 30     ; // per configuration (may cut minimumCalls short)
+unsigned int const maximumInputFrames = 1 << 20; // looped input length cap (sample frames)
+
+/// \return The given percentile of the sorted samples or a negative value if
+/// too few samples lie above it to tell it apart from the maximum.
+double percentile( std::vector<double> const & sorted, double const fraction )
+{
+    if ( sorted.size() * ( 1 - fraction ) < minimumCallsAbove )
+        return -1;
+    std::size_t const index( std::min( sorted.size() - 1, static_cast<std::size_t>( fraction * ( sorted.size() - 1 ) + 0.5 ) ) );
+    return sorted[ index ];
+}
+
+
+/// Prints a percentile as a JSON number or null (see percentile()).
+void printPercentile( char const * const name, double const microseconds )
+{
+    if ( microseconds < 0 )
+        std::printf( "\"%s\": null", name );
+    else
+        std::printf( "\"%s\": %.2f", name, microseconds );
+}
+
+
+char const * run
+(
+    Configuration      const & configuration   ,
+    SW::CompiledMelody const & melody          ,
+    Signal             const & voiceSource     ,
+    Signal             const & backgroundSource,
+    float              const   seconds         ,
+    Result                   & result
+)
+{
+    SW::Melodifyer melodifyer;
+    if ( !melodifyer.setup( configuration.sampleRate, configuration.numberOfChannels ) )
+        return "Out of memory.";
+    if ( char const * const pError = melody.attachTo( melodifyer ) )
+        return pError;
+
+    unsigned int const blockSize      ( configuration.blockSize                                                        );
+    unsigned int const channels       ( configuration.numberOfChannels                                                 );
+    unsigned int const requestedBlocks( static_cast<unsigned int>( seconds * configuration.sampleRate ) / blockSize    );
+    unsigned int const numberOfBlocks ( std::max( minimumCalls, requestedBlocks )                                      );
+    // The input is looped so its length (unlike the timed duration) is capped.
+    unsigned int const inputBlocks    ( std::max( 1U, std::min( numberOfBlocks, maximumInputFrames / blockSize ) )     );
+    unsigned int const inputFrames    ( inputBlocks * blockSize                                                        );
+
+    Signal voice     ( std::size_t( inputFrames ) * channels );
+    Signal background( configuration.background ? std::size_t( inputFrames ) * channels : 0 );
+    Signal output    ( blockSize * channels );
+    fill( voice, voiceSource, channels, configuration.sampleRate, 180 );
+    if ( configuration.background )
+        fill( background, backgroundSource, channels, configuration.sampleRate, 110 );
+
+    auto const process = [ & ]( unsigned int const block )
+    {
+        std::size_t const offset( static_cast<std::size_t>( block % inputBlocks ) * blockSize * channels );
+        melodifyer.process
+        (
+            &voice[ offset ],
+            configuration.background ? &background[ offset ] : nullptr,
+            output.data(),
+            blockSize
+        );
+    };
+
+    // Warm up (caches, lazy initialization inside the SDK and the latency
+    // fill) on the very same stream that is then timed (no reset()): at least
+    // the latency plus a few blocks.
+    unsigned int const warmUpBlocks( ( melodifyer.latencyInSamples() + blockSize - 1 ) / blockSize + 4 );
+    for ( unsigned int block( 0 ); block < warmUpBlocks; ++block )
+        process( block );
+
+    typedef std::chrono::steady_clock Clock;
+    std::vector<double> callMicroseconds;
+    callMicroseconds.reserve( numberOfBlocks );
+    Clock::time_point const start( Clock::now() );
+    for ( unsigned int block( 0 ); block < numberOfBlocks; ++block )
+    {
+        Clock::time_point const callStart( Clock::now() );
+        process( warmUpBlocks + block );
+        Clock::time_point const callEnd( Clock::now() );
+        callMicroseconds.push_back( std::chrono::duration<double, std::micro>( callEnd - callStart ).count() );
+        if ( block + 1 >= requestedBlocks && std::chrono::duration<double>( callEnd - start ).count() > maximumWallSeconds )
+            break;
+    }
+    double const elapsedSeconds( std::chrono::duration<double>( Clock::now() - start ).count() );
+    unsigned int const calls         ( static_cast<unsigned int>( callMicroseconds.size() ) );
+    double       const numberOfFrames( double( calls ) * blockSize                          );
+
+    std::sort( callMicroseconds.begin(), callMicroseconds.end() );
+    result.calls                = calls;
+    result.kiloSamplesPerSecond = numberOfFrames * channels / elapsedSeconds / 1000;
+    result.realTimeFactor       = numberOfFrames / configuration.sampleRate / elapsedSeconds;
+    result.p50Microseconds      = percentile( callMicroseconds, 0.50 );
+    result.p90Microseconds      = percentile( callMicroseconds, 0.90 );
+    result.p99Microseconds      = percentile( callMicroseconds, 0.99 );
+    result.maxMicroseconds      = callMicroseconds.back();
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+} // anonymous namespace
+//------------------------------------------------------------------------------
+
+int main( int const argc, char const * const argv[] )
+{
+    if ( argc < 2 || argc > 5 )
+    {
+        std::fprintf( stderr, "Usage: %s <melody.mid> [seconds per run] [voice file] [background file]\n", argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    unsigned int const melodyTrack  ( 1 );
+    unsigned int const melodyChannel( 0 );
+    SW::CompiledMelody::Ptr pMelody;
+    if ( char const * const pError = SW::CompiledMelody::create<Utility::AbsolutePath>( absolutePath( argv[ 1 ] ).c_str(), melodyTrack, melodyChannel, pMelody ) )
+    {
+        std::fprintf( stderr, "Failed to load %s (%s).\n", argv[ 1 ], pError );
+        return EXIT_FAILURE;
+    }
+
+    float  const seconds         ( argc > 2 ? static_cast<float>( std::atof( argv[ 2 ] ) ) : 10.0f );
+    Signal const voiceSource     ( argc > 3 ? loadMono( argv[ 3 ] ) : Signal() );
+    Signal const backgroundSource( argc > 4 ? loadMono( argv[ 4 ] ) : Signal() );
+    if ( !( seconds > 0 ) || ( argc > 3 && voiceSource.empty() ) || ( argc > 4 && backgroundSource.empty() ) )
+        return EXIT_FAILURE;
+
+    static unsigned int const sampleRates     [] = { 22050, 44100, 48000 };
+    static unsigned int const channelCounts   [] = { 1, 2 };
+    static unsigned int const minimumBlockSize   = 32;
+    static unsigned int const maximumBlockSize   = 65536;
+
+    std::printf( "{\n  \"input\": \"%s\",\n  \"secondsPerRun\": %g,\n  \"minimumCalls\": %u,\n  \"results\": [", argc > 3 ? "file" : "synthetic", seconds, minimumCalls );
+    bool first( true );
+    for ( unsigned int const sampleRate : sampleRates )
+    for ( unsigned int const channels : channelCounts )
+    for ( unsigned int background( 0 ); background < 2; ++background )
+    for ( unsigned int blockSize( minimumBlockSize ); blockSize <= maximumBlockSize; blockSize *= 2 )
+    {
+        Configuration const configuration = { sampleRate, channels, blockSize, background != 0 };
+        std::fprintf( stderr, "%u Hz, %u channel(s), block %u, %s background...\n", sampleRate, channels, blockSize, background ? "with" : "without" );
+        Result result;
+        if ( char const * const pError = run( configuration, *pMelody, voiceSource, backgroundSource, seconds, result ) )
+        {
+            std::fprintf( stderr, "Benchmark run failed (%s).\n", pError );
+            return EXIT_FAILURE;
+        }
+        std::printf
+        (
+            "%s\n    { \"sampleRate\": %u, \"channels\": %u, \"blockSize\": %u, \"background\": %s, \"calls\": %u, "
+            "\"kiloSamplesPerSecond\": %.1f, \"realTimeFactor\": %.2f, \"callMicroseconds\": { ",
+            first ? "" : ",",
+            sampleRate, channels, blockSize, background ? "true" : "false", result.calls,
+            result.kiloSamplesPerSecond, result.realTimeFactor
+        );
+        printPercentile( "p50", result.p50Microseconds ); std::printf( ", " );
+        printPercentile( "p90", result.p90Microseconds ); std::printf( ", " );
+        printPercentile( "p99", result.p99Microseconds );
+        std::printf( ", \"max\": %.2f } }", result.maxMicroseconds );
+        first = false;
+    }
+    std::printf( "\n  ]\n}\n" );
+    return EXIT_SUCCESS;
+}
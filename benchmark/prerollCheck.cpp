@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file prerollCheck.cpp
+/// ----------------------
+///
+/// Measures how closely a seek()/primeAt() restarted Melodifyer reproduces a
+/// continuous render, i.e. what recommendedPreRollInSamples() should be.
+///
+/// Usage:
+///     prerollCheck <melody.mid> [voice file] [background file]
+///
+/// (relative paths are resolved against the current working directory). The
+/// prebuilt SDK libraries are iOS only so the tool is built for and run in the
+/// iOS Simulator, see benchmark/Makefile.
+///
+/// For each sample rate/channel count the voice (+ background) is rendered
+/// once from the start and then, for a number of restart positions and
+/// pre-roll lengths (multiples of the latency), again with primeAt() from
+/// each position. The restarted output from the position on (everything the
+/// caller would keep) is compared with the continuous render over
+/// comparedSeconds and the worst (over the positions) residual energy
+/// relative to the reference, in dB, and maximum absolute difference are
+/// printed as JSON to stdout. Finally the shortest tested pre-roll whose
+/// residual stays below settledResidualDB (for it and all longer ones, in
+/// every configuration) is reported, to be compared with the per
+/// configuration recommendedPreRollInSamples(). Without input files synthetic
+/// signals are used.
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "signals.hpp"
+
+#include "le/melodify/melodifyer.hpp"
+#include "le/melodify/midiMelody.hpp"
+#include "le/melodify/timeline.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace
+{
+//------------------------------------------------------------------------------
+
+using namespace LE;
+using namespace Benchmark;
+
+unsigned int const blockSize          = 512  ;
+float        const signalSeconds      = 30   ;
+float        const comparedSeconds    = 1    ;
+unsigned int const numberOfPositions  = 8    ;
+double       const settledResidualDB  = -80  ; // "indistinguishable from the continuous render"
+double       const residualFloorDB    = -200 ; // reported for bit exact restarts
+
+/// Tested pre-roll lengths (in multiples of the latency).
+float const preRollLatencies[] = { 0.5f, 1, 2, 4, 8, 16 };
+unsigned int const numberOfPreRolls( sizeof( preRollLatencies ) / sizeof( preRollLatencies[ 0 ] ) );
+
+struct Residual
+{
+    double decibels   ; ///< error energy relative to the reference energy
+    double maxAbsolute;
+}; // struct Residual
+
+
+void render( SW::Melodifyer & melodifyer, Signal const & voice, Signal const & background, unsigned int const numberOfChannels, unsigned int const begin, unsigned int const end, float * const pOutput )
+{
+    for ( unsigned int frame( begin ); frame < end; frame += blockSize )
+    {
+        unsigned int const frames( std::min( blockSize, end - frame ) );
+        std::size_t  const offset( std::size_t( frame ) * numberOfChannels );
+        melodifyer.process( &voice[ offset ], background.empty() ? nullptr : &background[ offset ], &pOutput[ ( frame - begin ) * numberOfChannels ], frames );
+    }
+}
+
+
+char const * run
+(
+    SW::MIDIMelody const & melody          ,
+    unsigned int   const   sampleRate      ,
+    unsigned int   const   numberOfChannels,
+    Signal         const & voiceSource     ,
+    Signal         const & backgroundSource,
+    unsigned int         & latency         ,
+    unsigned int         & recommended     ,
+    Residual               (&residuals)[ numberOfPreRolls ]
+)
+{
+    unsigned int const frames        ( static_cast<unsigned int>( signalSeconds   * sampleRate ) );
+    unsigned int const comparedFrames( static_cast<unsigned int>( comparedSeconds * sampleRate ) );
+    Signal voice     ( std::size_t( frames ) * numberOfChannels );
+    Signal background( voice.size() );
+    fill( voice     , voiceSource     , numberOfChannels, sampleRate, 180 );
+    fill( background, backgroundSource, numberOfChannels, sampleRate, 110 );
+
+    SW::Melodifyer continuous;
+    if ( !continuous.setup( sampleRate, numberOfChannels ) )
+        return "Out of memory.";
+    if ( char const * const pError = SW::setMelody( continuous, melody ) )
+        return pError;
+    latency     = continuous.latencyInSamples();
+    recommended = SW::recommendedPreRollInSamples( continuous );
+    Signal reference( voice.size() );
+    render( continuous, voice, background, numberOfChannels, 0, frames, reference.data() );
+
+    SW::Melodifyer restarted;
+    if ( !restarted.setup( sampleRate, numberOfChannels ) )
+        return "Out of memory.";
+    Signal output( std::size_t( comparedFrames ) * numberOfChannels );
+    for ( unsigned int preRollIndex( 0 ); preRollIndex < numberOfPreRolls; ++preRollIndex )
+    {
+        unsigned int const preRoll( static_cast<unsigned int>( preRollLatencies[ preRollIndex ] * latency ) );
+        Residual & worst( residuals[ preRollIndex ] );
+        worst.decibels    = residualFloorDB;
+        worst.maxAbsolute = 0;
+        for ( unsigned int positionIndex( 0 ); positionIndex < numberOfPositions; ++positionIndex )
+        {
+            // Spread over the signal, clear of its start (so the whole pre-roll
+            // fits) and off the block grid of the continuous render.
+            unsigned int const position( preRoll + 977 + ( frames - preRoll - comparedFrames - 977 ) / numberOfPositions * positionIndex );
+            if ( char const * const pError = SW::primeAt( restarted, melody, sampleRate, numberOfChannels, voice.data(), background.data(), position, preRoll ) )
+                return pError;
+            render( restarted, voice, background, numberOfChannels, position, position + comparedFrames, output.data() );
+
+            double errorEnergy( 0 ), referenceEnergy( 0 ), maxAbsolute( 0 );
+            for ( std::size_t sample( 0 ); sample < output.size(); ++sample )
+            {
+                double const expected( reference[ std::size_t( position ) * numberOfChannels + sample ] );
+                double const error   ( output[ sample ] - expected                                        );
+                errorEnergy     += error    * error   ;
+                referenceEnergy += expected * expected;
+                maxAbsolute      = std::max( maxAbsolute, std::abs( error ) );
+            }
+            double const decibels( errorEnergy ? 10 * std::log10( errorEnergy / std::max( referenceEnergy, 1e-30 ) ) : residualFloorDB );
+            worst.decibels    = std::max( worst.decibels   , std::max( decibels, residualFloorDB ) );
+            worst.maxAbsolute = std::max( worst.maxAbsolute, maxAbsolute                           );
+        }
+    }
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+} // anonymous namespace
+//------------------------------------------------------------------------------
+
+int main( int const argc, char const * const argv[] )
+{
+    if ( argc < 2 || argc > 4 )
+    {
+        std::fprintf( stderr, "Usage: %s <melody.mid> [voice file] [background file]\n", argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    SW::MIDIMelody melody;
+    if ( char const * const pError = melody.load<Utility::AbsolutePath>( absolutePath( argv[ 1 ] ).c_str(), 1, 0 ) )
+    {
+        std::fprintf( stderr, "Failed to load %s (%s).\n", argv[ 1 ], pError );
+        return EXIT_FAILURE;
+    }
+    Signal const voiceSource     ( argc > 2 ? loadMono( argv[ 2 ] ) : Signal() );
+    Signal const backgroundSource( argc > 3 ? loadMono( argv[ 3 ] ) : Signal() );
+    if ( ( argc > 2 && voiceSource.empty() ) || ( argc > 3 && backgroundSource.empty() ) )
+        return EXIT_FAILURE;
+
+    static unsigned int const sampleRates  [] = { 22050, 44100, 48000 };
+    static unsigned int const channelCounts[] = { 1, 2 };
+
+    std::printf( "{\n  \"input\": \"%s\",\n  \"positions\": %u,\n  \"comparedSeconds\": %g,\n  \"settledResidualDB\": %g,\n  \"results\": [", argc > 2 ? "file" : "synthetic", numberOfPositions, comparedSeconds, settledResidualDB );
+    bool  first( true );
+    float settledLatencies( 0 ); // the longest pre-roll needed by any configuration
+    bool  settledEverywhere( true );
+    for ( unsigned int const sampleRate : sampleRates   )
+    for ( unsigned int const channels   : channelCounts )
+    {
+        std::fprintf( stderr, "%u Hz, %u channel(s)...\n", sampleRate, channels );
+        unsigned int latency, recommended;
+        Residual residuals[ numberOfPreRolls ];
+        if ( char const * const pError = run( melody, sampleRate, channels, voiceSource, backgroundSource, latency, recommended, residuals ) )
+        {
+            std::fprintf( stderr, "Check failed (%s).\n", pError );
+            return EXIT_FAILURE;
+        }
+        std::printf( "%s\n    { \"sampleRate\": %u, \"channels\": %u, \"latency\": %u, \"recommendedPreRoll\": %u, \"preRolls\": [", first ? "" : ",", sampleRate, channels, latency, recommended );
+        float settled( 0 );
+        for ( unsigned int preRoll( 0 ); preRoll < numberOfPreRolls; ++preRoll )
+        {
+            std::printf
+            (
+                "%s\n      { \"latencies\": %g, \"samples\": %u, \"residualDB\": %.1f, \"maxAbsoluteError\": %.3g }",
+                preRoll ? "," : "",
+                preRollLatencies[ preRoll ], static_cast<unsigned int>( preRollLatencies[ preRoll ] * latency ),
+                residuals[ preRoll ].decibels, residuals[ preRoll ].maxAbsolute
+            );
+            // The shortest pre-roll from which on all longer ones settle too.
+            if ( residuals[ preRoll ].decibels > settledResidualDB )
+                settled = 0;
+            else if ( !settled )
+                settled = preRollLatencies[ preRoll ];
+        }
+        std::printf( " ] }" );
+        settledEverywhere = settledEverywhere && settled;
+        settledLatencies  = std::max( settledLatencies, settled );
+        first = false;
+    }
+    std::printf( "\n  ],\n  \"settledPreRollInLatencies\": " );
+    if ( settledEverywhere )
+        std::printf( "%g\n}\n", settledLatencies );
+    else
+        std::printf( "null\n}\n" );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file signals.hpp
+/// -----------------
+///
+/// Test signal helpers shared by the benchmark tools.
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef signals_hpp__6D2E8B41_93C7_4F0A_B5E1_2A7C9F3D8E56
+#define signals_hpp__6D2E8B41_93C7_4F0A_B5E1_2A7C9F3D8E56
+#pragma once
+//------------------------------------------------------------------------------
+#include "le/audioio/file.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+//------------------------------------------------------------------------------
+namespace Benchmark
+{
+//------------------------------------------------------------------------------
+
+typedef std::vector<float> Signal;
+
+/// Resolves a command line path against the current working directory (the
+/// SDK only takes absolute paths, see Utility::AbsolutePath).
+inline std::string absolutePath( char const * const path )
+{
+    if ( path[ 0 ] == '/' )
+        return path;
+    char workingDirectory[ 4096 ];
+    if ( !::getcwd( workingDirectory, sizeof( workingDirectory ) ) )
+        return path;
+    return std::string( workingDirectory ) + '/' + path;
+}
+
+
+/// Reads a whole audio file downmixed to mono (an empty signal on failure).
+inline Signal loadMono( char const * const fileName )
+{
+    Signal signal;
+    LE::AudioIO::File file;
+    if ( char const * const pError = file.open<LE::Utility::AbsolutePath>( absolutePath( fileName ).c_str() ) )
+    {
+        std::fprintf( stderr, "Failed to open %s (%s).\n", fileName, pError );
+        return signal;
+    }
+    unsigned int const channels( file.numberOfChannels() );
+    Signal interleaved( file.lengthInSamples() * channels );
+    unsigned int const frames( file.read( interleaved.data(), file.lengthInSamples() ) );
+    signal.resize( frames );
+    for ( unsigned int frame( 0 ); frame < frames; ++frame )
+    {
+        float sum( 0 );
+        for ( unsigned int channel( 0 ); channel < channels; ++channel )
+            sum += interleaved[ frame * channels + channel ];
+        signal[ frame ] = sum / channels;
+    }
+    return signal;
+}
+
+
+/// Fills an interleaved buffer either by looping the given mono source or,
+/// for an empty source, with a synthetic voice-like signal (a gliding,
+/// amplitude modulated harmonic tone).
+inline void fill( Signal & buffer, Signal const & source, unsigned int const numberOfChannels, unsigned int const sampleRate, float const baseFrequency )
+{
+    unsigned int const frames( static_cast<unsigned int>( buffer.size() / numberOfChannels ) );
+    float const twoPi( 6.2831853f );
+    double phase( 0 );
+    for ( unsigned int frame( 0 ); frame < frames; ++frame )
+    {
+        float value;
+        if ( !source.empty() )
+        {
+            value = source[ frame % source.size() ];
+        }
+        else
+        {
+            float const t        ( static_cast<float>( frame ) / sampleRate                        );
+            float const frequency( baseFrequency * ( 1 + 0.25f * std::sin( twoPi * 0.3f * t ) )     );
+            float const envelope ( 0.5f + 0.5f * std::sin( twoPi * 3 * t )                          );
+            phase += twoPi * frequency / sampleRate;
+            value = 0.3f * envelope * ( std::sin( phase ) + 0.5f * std::sin( 2 * phase ) + 0.25f * std::sin( 3 * phase ) );
+        }
+        for ( unsigned int channel( 0 ); channel < numberOfChannels; ++channel )
+            buffer[ frame * numberOfChannels + channel ] = value;
+    }
+}
+
+//------------------------------------------------------------------------------
+} // namespace Benchmark
+//------------------------------------------------------------------------------
+#endif // signals_hpp
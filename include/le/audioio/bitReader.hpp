@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file bitReader.hpp
+/// -------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef bitReader_hpp__5C3A9E07_1B6D_4F28_A4E9_7D0B2C8F6E31
+#define bitReader_hpp__5C3A9E07_1B6D_4F28_A4E9_7D0B2C8F6E31
+#pragma once
+//------------------------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif // _MSC_VER
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace AudioIO
+{
+//------------------------------------------------------------------------------
+
+namespace Detail
+{
+    ////////////////////////////////////////////////////////////////////////////
+    // MSB first bit reader over a byte range (missing bits read as zeros and
+    // set the overrun flag).
+    ////////////////////////////////////////////////////////////////////////////
+
+    class BitReader
+    {
+    public:
+        BitReader() { reset( nullptr, nullptr ); }
+
+        void reset( unsigned char const * const pBegin, unsigned char const * const pEnd )
+        {
+            pBegin_  = pBegin;
+            p_       = pBegin;
+            pEnd_    = pEnd;
+            cache_   = 0;
+            bits_    = 0;
+            overrun_ = false;
+        }
+
+        std::uint32_t read( unsigned int const numberOfBits ) // <= 32
+        {
+            if ( !numberOfBits )
+                return 0;
+            if ( bits_ < numberOfBits )
+            {
+                refill();
+                if ( bits_ < numberOfBits )
+                {
+                    overrun_ = true;
+                    bits_    = numberOfBits;
+                }
+            }
+            std::uint32_t const value( static_cast<std::uint32_t>( cache_ >> ( 64 - numberOfBits ) ) );
+            cache_ <<= numberOfBits;
+            bits_   -= numberOfBits;
+            return value;
+        }
+
+        /// \return The next <VAR>numberOfBits</VAR> (<= 32) bits without
+        /// consuming them (missing bits read as zeros).
+        std::uint32_t peek( unsigned int const numberOfBits )
+        {
+            if ( bits_ < numberOfBits )
+                refill();
+            return static_cast<std::uint32_t>( cache_ >> ( 64 - numberOfBits ) );
+        }
+
+        /// <B>Effect:</B> Consumes bits (at most as many as the last peek()
+        /// covered).<BR>
+        void skip( unsigned int const numberOfBits )
+        {
+            if ( bits_ < numberOfBits )
+            {
+                overrun_ = true;
+                bits_    = numberOfBits;
+            }
+            cache_ <<= numberOfBits;
+            bits_   -= numberOfBits;
+        }
+
+        std::int32_t readSigned( unsigned int const numberOfBits )
+        {
+            if ( !numberOfBits )
+                return 0;
+            unsigned int const shift( 32 - numberOfBits );
+            return static_cast<std::int32_t>( read( numberOfBits ) << shift ) >> shift;
+        }
+
+        /// \return The number of zero bits before the next one bit.
+        std::uint32_t readUnary()
+        {
+            std::uint32_t count( 0 );
+            for ( ; ; )
+            {
+                if ( cache_ )
+                {
+                    // Bits past bits_ are always zero so the leading one is valid.
+                    unsigned int const zeros( countLeadingZeros( cache_ ) );
+                    count  += zeros;
+                    cache_ <<= zeros;
+                    cache_ <<= 1;
+                    bits_   -= zeros + 1;
+                    return count;
+                }
+                count += bits_;
+                bits_  = 0;
+                refill();
+                if ( !bits_ )
+                {
+                    overrun_ = true;
+                    return count;
+                }
+            }
+        }
+
+        /// <B>Effect:</B> Reads a Rice coded (zigzag) signed value.<BR>
+        std::int32_t readRice( unsigned int const parameter )
+        {
+            std::uint32_t const value( ( readUnary() << parameter ) | read( parameter ) );
+            return static_cast<std::int32_t>( value >> 1 ) ^ -static_cast<std::int32_t>( value & 1 );
+        }
+
+        void alignToByte()
+        {
+            unsigned int const partial( bits_ & 7 );
+            cache_ <<= partial;
+            bits_   -= partial;
+        }
+
+        /// \return The position of the next (byte aligned) byte.
+        unsigned char const * bytePosition() const { return p_ - bits_ / 8; }
+
+        /// \return The number of bits consumed since reset().
+        std::size_t bitPosition() const { return static_cast<std::size_t>( p_ - pBegin_ ) * 8 - bits_; }
+
+        bool overrun() const { return overrun_; }
+
+    private:
+        void refill()
+        {
+            while ( bits_ <= 56 && p_ != pEnd_ )
+            {
+                cache_ |= static_cast<std::uint64_t>( *p_++ ) << ( 56 - bits_ );
+                bits_  += 8;
+            }
+        }
+
+        static unsigned int countLeadingZeros( std::uint64_t const value )
+        {
+        #if defined( _MSC_VER ) && defined( _WIN64 )
+            unsigned long index;
+            _BitScanReverse64( &index, value );
+            return 63 - index;
+        #elif defined( _MSC_VER )
+            unsigned long index;
+            if ( _BitScanReverse( &index, static_cast<unsigned long>( value >> 32 ) ) )
+                return 31 - index;
+            _BitScanReverse( &index, static_cast<unsigned long>( value ) );
+            return 63 - index;
+        #else
+            return static_cast<unsigned int>( __builtin_clzll( value ) );
+        #endif // _MSC_VER
+        }
+
+    private:
+        unsigned char const * pBegin_ ;
+        unsigned char const * p_      ;
+        unsigned char const * pEnd_   ;
+        std::uint64_t         cache_  ; // MSB aligned
+        unsigned int          bits_   ; // valid bits in cache_
+        bool                  overrun_;
+    }; // class BitReader
+} // namespace Detail
+
+//------------------------------------------------------------------------------
+} // namespace AudioIO
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // bitReader_hpp
@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file decodedAudioCache.hpp
+/// ---------------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef decodedAudioCache_hpp__0591D478_7A31_493D_8C09_101C9383721B
+#define decodedAudioCache_hpp__0591D478_7A31_493D_8C09_101C9383721B
+#pragma once
+//------------------------------------------------------------------------------
+#include "file.hpp"
+#include "mappedWaveFile.hpp"
+
+#include "le/utility/filesystem.hpp"
+#include "le/utility/temporaries.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <string>
+
+#include <fcntl.h>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace AudioIO
+{
+//------------------------------------------------------------------------------
+
+namespace Detail
+{
+    /// \return A "<hash>_<size>" key unique to the given (format) tag and
+    /// content (64 bit FNV-1a).
+    inline std::string contentKey( char const * pTag, char const * const pBegin, char const * const pEnd )
+    {
+        std::uint64_t const prime( 0x100000001B3ULL );
+        std::uint64_t hash( 0xCBF29CE484222325ULL );
+        for ( ; *pTag; ++pTag )
+            hash = ( hash ^ static_cast<unsigned char>( *pTag ) ) * prime;
+        for ( char const * pByte( pBegin ); pByte != pEnd; ++pByte )
+            hash = ( hash ^ static_cast<unsigned char>( *pByte ) ) * prime;
+
+        char key[ 40 ];
+        std::snprintf( key, sizeof( key ), "%016llX_%llX", static_cast<unsigned long long>( hash ), static_cast<unsigned long long>( pEnd - pBegin ) );
+        return key;
+    }
+
+    /// \return A name (in Utility::Temporaries), unique to this call, under
+    /// which the given entry can be written before it is published().
+    inline std::string temporaryName( std::string const & entry )
+    {
+        return entry + "." + Utility::uniqueTag() + ".tmp";
+    }
+
+    /// <B>Effect:</B> Atomically renames a successfully written temporary
+    /// file into place (or discards it).<BR>
+    inline void publish( std::string const & temporary, std::string const & entry, bool const success )
+    {
+        std::string const temporaryPath( Utility::temporaryPath( temporary.c_str() ) );
+        std::string const entryPath    ( Utility::temporaryPath( entry    .c_str() ) );
+        // A concurrent writer may have already published the same entry, in
+        // which case (on platforms where rename() does not replace existing
+        // files) the temporary copy is simply discarded.
+        if ( !success || std::rename( temporaryPath.c_str(), entryPath.c_str() ) != 0 )
+            std::remove( temporaryPath.c_str() );
+    }
+} // namespace Detail
+
+/// \addtogroup AudioIO
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class DecodedAudioCache
+///
+/// \brief Persistent, content addressed cache of decoded (compressed) audio
+/// files.
+///
+/// The first open() of a file decodes it (through File) into a 32 bit float
+/// WAVE file in Utility::Temporaries, every following open() of the same
+/// content (in any process) simply memory maps the ready-to-use samples (see
+/// MappedWaveFile) instead of decoding the file again.
+///
+/// The cache entries are keyed by a hash of the source file's contents and of
+/// the cached (target) format so that renamed or copied files share an entry
+/// while modified files never hit a stale one. Entries are written to a
+/// private temporary file and then atomically renamed into place so that
+/// concurrent writers and readers never see partial data.
+///
+/// \note The OS may purge Utility::Temporaries at any time (which only costs
+/// a decode on the next open()) and no other eviction is performed.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class DecodedAudioCache
+{
+public:
+    /// <B>Effect:</B> Opens the decoded contents of the given audio file,
+    /// decoding and caching it first if it is not cached yet.<BR>
+    /// \return nullptr if successful, pointer to an error message string
+    /// otherwise.
+    template <Utility::SpecialLocations rootLocation>
+    static error_msg_t open( char const * const relativePathToFile, MappedWaveFile & file )
+    {
+        std::string entry;
+        {
+            auto const source( Utility::File::map<rootLocation>( relativePathToFile ) );
+            if ( !source )
+                return "Unable to open the audio file.";
+            entry = "LE_DecodedAudio_" + Detail::contentKey( formatTag(), source.begin(), source.end() ) + ".wav";
+        }
+
+        if ( !file.open( Utility::File::map<Utility::Temporaries>( entry.c_str() ) ) )
+            return nullptr;
+
+        if ( error_msg_t const pError = decode<rootLocation>( relativePathToFile, entry ) )
+            return pError;
+        return file.open( Utility::File::map<Utility::Temporaries>( entry.c_str() ) );
+    }
+
+private:
+    static unsigned int const chunkSize = 4096; // sample frames decoded at a time
+
+    /// Format (and cache layout) version, part of the key.
+    static char const * formatTag() { return "LE.DecodedAudio.v1.float32.interleaved"; }
+
+    template <Utility::SpecialLocations rootLocation>
+    static error_msg_t decode( char const * const relativePathToFile, std::string const & entry )
+    {
+        File input;
+        if ( error_msg_t const pError = input.open<rootLocation>( relativePathToFile ) )
+            return pError;
+        unsigned int const channels( input.numberOfChannels() );
+        std::unique_ptr<float[]> const pChunk( new ( std::nothrow ) float[ chunkSize * channels ] );
+        if ( !pChunk )
+            return "Out of memory.";
+
+        std::string const temporary( Detail::temporaryName( entry ) );
+
+        bool success;
+        {
+            Utility::File::Stream output( Utility::File::open<Utility::Temporaries>( temporary.c_str(), O_CREAT | O_TRUNC | O_WRONLY ) );
+            if ( !output )
+                return "Unable to create the decoded audio cache file.";
+
+            unsigned char header[ headerSize ];
+            writeHeader( header, channels, input.sampleRate(), 0 );
+            success = output.write( header, headerSize ) == headerSize;
+
+            std::uint64_t frames( 0 );
+            while ( success )
+            {
+                unsigned int const framesRead( input.read( pChunk.get(), chunkSize ) );
+                unsigned int const bytes     ( framesRead * channels * sizeof( float ) );
+                success = output.write( pChunk.get(), bytes ) == bytes;
+                frames += framesRead;
+                if ( framesRead < chunkSize )
+                    break;
+            }
+
+            std::uint64_t const dataSize( frames * channels * sizeof( float ) );
+            success = success && dataSize <= 0xFFFFFFFF - headerSize;
+            if ( success )
+            {
+                writeHeader( header, channels, input.sampleRate(), static_cast<std::uint32_t>( dataSize ) );
+                success = output.seek( 0, SEEK_SET ) && output.write( header, headerSize ) == headerSize;
+            }
+        }
+
+        Detail::publish( temporary, entry, success );
+        return success ? nullptr : "Unable to write the decoded audio cache file.";
+    }
+
+    static unsigned int const headerSize = 44;
+
+    static void writeHeader( unsigned char * const pHeader, unsigned int const channels, unsigned int const sampleRate, std::uint32_t const dataSize )
+    {
+        unsigned int const bytesPerFrame( channels * sizeof( float ) );
+        unsigned char * pOut( pHeader );
+        auto const tag = [ &pOut ]( char const * const pTag ) { for ( unsigned int i( 0 ); i < 4; ++i ) *pOut++ = static_cast<unsigned char>( pTag[ i ] ); };
+        auto const u32 = [ &pOut ]( std::uint32_t const value ) { for ( unsigned int i( 0 ); i < 4; ++i ) *pOut++ = static_cast<unsigned char>( value >> ( i * 8 ) ); };
+        auto const u16 = [ &pOut ]( std::uint32_t const value ) { for ( unsigned int i( 0 ); i < 2; ++i ) *pOut++ = static_cast<unsigned char>( value >> ( i * 8 ) ); };
+        tag( "RIFF" ); u32( headerSize - 8 + dataSize ); tag( "WAVE" );
+        tag( "fmt " ); u32( 16 );
+        u16( 3 /*WAVE_FORMAT_IEEE_FLOAT*/ ); u16( channels ); u32( sampleRate ); u32( sampleRate * bytesPerFrame ); u16( bytesPerFrame ); u16( 32 );
+        tag( "data" ); u32( dataSize );
+    }
+}; // class DecodedAudioCache
+
+/// @} // group AudioIO
+
+//------------------------------------------------------------------------------
+} // namespace AudioIO
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // decodedAudioCache_hpp
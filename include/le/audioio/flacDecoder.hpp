@@ -0,0 +1,635 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file flacDecoder.hpp
+/// ---------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef flacDecoder_hpp__B0DF54E6_BB2E_4651_B600_5BF59C61D246
+#define flacDecoder_hpp__B0DF54E6_BB2E_4651_B600_5BF59C61D246
+#pragma once
+//------------------------------------------------------------------------------
+#include "bitReader.hpp"
+
+#include "le/utility/abi.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace AudioIO
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup AudioIO
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class FLACDecoder
+///
+/// \brief Platform independent decoder for (native) FLAC streams held in
+/// memory (e.g. a memory mapped file).
+///
+/// Supports all the FLAC subframe types, fixed and variable block size
+/// streams and up to 8 channels of 4 to 24 bit audio. Seeking is sample exact
+/// and takes a logarithmic number of frame header lookups (a binary search
+/// over the byte range for frame headers verified by their CRC-8), no seek
+/// table is needed. Corrupt frames are replaced with silence. The frame
+/// CRC-16 and the MD5 signature are not checked.
+///
+/// The decoder does not own the data.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class FLACDecoder
+{
+public:
+    FLACDecoder() { close(); }
+
+    /// <B>Effect:</B> Parses the stream metadata and prepares the decoding of
+    /// the first frame.<BR>
+    /// \return nullptr if successful, pointer to an error message string
+    /// otherwise.
+    char const * open( char const * const pBegin, char const * const pEnd )
+    {
+        close();
+        unsigned char const *       p        ( reinterpret_cast<unsigned char const *>( pBegin ) );
+        unsigned char const * const pDataEnd( reinterpret_cast<unsigned char const *>( pEnd   ) );
+        if ( pDataEnd - p < 4 || std::memcmp( p, "fLaC", 4 ) )
+            return "Not a FLAC file.";
+        p += 4;
+
+        std::uint64_t totalSamples( 0 );
+        bool streamInfoFound( false );
+        for ( bool last( false ); !last; )
+        {
+            if ( pDataEnd - p < 4 )
+                return "Corrupt FLAC file.";
+            last = ( p[ 0 ] & 0x80 ) != 0;
+            unsigned int const type  ( p[ 0 ] & 0x7F                              );
+            unsigned int const length( ( p[ 1 ] << 16 ) | ( p[ 2 ] << 8 ) | p[ 3 ] );
+            p += 4;
+            if ( static_cast<unsigned int>( pDataEnd - p ) < length )
+                return "Corrupt FLAC file.";
+            if ( type == 0 /*STREAMINFO*/ && length >= 34 )
+            {
+                maxBlockSize_     = ( p[ 2 ] << 8 ) | p[ 3 ];
+                sampleRate_       = ( p[ 10 ] << 12 ) | ( p[ 11 ] << 4 ) | ( p[ 12 ] >> 4 );
+                numberOfChannels_ = static_cast<unsigned short>( ( ( p[ 12 ] >> 1 ) & 7 ) + 1 );
+                bitsPerSample_    = ( ( ( p[ 12 ] & 1 ) << 4 ) | ( p[ 13 ] >> 4 ) ) + 1;
+                totalSamples      = ( static_cast<std::uint64_t>( p[ 13 ] & 0x0F ) << 32 ) | ( static_cast<std::uint32_t>( p[ 14 ] ) << 24 ) | ( p[ 15 ] << 16 ) | ( p[ 16 ] << 8 ) | p[ 17 ];
+                streamInfoFound   = true;
+            }
+            p += length;
+        }
+        if ( !streamInfoFound || !sampleRate_ || maxBlockSize_ < 16 )
+            return "Corrupt FLAC file.";
+        if ( bitsPerSample_ < 4 || bitsPerSample_ > 24 )
+            return "Unsupported FLAC bit depth.";
+        if ( pDataEnd - p < 2 || p[ 0 ] != 0xFF || ( p[ 1 ] & 0xFE ) != 0xF8 )
+            return "Corrupt FLAC file.";
+
+        pBlock_.reset( new ( std::nothrow ) std::int32_t[ numberOfChannels_ * maxBlockSize_ ] );
+        if ( !pBlock_ )
+        {
+            close();
+            return "Out of memory.";
+        }
+        pFirstFrame_       = p;
+        pEnd_              = pDataEnd;
+        variableBlockSize_ = ( p[ 1 ] & 1 ) != 0;
+        pNextFrame_        = pFirstFrame_;
+
+        if ( totalSamples )
+        {
+            length_ = static_cast<unsigned int>( std::min<std::uint64_t>( totalSamples, UINT_MAX ) );
+        }
+        else
+        {
+            // Unknown length: the last frame ends the stream.
+            FrameHeader last;
+            if ( !locate( UINT_MAX, last ) )
+            {
+                close();
+                return "Corrupt FLAC file.";
+            }
+            length_ = static_cast<unsigned int>( std::min<std::uint64_t>( last.firstSample + last.blockSize, UINT_MAX ) );
+        }
+        return nullptr;
+    }
+
+    void close()
+    {
+        pBlock_.reset();
+        pFirstFrame_       = nullptr;
+        pEnd_              = nullptr;
+        pNextFrame_        = nullptr;
+        numberOfChannels_  = 0;
+        sampleRate_        = 0;
+        bitsPerSample_     = 0;
+        maxBlockSize_      = 0;
+        length_            = 0;
+        variableBlockSize_ = false;
+        blockFirstSample_  = 0;
+        blockFrames_       = 0;
+        blockPosition_     = 0;
+    }
+
+    /// <B>Effect:</B> Decodes up to <VAR>numberOfSampleFrames</VAR>
+    /// interleaved sample frames.<BR>
+    /// \return The number of sample frames decoded (less than requested only
+    /// at the end of the stream).
+    unsigned int read( float * const pOutput, unsigned int const numberOfSampleFrames )
+    {
+        unsigned int const channels( numberOfChannels_ );
+        unsigned int frames( 0 );
+        while ( frames < numberOfSampleFrames )
+        {
+            if ( blockPosition_ == blockFrames_ && !decodeFrame() )
+                break;
+            unsigned int const available( std::min( numberOfSampleFrames - frames, blockFrames_ - blockPosition_ ) );
+            convert( &pOutput[ frames * channels ], available );
+            blockPosition_ += available;
+            frames         += available;
+        }
+        return frames;
+    }
+
+    /// <B>Effect:</B> Sample exact seek.<BR>
+    void setSamplePosition( unsigned int const positionInSampleFrames )
+    {
+        FrameHeader frame;
+        if ( positionInSampleFrames < length_ && locate( positionInSampleFrames, frame ) )
+        {
+            pNextFrame_       = frame.pFrame;
+            blockFirstSample_ = frame.firstSample;
+            blockFrames_      = 0;
+            while ( decodeFrame() )
+            {
+                if ( positionInSampleFrames < blockFirstSample_ )
+                    break; // (a misleading header found in the data)
+                if ( positionInSampleFrames < blockFirstSample_ + blockFrames_ )
+                {
+                    blockPosition_ = static_cast<unsigned int>( positionInSampleFrames - blockFirstSample_ );
+                    return;
+                }
+            }
+            // Misled by (header like) data: decode from the start.
+            pNextFrame_       = pFirstFrame_;
+            blockFirstSample_ = 0;
+            blockFrames_      = 0;
+            while ( decodeFrame() )
+            {
+                if ( positionInSampleFrames < blockFirstSample_ + blockFrames_ )
+                {
+                    blockPosition_ = static_cast<unsigned int>( positionInSampleFrames - blockFirstSample_ );
+                    return;
+                }
+            }
+        }
+        // At (or past) the end.
+        pNextFrame_       = pEnd_;
+        blockFirstSample_ = length_;
+        blockFrames_      = 0;
+        blockPosition_    = 0;
+    }
+
+    unsigned short numberOfChannels() const { return numberOfChannels_; }
+    unsigned int   sampleRate      () const { return sampleRate_      ; }
+    unsigned int   bitsPerSample   () const { return bitsPerSample_   ; }
+    unsigned int   lengthInSamples () const { return length_          ; }
+
+    /// \return The position of the next decoded sample frame.
+    unsigned int position() const { return static_cast<unsigned int>( blockFirstSample_ + blockPosition_ ); }
+
+    bool operator!() const { return !pBlock_; }
+
+private:
+    struct FrameHeader
+    {
+        unsigned char const * pFrame           ;
+        unsigned char const * pSubframes       ;
+        std::uint64_t         firstSample      ;
+        unsigned int          blockSize        ;
+        unsigned int          channelAssignment;
+    }; // struct FrameHeader
+
+    /// <B>Effect:</B> Parses and verifies (CRC-8 and consistency with the
+    /// stream) the frame header at <VAR>p</VAR>.<BR>
+    bool parseHeader( unsigned char const * const p, FrameHeader & header ) const
+    {
+        std::size_t const available( static_cast<std::size_t>( pEnd_ - p ) );
+        if ( available < 6 || p[ 0 ] != 0xFF || ( p[ 1 ] & 0xFE ) != 0xF8 || ( ( p[ 1 ] & 1 ) != 0 ) != variableBlockSize_ )
+            return false;
+        unsigned int const blockSizeCode    ( p[ 2 ] >> 4         );
+        unsigned int const sampleRateCode   ( p[ 2 ] & 0x0F       );
+        unsigned int const channelAssignment( p[ 3 ] >> 4         );
+        unsigned int const sampleSizeCode   ( ( p[ 3 ] >> 1 ) & 7 );
+        static unsigned char const sampleSizes[ 8 ] = { 0, 8, 12, 0, 16, 20, 24, 0 };
+        if
+        (
+            !blockSizeCode || sampleRateCode == 15 || ( p[ 3 ] & 1 )                                         ||
+            channelAssignment > 10 || ( channelAssignment < 8 ? channelAssignment + 1 : 2 ) != numberOfChannels_ ||
+            ( sampleSizeCode && sampleSizes[ sampleSizeCode ] != bitsPerSample_ )
+        )
+            return false;
+
+        // UTF-8 style coded frame (fixed block size) or sample number.
+        unsigned int offset( 4 );
+        std::uint64_t number( p[ offset++ ] );
+        if ( number & 0x80 )
+        {
+            unsigned int continuation( 0 );
+            while ( continuation < 7 && ( number & ( 0x40 >> continuation ) ) )
+                ++continuation;
+            if ( !continuation || continuation > 6 || available < offset + continuation )
+                return false;
+            number &= 0x3F >> continuation;
+            for ( unsigned int byte( 0 ); byte < continuation; ++byte )
+            {
+                unsigned char const next( p[ offset++ ] );
+                if ( ( next & 0xC0 ) != 0x80 )
+                    return false;
+                number = ( number << 6 ) | ( next & 0x3F );
+            }
+        }
+
+        // (All of the remaining header bytes, including the CRC, have to be
+        // there before any of them is read.)
+        unsigned int const blockSizeBytes ( blockSizeCode  == 6 ? 1 : blockSizeCode  == 7 ? 2 : 0 );
+        unsigned int const sampleRateBytes( sampleRateCode == 12 ? 1 : sampleRateCode >= 13 ? 2 : 0 );
+        if ( available < offset + blockSizeBytes + sampleRateBytes + 1 )
+            return false;
+
+        unsigned int blockSize;
+        switch ( blockSizeCode )
+        {
+            case 1 : blockSize = 192; break;
+            case 6 : blockSize = p[ offset ] + 1; break;
+            case 7 : blockSize = ( ( p[ offset ] << 8 ) | p[ offset + 1 ] ) + 1; break;
+            default: blockSize = blockSizeCode < 6 ? 576U << ( blockSizeCode - 2 ) : 256U << ( blockSizeCode - 8 ); break;
+        }
+        offset += blockSizeBytes + sampleRateBytes;
+        if ( blockSize > maxBlockSize_ )
+            return false;
+
+        unsigned int crc( 0 );
+        for ( unsigned int byte( 0 ); byte < offset; ++byte )
+        {
+            crc ^= p[ byte ];
+            for ( unsigned int bit( 0 ); bit < 8; ++bit )
+                crc = ( ( crc << 1 ) ^ ( crc & 0x80 ? 0x07 : 0 ) ) & 0xFF;
+        }
+        if ( crc != p[ offset ] )
+            return false;
+
+        header.pFrame            = p;
+        header.pSubframes        = p + offset + 1;
+        header.firstSample       = variableBlockSize_ ? number : number * maxBlockSize_;
+        header.blockSize         = blockSize;
+        header.channelAssignment = channelAssignment;
+        return true;
+    }
+
+    /// \return The first valid frame header in [pFrom, pTo).
+    bool findHeader( unsigned char const * pFrom, unsigned char const * const pTo, FrameHeader & header ) const
+    {
+        for ( ; pFrom < pTo; ++pFrom )
+        {
+            pFrom = static_cast<unsigned char const *>( std::memchr( pFrom, 0xFF, pTo - pFrom ) );
+            if ( !pFrom )
+                return false;
+            if ( parseHeader( pFrom, header ) )
+                return true;
+        }
+        return false;
+    }
+
+    /// <B>Effect:</B> Binary searches the byte range for the last frame
+    /// starting at or before the given sample.<BR>
+    bool locate( std::uint64_t const sample, FrameHeader & frame ) const
+    {
+        if ( !parseHeader( pFirstFrame_, frame ) )
+            return false;
+        unsigned char const * pHigh( pEnd_ );
+        while ( pHigh - frame.pFrame > 1 )
+        {
+            unsigned char const * const pMiddle( frame.pFrame + ( pHigh - frame.pFrame ) / 2 );
+            FrameHeader candidate;
+            if ( findHeader( pMiddle, pHigh, candidate ) && candidate.firstSample <= sample )
+                frame = candidate;
+            else
+                pHigh = pMiddle;
+        }
+        return true;
+    }
+
+    /// <B>Effect:</B> Decodes the next frame, concealing corrupt frames (and
+    /// any samples lost between frames) with silence so that every sample
+    /// keeps its position.<BR>
+    /// \return false at the end of the stream.
+    bool decodeFrame()
+    {
+        std::uint64_t const expected( blockFirstSample_ + blockFrames_ );
+        if ( pNextFrame_ >= pEnd_ )
+            return expected < length_ && conceal( expected, length_ - expected ); // (truncated stream)
+        FrameHeader header;
+        if ( !parseHeader( pNextFrame_, header ) || !follows( header, expected ) )
+        {
+            // Lost sync: resume at the next frame that follows the last one
+            // (or conceal the rest of the stream if there is none).
+            unsigned char const * pFrom( pNextFrame_ + 1 );
+            pNextFrame_ = pEnd_;
+            for ( ; findHeader( pFrom, pEnd_, header ); pFrom = header.pFrame + 1 )
+            {
+                if ( follows( header, expected ) )
+                {
+                    pNextFrame_ = header.pFrame;
+                    break;
+                }
+            }
+            return decodeFrame();
+        }
+        // Samples lost before this frame (possibly several frames worth) are
+        // concealed first (in maxBlockSize_ chunks, one per call) so that the
+        // frame is decoded exactly at its own position.
+        if ( header.firstSample > expected )
+            return conceal( expected, header.firstSample - expected );
+
+        reader_.reset( header.pSubframes, pEnd_ );
+        unsigned int const blockSize( header.blockSize );
+        bool valid( true );
+        for ( unsigned int channel( 0 ); valid && channel < numberOfChannels_; ++channel )
+        {
+            // The side channel has one extra bit.
+            bool const side
+            (
+                ( header.channelAssignment == 8  && channel == 1 ) ||
+                ( header.channelAssignment == 9  && channel == 0 ) ||
+                ( header.channelAssignment == 10 && channel == 1 )
+            );
+            valid = decodeSubframe( &pBlock_[ channel * maxBlockSize_ ], blockSize, bitsPerSample_ + side );
+        }
+        reader_.alignToByte();
+        reader_.read( 16 ); // CRC-16
+        if ( !valid || reader_.overrun() )
+        {
+            pNextFrame_ = header.pFrame + 1;
+            return conceal( header.firstSample, blockSize );
+        }
+
+        // (modular arithmetic: corrupt data must not overflow)
+        std::uint32_t * LE_RESTRICT const pFirst ( reinterpret_cast<std::uint32_t *>( &pBlock_[ 0             ] ) );
+        std::uint32_t * LE_RESTRICT const pSecond( reinterpret_cast<std::uint32_t *>( &pBlock_[ maxBlockSize_ ] ) );
+        switch ( header.channelAssignment )
+        {
+            case 8: // left/side
+                for ( unsigned int sample( 0 ); sample < blockSize; ++sample )
+                    pSecond[ sample ] = pFirst[ sample ] - pSecond[ sample ];
+                break;
+            case 9: // side/right
+                for ( unsigned int sample( 0 ); sample < blockSize; ++sample )
+                    pFirst[ sample ] += pSecond[ sample ];
+                break;
+            case 10: // mid/side
+                for ( unsigned int sample( 0 ); sample < blockSize; ++sample )
+                {
+                    std::uint32_t const side( pSecond[ sample ]                          );
+                    std::uint32_t const mid ( ( pFirst[ sample ] << 1 ) | ( side & 1 ) );
+                    pFirst [ sample ] = static_cast<std::uint32_t>( static_cast<std::int32_t>( mid + side ) >> 1 );
+                    pSecond[ sample ] = static_cast<std::uint32_t>( static_cast<std::int32_t>( mid - side ) >> 1 );
+                }
+                break;
+        }
+
+        pNextFrame_       = reader_.bytePosition();
+        blockFirstSample_ = header.firstSample;
+        blockFrames_      = blockSize;
+        blockPosition_    = 0;
+        return true;
+    }
+
+    bool follows( FrameHeader const & header, std::uint64_t const expected ) const { return header.firstSample >= expected && header.firstSample < length_; }
+
+    bool conceal( std::uint64_t const firstSample, std::uint64_t const frames )
+    {
+        blockFirstSample_ = firstSample;
+        blockFrames_      = static_cast<unsigned int>( std::min<std::uint64_t>( frames, maxBlockSize_ ) );
+        blockPosition_    = 0;
+        for ( unsigned int channel( 0 ); channel < numberOfChannels_; ++channel )
+            std::fill_n( &pBlock_[ channel * maxBlockSize_ ], blockFrames_, 0 );
+        return true;
+    }
+
+    bool decodeSubframe( std::int32_t * const pOutput, unsigned int const blockSize, unsigned int bits )
+    {
+        if ( reader_.read( 1 ) )
+            return false;
+        unsigned int const type( reader_.read( 6 ) );
+        unsigned int wastedBits( 0 );
+        if ( reader_.read( 1 ) )
+            wastedBits = reader_.readUnary() + 1;
+        if ( wastedBits >= bits )
+            return false;
+        bits -= wastedBits;
+
+        if ( type == 0 ) // constant
+        {
+            std::fill_n( pOutput, blockSize, reader_.readSigned( bits ) );
+        }
+        else if ( type == 1 ) // verbatim
+        {
+            for ( unsigned int sample( 0 ); sample < blockSize; ++sample )
+                pOutput[ sample ] = reader_.readSigned( bits );
+        }
+        else if ( type >= 8 && type <= 12 ) // fixed predictor
+        {
+            unsigned int const order( type - 8 );
+            if ( order > blockSize )
+                return false;
+            for ( unsigned int sample( 0 ); sample < order; ++sample )
+                pOutput[ sample ] = reader_.readSigned( bits );
+            if ( !decodeResidual( pOutput, blockSize, order ) )
+                return false;
+            restoreFixed( pOutput, blockSize, order );
+        }
+        else if ( type >= 32 ) // LPC
+        {
+            unsigned int const order( ( type & 31 ) + 1 );
+            if ( order > blockSize )
+                return false;
+            for ( unsigned int sample( 0 ); sample < order; ++sample )
+                pOutput[ sample ] = reader_.readSigned( bits );
+            unsigned int const precision( reader_.read( 4 ) + 1       );
+            std::int32_t const shift    ( reader_.readSigned( 5 )     );
+            if ( precision == 16 || shift < 0 )
+                return false;
+            std::int32_t coefficients[ 32 ];
+            for ( unsigned int coefficient( 0 ); coefficient < order; ++coefficient )
+                coefficients[ coefficient ] = reader_.readSigned( precision );
+            if ( !decodeResidual( pOutput, blockSize, order ) )
+                return false;
+            // 32 bit accumulation suffices (and is faster) unless the
+            // coefficients, samples and order could overflow it.
+            unsigned int orderBits( 0 );
+            while ( ( 1U << orderBits ) < order )
+                ++orderBits;
+            if ( bits + precision + orderBits <= 32 )
+                restoreLPC<std::uint32_t>( pOutput, blockSize, coefficients, order, static_cast<unsigned int>( shift ) );
+            else
+                restoreLPC<std::int64_t>( pOutput, blockSize, coefficients, order, static_cast<unsigned int>( shift ) );
+        }
+        else
+        {
+            return false;
+        }
+
+        if ( wastedBits )
+        {
+            for ( unsigned int sample( 0 ); sample < blockSize; ++sample )
+                pOutput[ sample ] = static_cast<std::int32_t>( static_cast<std::uint32_t>( pOutput[ sample ] ) << wastedBits );
+        }
+        return !reader_.overrun();
+    }
+
+    bool decodeResidual( std::int32_t * const pOutput, unsigned int const blockSize, unsigned int const order )
+    {
+        unsigned int const method( reader_.read( 2 ) );
+        if ( method > 1 )
+            return false;
+        unsigned int const parameterBits ( method ? 5 : 4              );
+        unsigned int const escape        ( ( 1U << parameterBits ) - 1 );
+        unsigned int const partitionOrder( reader_.read( 4 )           );
+        unsigned int const partitionSize ( blockSize >> partitionOrder );
+        if ( ( partitionSize << partitionOrder ) != blockSize || partitionSize < order )
+            return false;
+
+        unsigned int sample( order );
+        for ( unsigned int partition( 0 ); partition < ( 1U << partitionOrder ); ++partition )
+        {
+            unsigned int const end      ( ( partition + 1 ) * partitionSize );
+            unsigned int const parameter( reader_.read( parameterBits )     );
+            if ( parameter == escape )
+            {
+                unsigned int const bits( reader_.read( 5 ) );
+                for ( ; sample < end; ++sample )
+                    pOutput[ sample ] = reader_.readSigned( bits );
+            }
+            else
+            {
+                for ( ; sample < end; ++sample )
+                    pOutput[ sample ] = reader_.readRice( parameter );
+            }
+            if ( reader_.overrun() )
+                return false;
+        }
+        return true;
+    }
+
+    /// Residuals (from <VAR>order</VAR> on) are replaced by the samples
+    /// (modular arithmetic: corrupt data must not overflow).
+    static void restoreFixed( std::int32_t * const pSamples, unsigned int const blockSize, unsigned int const order )
+    {
+        std::uint32_t * const p( reinterpret_cast<std::uint32_t *>( pSamples ) );
+        switch ( order )
+        {
+            case 1: for ( unsigned int i( 1 ); i < blockSize; ++i ) p[ i ] += p[ i - 1 ]; break;
+            case 2: for ( unsigned int i( 2 ); i < blockSize; ++i ) p[ i ] += 2 * p[ i - 1 ] - p[ i - 2 ]; break;
+            case 3: for ( unsigned int i( 3 ); i < blockSize; ++i ) p[ i ] += 3 * ( p[ i - 1 ] - p[ i - 2 ] ) + p[ i - 3 ]; break;
+            case 4: for ( unsigned int i( 4 ); i < blockSize; ++i ) p[ i ] += 4 * ( p[ i - 1 ] + p[ i - 3 ] ) - 6 * p[ i - 2 ] - p[ i - 4 ]; break;
+        }
+    }
+
+    /// \copydoc restoreFixed()
+    /// \tparam Accumulator std::uint32_t (modular) when the prediction fits
+    ///         into 32 bits, std::int64_t otherwise.
+    template <typename Accumulator>
+    static void restoreLPC( std::int32_t * const p, unsigned int const blockSize, std::int32_t const * const pCoefficients, unsigned int const order, unsigned int const shift )
+    {
+        for ( unsigned int i( order ); i < blockSize; ++i )
+        {
+            Accumulator prediction( 0 );
+            for ( unsigned int coefficient( 0 ); coefficient < order; ++coefficient )
+                prediction += static_cast<Accumulator>( pCoefficients[ coefficient ] ) * static_cast<Accumulator>( p[ i - 1 - coefficient ] );
+            std::int32_t const predicted( static_cast<std::int32_t>( signedValue( prediction ) >> shift ) );
+            p[ i ] = static_cast<std::int32_t>( static_cast<std::uint32_t>( p[ i ] ) + static_cast<std::uint32_t>( predicted ) );
+        }
+    }
+
+    static std::int32_t signedValue( std::uint32_t const value ) { return static_cast<std::int32_t>( value ); }
+    static std::int64_t signedValue( std::int64_t  const value ) { return value; }
+
+    /// <B>Effect:</B> Converts (and interleaves) decoded samples to float,
+    /// with dedicated (vectorizable) loops for mono and stereo.<BR>
+    void convert( float * LE_RESTRICT const pOutput, unsigned int const frames ) const
+    {
+        float const scale( 1.0f / static_cast<float>( 1U << ( bitsPerSample_ - 1 ) ) );
+        unsigned int const channels( numberOfChannels_ );
+        std::int32_t const * LE_RESTRICT const pFirst( &pBlock_[ blockPosition_ ] );
+        if ( channels == 1 )
+        {
+            for ( unsigned int frame( 0 ); frame < frames; ++frame )
+                pOutput[ frame ] = pFirst[ frame ] * scale;
+        }
+        else if ( channels == 2 )
+        {
+            // (size_t indices: no unsigned wrap around to prevent vectorization)
+            std::int32_t const * LE_RESTRICT const pSecond( pFirst + maxBlockSize_ );
+            for ( std::size_t frame( 0 ); frame < frames; ++frame )
+            {
+                pOutput[ frame * 2 + 0 ] = pFirst [ frame ] * scale;
+                pOutput[ frame * 2 + 1 ] = pSecond[ frame ] * scale;
+            }
+        }
+        else
+        {
+            for ( unsigned int channel( 0 ); channel < channels; ++channel )
+            {
+                std::int32_t const * LE_RESTRICT const pChannel( pFirst + channel * maxBlockSize_ );
+                for ( std::size_t frame( 0 ); frame < frames; ++frame )
+                    pOutput[ frame * channels + channel ] = pChannel[ frame ] * scale;
+            }
+        }
+    }
+
+private: // noncopyable
+    FLACDecoder( FLACDecoder const & );
+    void operator=( FLACDecoder const & );
+
+private:
+    std::unique_ptr<std::int32_t[]> pBlock_; // numberOfChannels_ x maxBlockSize_ decoded samples
+    Detail::BitReader               reader_;
+
+    unsigned char const * pFirstFrame_;
+    unsigned char const * pEnd_       ;
+    unsigned char const * pNextFrame_ ;
+
+    unsigned short numberOfChannels_ ;
+    unsigned int   sampleRate_       ;
+    unsigned int   bitsPerSample_    ;
+    unsigned int   maxBlockSize_     ;
+    unsigned int   length_           ;
+    bool           variableBlockSize_;
+
+    std::uint64_t blockFirstSample_; // of the current (decoded) block
+    unsigned int  blockFrames_     ;
+    unsigned int  blockPosition_   ; // next frame of the current block to read
+}; // class FLACDecoder
+
+/// @} // group AudioIO
+
+//------------------------------------------------------------------------------
+} // namespace AudioIO
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // flacDecoder_hpp
@@ -0,0 +1,381 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file indexedFile.hpp
+/// ---------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef indexedFile_hpp__961F0101_7B91_42E7_A132_9098B2BD3507
+#define indexedFile_hpp__961F0101_7B91_42E7_A132_9098B2BD3507
+#pragma once
+//------------------------------------------------------------------------------
+#include "decodedAudioCache.hpp"
+#include "file.hpp"
+
+#include "le/utility/filesystem.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace AudioIO
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup AudioIO
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class IndexedFile
+///
+/// \brief An AudioIO::File reader with an exact length and sample exact
+/// seeking (also for VBR MP3s and other formats the OS decoders seek in only
+/// approximately).
+///
+/// On the first open() of a file a single indexing pass decodes it to find
+/// its exact length and to record a short fingerprint of the decoded samples
+/// at regular checkpoints. The index is persisted (in Utility::Temporaries,
+/// keyed by the file's contents) so later opens, in any process, only load
+/// it.
+///
+/// setSamplePosition() looks up (in constant time) the closest checkpoint
+/// before the target, lets the OS decoder seek (approximately) somewhat
+/// ahead of it, finds the checkpoint's fingerprint in the decoded window and
+/// decodes forward from there, so the cost of a seek is bounded by the
+/// checkpoint spacing and the OS decoder's seek error rather than by the
+/// position. When a checkpoint cannot be found (e.g. in silence) it falls
+/// back to an earlier one and, ultimately, to decoding from the start, so
+/// seeking is always exact.
+///
+/// With exact lengths and seeking, files can be read into exactly sized
+/// buffers and split into ranges decoded in parallel (by one IndexedFile
+/// instance per thread).
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class IndexedFile
+{
+public:
+    IndexedFile() { close(); }
+
+    /// <B>Effect:</B> Opens the file (see File::open()) and loads or builds
+    /// its index.<BR>
+    template <Utility::SpecialLocations rootLocation>
+    error_msg_t open( char const * const relativePathToFile )
+    {
+        close();
+        if ( error_msg_t const pError = file_.open<rootLocation>( relativePathToFile ) )
+            return pError;
+        numberOfChannels_ = file_.numberOfChannels();
+        sampleRate_       = file_.sampleRate      ();
+        pChunk_.reset( new ( std::nothrow ) float[ chunkSize * numberOfChannels_ ] );
+        if ( !pChunk_ )
+        {
+            close();
+            return "Out of memory.";
+        }
+
+        std::string entry;
+        {
+            auto const source( Utility::File::map<rootLocation>( relativePathToFile ) );
+            if ( !source )
+            {
+                close();
+                return "Unable to open the audio file.";
+            }
+            entry = "LE_SeekIndex_" + Detail::contentKey( formatTag(), source.begin(), source.end() ) + ".idx";
+        }
+        if ( !load( entry ) )
+        {
+            build();
+            save( entry ); // best effort: the index is rebuilt on the next open() otherwise
+        }
+        return nullptr;
+    }
+
+    void close()
+    {
+        file_.close();
+        pChunk_.reset();
+        fingerprints_.clear();
+        window_      .clear();
+        numberOfChannels_ = 0;
+        sampleRate_       = 0;
+        length_           = 0;
+        position_         = 0;
+        pendingBegin_     = 0;
+        pendingEnd_       = 0;
+    }
+
+    /// <B>Effect:</B> Reads up to <VAR>numberOfSampleFrames</VAR> interleaved
+    /// sample frames.<BR>
+    /// \return The number of sample frames read (less than requested only at
+    /// the end of the file).
+    unsigned int read( float * const pOutput, unsigned int const numberOfSampleFrames )
+    {
+        unsigned int const channels( numberOfChannels_ );
+        unsigned int const wanted  ( std::min( numberOfSampleFrames, length_ - position_ ) );
+        unsigned int       frames  ( std::min( wanted, pendingEnd_ - pendingBegin_ ) );
+        std::copy_n( &window_[ pendingBegin_ * channels ], frames * channels, pOutput );
+        pendingBegin_ += frames;
+        while ( frames < wanted )
+        {
+            unsigned int const framesRead( file_.read( &pOutput[ frames * channels ], wanted - frames ) );
+            if ( !framesRead )
+                break;
+            frames += framesRead;
+        }
+        position_ += frames;
+        return frames;
+    }
+
+    /// <B>Effect:</B> Sample exact seek (see the class description).<BR>
+    void setSamplePosition( unsigned int positionInSampleFrames )
+    {
+        unsigned int const target( std::min( positionInSampleFrames, length_ ) );
+        if ( target >= position_ && target - position_ <= 2 * checkpointInterval )
+        {
+            skip( target - position_ );
+            return;
+        }
+
+        pendingBegin_ = pendingEnd_ = 0;
+        unsigned int slack    ( initialSlack );
+        unsigned int candidate( std::min( target / checkpointInterval + 1, numberOfCheckpoints() ) );
+        while ( candidate-- && candidate * checkpointInterval >= slack && slack <= maximumSlackInSeconds * sampleRate_ )
+        {
+            if ( !usable( candidate ) )
+                continue;
+            if ( seekVia( candidate, slack, target ) )
+                return;
+            // The decoder landed after the checkpoint (or the fingerprint is
+            // ambiguous): retry further back with a wider window.
+            slack *= 2;
+        }
+
+        file_.restart();
+        position_ = 0;
+        skip( target );
+    }
+
+    void restart() { setSamplePosition( 0 ); }
+
+    unsigned short numberOfChannels() const { return numberOfChannels_   ; } ///< \see File::numberOfChannels()
+    unsigned int   sampleRate      () const { return sampleRate_         ; } ///< \see File::sampleRate()
+    unsigned int   lengthInSamples () const { return length_             ; } ///< Exact total number of sample frames.
+    unsigned int   remainingSamples() const { return length_ - position_ ; } ///< Exact number of sample frames not yet read.
+    unsigned int   position        () const { return position_           ; } ///< Position of the next frame read().
+
+    bool operator!() const { return !pChunk_; }
+
+private:
+    static unsigned int const chunkSize             = 4096 ; // sample frames decoded at a time
+    static unsigned int const checkpointInterval    = 32768; // sample frames between fingerprints
+    static unsigned int const fingerprintLength     = 32   ; // sample frames (of the first channel)
+    static unsigned int const initialSlack          = 4096 ; // sample frames decoded on either side of a checkpoint
+    static unsigned int const maximumSlackInSeconds = 8    ;
+
+    static char const * formatTag() { return "LE.SeekIndex.v1"; }
+
+    struct Header
+    {
+        char          magic[ 4 ]        ;
+        std::uint32_t numberOfChannels  ;
+        std::uint32_t sampleRate        ;
+        std::uint32_t length            ;
+        std::uint32_t checkpointInterval;
+        std::uint32_t fingerprintLength ;
+        std::uint32_t checkpoints       ;
+    }; // struct Header
+
+    unsigned int numberOfCheckpoints() const { return static_cast<unsigned int>( fingerprints_.size() / fingerprintLength ); }
+
+    float const * fingerprint( unsigned int const checkpoint ) const { return &fingerprints_[ checkpoint * fingerprintLength ]; }
+
+    /// Silent or constant fingerprints would match anywhere.
+    bool usable( unsigned int const checkpoint ) const
+    {
+        float const * const pFingerprint( fingerprint( checkpoint ) );
+        std::pair<float const *, float const *> const range( std::minmax_element( pFingerprint, pFingerprint + fingerprintLength ) );
+        return *range.second - *range.first > 1e-3f;
+    }
+
+    void build()
+    {
+        unsigned int const channels( numberOfChannels_ );
+        unsigned int       length  ( 0 );
+        for ( ; ; )
+        {
+            unsigned int const frames( file_.read( pChunk_.get(), chunkSize ) );
+            for ( unsigned int checkpoint( length / checkpointInterval ); checkpoint * checkpointInterval < length + frames; ++checkpoint )
+            {
+                unsigned int const start( checkpoint * checkpointInterval                                 );
+                unsigned int const begin( std::max( start, length )                                       );
+                unsigned int const end  ( std::min( start + fingerprintLength, length + frames )          );
+                if ( begin >= end )
+                    continue;
+                fingerprints_.resize( std::max<std::size_t>( fingerprints_.size(), ( checkpoint + 1 ) * fingerprintLength ) );
+                for ( unsigned int frame( begin ); frame < end; ++frame )
+                    fingerprints_[ checkpoint * fingerprintLength + frame - start ] = pChunk_[ ( frame - length ) * channels ];
+            }
+            length += frames;
+            if ( frames < chunkSize )
+                break;
+        }
+        // Drop the (incomplete) fingerprint of a checkpoint too close to the end.
+        unsigned int const complete( length >= fingerprintLength ? ( length - fingerprintLength ) / checkpointInterval + 1 : 0 );
+        fingerprints_.resize( std::min<std::size_t>( fingerprints_.size(), complete * fingerprintLength ) );
+        length_ = length;
+        file_.restart();
+    }
+
+    bool load( std::string const & entry )
+    {
+        Utility::File::MemoryMapping const index( Utility::File::map<Utility::Temporaries>( entry.c_str() ) );
+        if ( !index || index.size() < sizeof( Header ) )
+            return false;
+        Header header;
+        std::memcpy( &header, index.begin(), sizeof( header ) );
+        if
+        (
+            std::memcmp( header.magic, "LESI", 4 )                                                         ||
+            header.numberOfChannels   != numberOfChannels_                                                 ||
+            header.sampleRate         != sampleRate_                                                       ||
+            header.checkpointInterval != checkpointInterval                                                ||
+            header.fingerprintLength  != fingerprintLength                                                 ||
+            index.size() != sizeof( header ) + std::size_t( header.checkpoints ) * fingerprintLength * sizeof( float )
+        )
+            return false;
+        fingerprints_.resize( std::size_t( header.checkpoints ) * fingerprintLength );
+        std::memcpy( fingerprints_.data(), index.begin() + sizeof( header ), fingerprints_.size() * sizeof( float ) );
+        length_ = header.length;
+        return true;
+    }
+
+    void save( std::string const & entry ) const
+    {
+        Header const header =
+        {
+            { 'L', 'E', 'S', 'I' },
+            numberOfChannels_, sampleRate_, length_, checkpointInterval, fingerprintLength, numberOfCheckpoints()
+        };
+        unsigned int const dataSize( static_cast<unsigned int>( fingerprints_.size() * sizeof( float ) ) );
+        std::string const temporary( Detail::temporaryName( entry ) );
+        bool success;
+        {
+            Utility::File::Stream output( Utility::File::open<Utility::Temporaries>( temporary.c_str(), O_CREAT | O_TRUNC | O_WRONLY ) );
+            if ( !output )
+                return;
+            success =
+                output.write( &header, sizeof( header ) ) == sizeof( header ) &&
+                output.write( fingerprints_.data(), dataSize ) == dataSize;
+        }
+        Detail::publish( temporary, entry, success );
+    }
+
+    /// <B>Effect:</B> Reads and discards the given number of frames.<BR>
+    void skip( unsigned int frames )
+    {
+        while ( frames )
+        {
+            unsigned int const framesRead( read( pChunk_.get(), std::min( frames, static_cast<unsigned int>( chunkSize ) ) ) );
+            if ( !framesRead )
+                break;
+            frames -= framesRead;
+        }
+    }
+
+    /// <B>Effect:</B> Tries to seek to <VAR>target</VAR> by locating the
+    /// given checkpoint in a window decoded around it.<BR>
+    bool seekVia( unsigned int const checkpoint, unsigned int const slack, unsigned int const target )
+    {
+        unsigned int const channels     ( numberOfChannels_                       );
+        unsigned int const checkpointPos( checkpoint * checkpointInterval         );
+        unsigned int const windowFrames ( 2 * slack + fingerprintLength           );
+        window_.resize( std::size_t( windowFrames ) * channels );
+
+        file_.setSamplePosition( checkpointPos - slack );
+        unsigned int frames( 0 );
+        while ( frames < windowFrames )
+        {
+            unsigned int const framesRead( file_.read( &window_[ frames * channels ], windowFrames - frames ) );
+            if ( !framesRead )
+                break;
+            frames += framesRead;
+        }
+
+        float const * const pFingerprint( fingerprint( checkpoint ) );
+        unsigned int const notFound( ~0U );
+        unsigned int match( notFound );
+        if ( frames < fingerprintLength )
+            return false;
+
+        // (The window cannot start before the beginning of the file so the
+        // checkpoint cannot lie further than checkpointPos into it.)
+        unsigned int const lastOffset( std::min( frames - fingerprintLength, checkpointPos ) );
+        for ( unsigned int offset( 0 ); offset <= lastOffset; ++offset )
+        {
+            unsigned int sample( 0 );
+            while ( sample < fingerprintLength && std::abs( window_[ ( offset + sample ) * channels ] - pFingerprint[ sample ] ) <= 1e-4f )
+                ++sample;
+            if ( sample != fingerprintLength )
+                continue;
+            if ( match != notFound )
+                return false;
+            match = offset;
+        }
+        if ( match == notFound )
+            return false;
+
+        // window_[ match ] is (exactly) the checkpoint frame.
+        unsigned int const targetOffset( match + target - checkpointPos );
+        position_     = checkpointPos - match + frames;
+        pendingBegin_ = pendingEnd_ = frames;
+        if ( targetOffset < frames )
+        {
+            pendingBegin_ = targetOffset;
+            position_     = target;
+        }
+        skip( target - position_ );
+        return true;
+    }
+
+private: // noncopyable
+    IndexedFile( IndexedFile const & );
+    void operator=( IndexedFile const & );
+
+private:
+    File                     file_        ;
+    std::unique_ptr<float[]> pChunk_      ; // chunkSize frames of scratch
+    std::vector<float>       fingerprints_; // fingerprintLength samples per checkpoint
+    std::vector<float>       window_      ; // seek window, also holds the pending frames
+
+    unsigned short numberOfChannels_;
+    unsigned int   sampleRate_      ;
+    unsigned int   length_          ;
+    unsigned int   position_        ; // of the next frame returned by read()
+    unsigned int   pendingBegin_    ; // frames (in window_) decoded but not yet read
+    unsigned int   pendingEnd_      ;
+}; // class IndexedFile
+
+/// @} // group AudioIO
+
+//------------------------------------------------------------------------------
+} // namespace AudioIO
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // indexedFile_hpp
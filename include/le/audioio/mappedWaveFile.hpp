@@ -0,0 +1,280 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file mappedWaveFile.hpp
+/// ------------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef mappedWaveFile_hpp__17F74E9E_8C8F_4F80_A341_512731B906C2
+#define mappedWaveFile_hpp__17F74E9E_8C8F_4F80_A341_512731B906C2
+#pragma once
+//------------------------------------------------------------------------------
+#include "le/utility/abi.hpp"
+#include "le/utility/filesystem.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // _WIN32
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace AudioIO
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup AudioIO
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class MappedWaveFile
+///
+/// \brief Zero-copy, random access reader for uncompressed WAVE files.
+///
+/// Unlike InputWaveFile, which reads (copies) the file through a stream, the
+/// whole file is memory mapped (Utility::File::map()) and the native PCM data
+/// is exposed directly (frame()) so that nothing is copied until the data is
+/// actually used, the page cache is shared by all the processes reading the
+/// same file and any position is instantly accessible. read() converts only
+/// the requested window to float, in plain per-format loops that compilers
+/// auto-vectorize.
+///
+/// Supported formats: 8, 16, 24 and 32 bit integer PCM, 32 and 64 bit
+/// floating point (including WAVE_FORMAT_EXTENSIBLE files with these
+/// subformats). The data is assumed to be little endian, as are all the
+/// targeted platforms.
+///
+/// \note Android APK assets (Utility::Resources) are mapped through
+/// Utility::ResourceFile and are not supported.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class MappedWaveFile
+{
+public:
+    enum SampleFormat { UInt8, Int16, Int24, Int32, Float32, Float64 };
+
+    MappedWaveFile() { close(); }
+
+    /// <B>Effect:</B> Memory maps and parses the given WAVE file.<BR>
+    /// \return nullptr if successful, pointer to an error message string
+    /// otherwise.
+    template <Utility::SpecialLocations rootLocation>
+    char const * open( char const * const relativePathToFile ) { return open( Utility::File::map<rootLocation>( relativePathToFile ) ); }
+
+    /// \overload
+    char const * open( Utility::File::MemoryMapping && mapping )
+    {
+        close();
+        if ( !mapping )
+            return "Unable to open the WAVE file.";
+        mapping_ = std::move( mapping );
+        if ( char const * const pError = parse() )
+        {
+            close();
+            return pError;
+        }
+        advise( 0, numberOfSampleFrames_, sequential );
+        return nullptr;
+    }
+
+    void close()
+    {
+        mapping_              = Utility::File::MemoryMapping();
+        pData_                = nullptr;
+        format_               = Int16;
+        numberOfChannels_     = 0;
+        sampleRate_           = 0;
+        bytesPerSample_       = 0;
+        numberOfSampleFrames_ = 0;
+    }
+
+    /// \name Native data views
+    /// @{
+    SampleFormat sampleFormat  () const { return format_;                             }
+    unsigned int bytesPerSample() const { return bytesPerSample_;                     }
+    unsigned int bytesPerFrame () const { return bytesPerSample_ * numberOfChannels_; }
+
+    /// \return A pointer to the native (interleaved, little endian, possibly
+    /// unaligned) data of the given sample frame.
+    char const * frame( unsigned int const position ) const { return pData_ + static_cast<std::size_t>( position ) * bytesPerFrame(); }
+    /// @}
+
+    /// <B>Effect:</B> Converts up to <VAR>numberOfSampleFrames</VAR> frames,
+    /// starting at <VAR>position</VAR>, to interleaved float samples
+    /// (stateless, any number of threads may read concurrently).<BR>
+    /// \return The number of sample frames converted.
+    unsigned int read( float * const pOutput, unsigned int const position, unsigned int const numberOfSampleFrames ) const
+    {
+        if ( position >= numberOfSampleFrames_ )
+            return 0;
+        unsigned int const frames( std::min( numberOfSampleFrames, numberOfSampleFrames_ - position ) );
+        convert( frame( position ), pOutput, frames * numberOfChannels_, format_ );
+        return frames;
+    }
+
+    /// <B>Effect:</B> Hints the OS that the given window will be needed soon
+    /// (e.g. before random access to a new position).<BR>
+    void willNeed( unsigned int const position, unsigned int const numberOfSampleFrames ) const { advise( position, numberOfSampleFrames, willNeedHint ); }
+
+    unsigned short numberOfChannels() const { return numberOfChannels_    ; }
+    unsigned int   sampleRate      () const { return sampleRate_          ; }
+    unsigned int   lengthInSamples () const { return numberOfSampleFrames_; }
+
+    bool operator!() const { return !pData_; }
+
+private:
+    enum Advice { sequential, willNeedHint };
+
+    template <typename T>
+    static T load( char const * const pData ) { T value; std::memcpy( &value, pData, sizeof( value ) ); return value; }
+
+    /// <B>Effect:</B> Converts native (little endian) samples to float.<BR>
+    /// \details The loops are written so that compilers vectorize all of
+    /// them (restrict qualified pointers, unaligned loads through memcpy and
+    /// 24 bit samples loaded as overlapping 32 bit words).
+    static void convert( char const * LE_RESTRICT const pInput, float * LE_RESTRICT const pOutput, unsigned int const samples, SampleFormat const format )
+    {
+        switch ( format )
+        {
+            case UInt8:
+                for ( unsigned int sample( 0 ); sample < samples; ++sample )
+                    pOutput[ sample ] = ( static_cast<unsigned char>( pInput[ sample ] ) - 128 ) * ( 1.0f / 128 );
+                break;
+            case Int16:
+            {
+                // WAVE chunks are word aligned.
+                std::int16_t const * LE_RESTRICT const pSamples( reinterpret_cast<std::int16_t const *>( pInput ) );
+                for ( unsigned int sample( 0 ); sample < samples; ++sample )
+                    pOutput[ sample ] = pSamples[ sample ] * ( 1.0f / 32768 );
+                break;
+            }
+            case Int24:
+            {
+                // The last sample is converted separately so that the
+                // overlapping loads never read past the end of the data.
+                unsigned int const overlapping( samples ? samples - 1 : 0 );
+                for ( unsigned int sample( 0 ); sample < overlapping; ++sample )
+                {
+                    std::uint32_t const word( load<std::uint32_t>( &pInput[ sample * 3 ] ) );
+                    pOutput[ sample ] = ( static_cast<std::int32_t>( word << 8 ) >> 8 ) * ( 1.0f / 8388608 );
+                }
+                if ( samples )
+                {
+                    unsigned char const * const pSample( reinterpret_cast<unsigned char const *>( &pInput[ overlapping * 3 ] ) );
+                    std::int32_t const value( static_cast<std::int32_t>( ( pSample[ 0 ] << 8 ) | ( pSample[ 1 ] << 16 ) | ( static_cast<std::uint32_t>( pSample[ 2 ] ) << 24 ) ) >> 8 );
+                    pOutput[ overlapping ] = value * ( 1.0f / 8388608 );
+                }
+                break;
+            }
+            case Int32:
+                for ( unsigned int sample( 0 ); sample < samples; ++sample )
+                    pOutput[ sample ] = static_cast<float>( load<std::int32_t>( &pInput[ sample * 4 ] ) * ( 1.0 / 2147483648.0 ) );
+                break;
+            case Float32:
+                std::memcpy( pOutput, pInput, samples * sizeof( float ) );
+                break;
+            case Float64:
+                for ( unsigned int sample( 0 ); sample < samples; ++sample )
+                    pOutput[ sample ] = static_cast<float>( load<double>( &pInput[ sample * 8 ] ) );
+                break;
+        }
+    }
+
+private:
+
+    char const * parse()
+    {
+        char const * const pBegin( mapping_.begin() );
+        char const * const pEnd  ( mapping_.end  () );
+        if ( pEnd - pBegin < 12 || std::memcmp( pBegin, "RIFF", 4 ) || std::memcmp( pBegin + 8, "WAVE", 4 ) )
+            return "Not a WAVE file.";
+
+        bool fmtFound( false );
+        for ( char const * pChunk( pBegin + 12 ); pEnd - pChunk >= 8; )
+        {
+            std::uint32_t const chunkSize( load<std::uint32_t>( pChunk + 4 )                            );
+            char const *  const pPayload ( pChunk + 8                                                  );
+            std::size_t   const available( static_cast<std::size_t>( pEnd - pPayload )                );
+            std::size_t   const size     ( std::min<std::size_t>( chunkSize, available )               );
+            if ( !std::memcmp( pChunk, "fmt ", 4 ) && size >= 16 )
+            {
+                std::uint16_t formatTag    ( load<std::uint16_t>( pPayload      ) );
+                numberOfChannels_ =          load<std::uint16_t>( pPayload +  2 );
+                sampleRate_       =          load<std::uint32_t>( pPayload +  4 );
+                unsigned int const bits    ( load<std::uint16_t>( pPayload + 14 ) );
+                std::uint16_t const extensible( 0xFFFE );
+                if ( formatTag == extensible && size >= 26 )
+                    formatTag = load<std::uint16_t>( pPayload + 24 ); // the first two bytes of the subformat GUID
+                bytesPerSample_ = bits / 8;
+                switch ( formatTag * 100 + bits )
+                {
+                    case 1 * 100 +  8: format_ = UInt8  ; break;
+                    case 1 * 100 + 16: format_ = Int16  ; break;
+                    case 1 * 100 + 24: format_ = Int24  ; break;
+                    case 1 * 100 + 32: format_ = Int32  ; break;
+                    case 3 * 100 + 32: format_ = Float32; break;
+                    case 3 * 100 + 64: format_ = Float64; break;
+                    default: return "Unsupported WAVE sample format.";
+                }
+                fmtFound = true;
+            }
+            else if ( !std::memcmp( pChunk, "data", 4 ) )
+            {
+                if ( !fmtFound || !numberOfChannels_ )
+                    return "Corrupt WAVE file.";
+                pData_                = pPayload;
+                numberOfSampleFrames_ = static_cast<unsigned int>( size / bytesPerFrame() );
+                return nullptr;
+            }
+            pChunk = pPayload + size + ( size & 1 ); // chunks are word aligned
+        }
+        return "Corrupt WAVE file.";
+    }
+
+    void advise( unsigned int const position, unsigned int const numberOfSampleFrames, Advice const advice ) const
+    {
+    #ifndef _WIN32
+        if ( !pData_ || position >= numberOfSampleFrames_ )
+            return;
+        std::size_t const pageSize( static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) ) );
+        std::uintptr_t const begin( reinterpret_cast<std::uintptr_t>( frame( position ) ) & ~( pageSize - 1 ) );
+        std::uintptr_t const end  ( reinterpret_cast<std::uintptr_t>( frame( position + std::min( numberOfSampleFrames, numberOfSampleFrames_ - position ) ) ) );
+        ::madvise( reinterpret_cast<void *>( begin ), end - begin, advice == sequential ? MADV_SEQUENTIAL : MADV_WILLNEED );
+    #else
+        (void)position; (void)numberOfSampleFrames; (void)advice;
+    #endif // _WIN32
+    }
+
+private: // noncopyable
+    MappedWaveFile( MappedWaveFile const & );
+    void operator=( MappedWaveFile const & );
+
+private:
+    Utility::File::MemoryMapping mapping_;
+
+    char const *   pData_               ;
+    SampleFormat   format_              ;
+    unsigned short numberOfChannels_    ;
+    unsigned int   sampleRate_          ;
+    unsigned int   bytesPerSample_      ;
+    unsigned int   numberOfSampleFrames_;
+}; // class MappedWaveFile
+
+/// @} // group AudioIO
+
+//------------------------------------------------------------------------------
+} // namespace AudioIO
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // mappedWaveFile_hpp
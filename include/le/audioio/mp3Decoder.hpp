@@ -0,0 +1,1430 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file mp3Decoder.hpp
+/// --------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef mp3Decoder_hpp__E2A6C1F8_4B07_4D39_9F5A_83D1B7E04C62
+#define mp3Decoder_hpp__E2A6C1F8_4B07_4D39_9F5A_83D1B7E04C62
+#pragma once
+//------------------------------------------------------------------------------
+#include "bitReader.hpp"
+
+#include "le/utility/abi.hpp"
+#include "le/utility/assert.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace AudioIO
+{
+//------------------------------------------------------------------------------
+
+namespace Detail
+{
+    ////////////////////////////////////////////////////////////////////////////
+    // Constant MPEG-1/2/2.5 Layer III tables (ISO/IEC 11172-3 and 13818-3),
+    // built once, on first use.
+    ////////////////////////////////////////////////////////////////////////////
+
+    struct MP3Tables
+    {
+        static MP3Tables const & get() { static MP3Tables const tables; return tables; }
+
+        enum
+        {
+            maximumQuantized   = 15 + 8191, // largest escaped value (13 linbits)
+            huffmanTableSize   = 7522    , // 8 bit root tables plus the subtables of the longer codes
+            noHuffmanTable     = 0xFFFF
+        };
+
+        float         pow43          [ maximumQuantized + 1 ]; // x^(4/3)
+        std::uint32_t huffman        [ huffmanTableSize     ]; // symbol | total length << 8 or subtable | bits << 16 | 1 << 31
+        std::uint16_t huffmanRoot    [ 32                   ]; // per table_select
+        unsigned char linbits        [ 32                   ];
+        unsigned char count1A        [ 64                   ]; // 6 bit lookup: vwxy | length << 4
+        std::uint16_t longBands      [ 9 ][ 23              ]; // band boundaries (lines) per sample rate index
+        std::uint16_t shortBands     [ 9 ][ 14              ]; // (per window)
+        float         imdct36        [ 18 ][ 20             ]; // 18 distinct outputs (the others follow by symmetry, padded for SIMD)
+        float         imdct12        [ 6 ][ 12              ];
+        float         longWindows    [ 4 ][ 36              ]; // per block type (2 is unused)
+        float         shortWindow    [ 12                   ];
+        float         antialiasCS    [ 8                    ];
+        float         antialiasCA    [ 8                    ];
+        float         dctFactors     [ 31                   ]; // synthesis matrixing (see MP3DCT)
+        float         synthesisWindow[ 512                  ];
+        float         intensityMPEG1 [ 2 ][ 7               ]; // [left/right][position]
+        float         intensityLSF   [ 2 ][ 2 ][ 16         ]; // [intensity_scale][left/right][position]
+
+    private:
+        MP3Tables()
+        {
+            double const pi( 3.14159265358979323846 );
+
+            for ( unsigned int value( 0 ); value <= maximumQuantized; ++value )
+                pow43[ value ] = static_cast<float>( std::pow( static_cast<double>( value ), 4.0 / 3.0 ) );
+
+            // The big value Huffman tables 1, 2, 3, 5 - 13, 15, 16 (also used
+            // by 17 - 23) and 24 (also used by 25 - 31) as code length << 8 |
+            // x << 4 | y entries listed in code order: each code is the
+            // previous one plus one (left aligned to its own length), the
+            // first one is all zeros.
+            static std::uint16_t const codes[] =
+            {
+            // table 1
+            0x0311, 0x0301, 0x0210, 0x0100,
+            // table 2
+            0x0622, 0x0602, 0x0512, 0x0521, 0x0520, 0x0311, 0x0301, 0x0310, 0x0100,
+            // table 3
+            0x0622, 0x0602, 0x0512, 0x0521, 0x0520, 0x0310, 0x0211, 0x0201, 0x0200,
+            // table 5
+            0x0833, 0x0823, 0x0732, 0x0631, 0x0713, 0x0703, 0x0730, 0x0722, 0x0612, 0x0621, 0x0602, 0x0620, 0x0311, 0x0301, 0x0310, 0x0100,
+            // table 6
+            0x0733, 0x0703, 0x0623, 0x0632, 0x0630, 0x0513, 0x0531, 0x0522, 0x0502, 0x0412, 0x0421, 0x0420, 0x0301, 0x0211, 0x0310, 0x0300,
+            // table 7
+            0x0A55, 0x0A45, 0x0A54, 0x0A53, 0x0935, 0x0944, 0x0925, 0x0952, 0x0815, 0x0851, 0x0905, 0x0934, 0x0850, 0x0943, 0x0933, 0x0824,
+            0x0842, 0x0714, 0x0741, 0x0740, 0x0804, 0x0823, 0x0832, 0x0803, 0x0713, 0x0731, 0x0730, 0x0722, 0x0612, 0x0521, 0x0602, 0x0620,
+            0x0411, 0x0301, 0x0310, 0x0100,
+            // table 8
+            0x0B55, 0x0B54, 0x0A45, 0x0953, 0x0A35, 0x0A44, 0x0925, 0x0952, 0x0905, 0x0815, 0x0851, 0x0934, 0x0943, 0x0950, 0x0933, 0x0824,
+            0x0842, 0x0814, 0x0741, 0x0804, 0x0840, 0x0823, 0x0832, 0x0813, 0x0831, 0x0803, 0x0830, 0x0622, 0x0602, 0x0620, 0x0412, 0x0421,
+            0x0211, 0x0301, 0x0310, 0x0200,
+            // table 9
+            0x0955, 0x0945, 0x0835, 0x0853, 0x0954, 0x0905, 0x0844, 0x0825, 0x0852, 0x0815, 0x0751, 0x0734, 0x0743, 0x0850, 0x0804, 0x0724,
+            0x0742, 0x0733, 0x0740, 0x0614, 0x0641, 0x0623, 0x0632, 0x0513, 0x0531, 0x0603, 0x0630, 0x0522, 0x0502, 0x0412, 0x0421, 0x0420,
+            0x0311, 0x0301, 0x0310, 0x0300,
+            // table 10
+            0x0B77, 0x0B67, 0x0B76, 0x0B57, 0x0B75, 0x0B66, 0x0A47, 0x0A74, 0x0A56, 0x0A65, 0x0A37, 0x0A73, 0x0A46, 0x0B55, 0x0B54, 0x0A63,
+            0x0927, 0x0972, 0x0A64, 0x0A07, 0x0970, 0x0962, 0x0A45, 0x0A35, 0x0906, 0x0A53, 0x0A44, 0x0817, 0x0871, 0x0936, 0x0926, 0x0A25,
+            0x0A52, 0x0915, 0x0951, 0x0A34, 0x0A43, 0x0816, 0x0861, 0x0860, 0x0905, 0x0950, 0x0924, 0x0942, 0x0933, 0x0904, 0x0814, 0x0841,
+            0x0840, 0x0823, 0x0832, 0x0803, 0x0713, 0x0731, 0x0730, 0x0722, 0x0612, 0x0621, 0x0602, 0x0620, 0x0411, 0x0301, 0x0310, 0x0100,
+            // table 11
+            0x0A77, 0x0A67, 0x0A76, 0x0A75, 0x0A66, 0x0A47, 0x0A74, 0x0B57, 0x0B55, 0x0A56, 0x0A65, 0x0937, 0x0973, 0x0946, 0x0A45, 0x0A54,
+            0x0A35, 0x0A53, 0x0827, 0x0872, 0x0964, 0x0907, 0x0771, 0x0817, 0x0870, 0x0836, 0x0863, 0x0860, 0x0944, 0x0925, 0x0952, 0x0905,
+            0x0815, 0x0762, 0x0826, 0x0806, 0x0716, 0x0761, 0x0851, 0x0834, 0x0850, 0x0943, 0x0933, 0x0824, 0x0842, 0x0814, 0x0841, 0x0804,
+            0x0840, 0x0723, 0x0732, 0x0613, 0x0631, 0x0703, 0x0730, 0x0622, 0x0521, 0x0412, 0x0502, 0x0520, 0x0311, 0x0301, 0x0310, 0x0200,
+            // table 12
+            0x0A77, 0x0A67, 0x0976, 0x0957, 0x0975, 0x0966, 0x0947, 0x0974, 0x0965, 0x0856, 0x0837, 0x0973, 0x0955, 0x0827, 0x0872, 0x0846,
+            0x0864, 0x0817, 0x0871, 0x0907, 0x0970, 0x0836, 0x0863, 0x0845, 0x0854, 0x0844, 0x0906, 0x0905, 0x0726, 0x0762, 0x0761, 0x0816,
+            0x0860, 0x0835, 0x0853, 0x0825, 0x0852, 0x0715, 0x0751, 0x0734, 0x0743, 0x0850, 0x0804, 0x0724, 0x0742, 0x0714, 0x0633, 0x0641,
+            0x0623, 0x0632, 0x0740, 0x0703, 0x0630, 0x0513, 0x0531, 0x0522, 0x0412, 0x0421, 0x0502, 0x0520, 0x0400, 0x0311, 0x0301, 0x0310,
+            // table 13
+            0x13FE, 0x13FC, 0x12FD, 0x11ED, 0x10FF, 0x10EF, 0x10DF, 0x10EE, 0x10CF, 0x10DE, 0x10BF, 0x10FB, 0x10CE, 0x10DC, 0x11AF, 0x11E9,
+            0x0FEC, 0x0FDD, 0x10FA, 0x10CD, 0x0FBE, 0x0FEB, 0x0F9F, 0x0FF9, 0x0FEA, 0x0FBD, 0x0FDB, 0x0F8F, 0x0FF8, 0x0FCC, 0x10AE, 0x109E,
+            0x0F8E, 0x107F, 0x107E, 0x0EF7, 0x0EDA, 0x0FAD, 0x0FBC, 0x0FCB, 0x0FF6, 0x0E6F, 0x0EE8, 0x0E5F, 0x0E9D, 0x0ED9, 0x0EF5, 0x0EE7,
+            0x0EAC, 0x0EBB, 0x0E4F, 0x0EF4, 0x0FCA, 0x0FE6, 0x0EF3, 0x0D3F, 0x0E8D, 0x0ED8, 0x0D2F, 0x0DF2, 0x0E6E, 0x0E9C, 0x0D0F, 0x0EC9,
+            0x0E5E, 0x0DAB, 0x0E7D, 0x0ED7, 0x0D4E, 0x0EC8, 0x0ED6, 0x0D3E, 0x0DB9, 0x0E9B, 0x0EAA, 0x0C1F, 0x0CF1, 0x0CF0, 0x0DBA, 0x0DE5,
+            0x0DE4, 0x0D8C, 0x0D6D, 0x0DE3, 0x0CE2, 0x0D2E, 0x0D0E, 0x0C1E, 0x0CE1, 0x0DE0, 0x0D5D, 0x0DD5, 0x0D7C, 0x0DC7, 0x0D4D, 0x0D8B,
+            0x0DB8, 0x0DD4, 0x0D9A, 0x0DA9, 0x0D6C, 0x0CC6, 0x0C3D, 0x0DD3, 0x0D7B, 0x0C2D, 0x0CD2, 0x0C1D, 0x0CB7, 0x0D5C, 0x0DC5, 0x0D99,
+            0x0D7A, 0x0CC3, 0x0DA7, 0x0D97, 0x0C4B, 0x0BD1, 0x0C0D, 0x0CD0, 0x0C8A, 0x0CA8, 0x0C4C, 0x0CC4, 0x0C6B, 0x0CB6, 0x0B3C, 0x0B2C,
+            0x0BC2, 0x0B5B, 0x0CB5, 0x0C89, 0x0B1C, 0x0BC1, 0x0C98, 0x0C0C, 0x0BC0, 0x0CB4, 0x0C6A, 0x0CA6, 0x0C79, 0x0B3B, 0x0BB3, 0x0C88,
+            0x0C5A, 0x0B2B, 0x0CA5, 0x0C69, 0x0BA4, 0x0C78, 0x0C87, 0x0B94, 0x0C77, 0x0C76, 0x0AB2, 0x0A1B, 0x0AB1, 0x0B0B, 0x0BB0, 0x0B96,
+            0x0B4A, 0x0B3A, 0x0BA3, 0x0B59, 0x0B95, 0x0A2A, 0x0AA2, 0x0A1A, 0x0AA1, 0x0B0A, 0x0B68, 0x0AA0, 0x0B86, 0x0B49, 0x0A93, 0x0B39,
+            0x0B58, 0x0B85, 0x0B67, 0x0A29, 0x0A92, 0x0B57, 0x0B75, 0x0A38, 0x0A83, 0x0B66, 0x0B47, 0x0B74, 0x0B56, 0x0B65, 0x0B73, 0x0919,
+            0x0991, 0x0A09, 0x0A90, 0x0A48, 0x0A84, 0x0A72, 0x0B46, 0x0B64, 0x0928, 0x0982, 0x0918, 0x0A37, 0x0A27, 0x0917, 0x0971, 0x0A55,
+            0x0A07, 0x0A70, 0x0A36, 0x0A63, 0x0A45, 0x0A54, 0x0A26, 0x0A62, 0x0A35, 0x0881, 0x0908, 0x0980, 0x0916, 0x0961, 0x0906, 0x0960,
+            0x0A53, 0x0A44, 0x0925, 0x0952, 0x0905, 0x0815, 0x0851, 0x0934, 0x0943, 0x0950, 0x0924, 0x0942, 0x0933, 0x0814, 0x0741, 0x0804,
+            0x0840, 0x0823, 0x0832, 0x0713, 0x0731, 0x0703, 0x0730, 0x0722, 0x0612, 0x0621, 0x0602, 0x0620, 0x0411, 0x0401, 0x0310, 0x0100,
+            // table 15
+            0x0DFF, 0x0DEF, 0x0DFE, 0x0DDF, 0x0CEE, 0x0DFD, 0x0DCF, 0x0DFC, 0x0DDE, 0x0DED, 0x0DBF, 0x0CFB, 0x0DCE, 0x0DEC, 0x0CDD, 0x0CAF,
+            0x0CFA, 0x0CBE, 0x0CEB, 0x0CCD, 0x0CDC, 0x0C9F, 0x0CF9, 0x0CEA, 0x0CBD, 0x0CDB, 0x0C8F, 0x0CF8, 0x0CCC, 0x0C9E, 0x0CE9, 0x0C7F,
+            0x0CF7, 0x0CAD, 0x0CDA, 0x0CBC, 0x0C6F, 0x0DAE, 0x0D0F, 0x0BCB, 0x0BF6, 0x0C8E, 0x0CE8, 0x0C5F, 0x0C9D, 0x0BF5, 0x0B7E, 0x0BE7,
+            0x0BAC, 0x0BCA, 0x0BBB, 0x0CD9, 0x0C8D, 0x0B4F, 0x0BF4, 0x0B3F, 0x0BF3, 0x0BD8, 0x0BE6, 0x0B2F, 0x0BF2, 0x0C6E, 0x0CF0, 0x0B1F,
+            0x0BF1, 0x0B9C, 0x0BC9, 0x0B5E, 0x0BAB, 0x0BBA, 0x0BE5, 0x0B7D, 0x0BD7, 0x0B4E, 0x0BE4, 0x0B8C, 0x0BC8, 0x0B3E, 0x0B6D, 0x0BD6,
+            0x0BE3, 0x0B9B, 0x0BB9, 0x0B2E, 0x0BAA, 0x0BE2, 0x0B1E, 0x0BE1, 0x0C0E, 0x0CE0, 0x0B5D, 0x0BD5, 0x0B7C, 0x0BC7, 0x0B4D, 0x0B8B,
+            0x0AD4, 0x0BB8, 0x0B9A, 0x0BA9, 0x0B6C, 0x0BC6, 0x0B3D, 0x0AD3, 0x0AD2, 0x0B2D, 0x0B0D, 0x0A1D, 0x0A7B, 0x0AB7, 0x0AD1, 0x0B5C,
+            0x0BD0, 0x0AC5, 0x0A8A, 0x0AA8, 0x0A4C, 0x0AC4, 0x0A6B, 0x0AB6, 0x0B99, 0x0B0C, 0x0A3C, 0x0AC3, 0x0A7A, 0x0AA7, 0x0AA6, 0x0BC0,
+            0x0B0B, 0x09C2, 0x0A2C, 0x0A5B, 0x0AB5, 0x0A1C, 0x0A89, 0x0A98, 0x0AC1, 0x0A4B, 0x0AB4, 0x0A6A, 0x0A3B, 0x0A79, 0x09B3, 0x0A97,
+            0x0A88, 0x0A2B, 0x0A5A, 0x09B2, 0x0AA5, 0x0A1B, 0x09B1, 0x0AB0, 0x0A69, 0x0A96, 0x0A4A, 0x0AA4, 0x0A78, 0x0A87, 0x0A3A, 0x09A3,
+            0x0959, 0x0995, 0x092A, 0x09A2, 0x091A, 0x09A1, 0x0A0A, 0x0AA0, 0x0968, 0x0986, 0x0949, 0x0994, 0x0939, 0x0993, 0x0A77, 0x0A09,
+            0x0958, 0x0985, 0x0929, 0x0967, 0x0976, 0x0992, 0x0891, 0x0919, 0x0990, 0x0948, 0x0984, 0x0957, 0x0975, 0x0938, 0x0983, 0x0966,
+            0x0947, 0x0828, 0x0882, 0x0818, 0x0881, 0x0974, 0x0908, 0x0980, 0x0956, 0x0965, 0x0937, 0x0973, 0x0946, 0x0827, 0x0872, 0x0864,
+            0x0817, 0x0855, 0x0871, 0x0907, 0x0970, 0x0836, 0x0863, 0x0845, 0x0854, 0x0826, 0x0862, 0x0816, 0x0906, 0x0960, 0x0835, 0x0761,
+            0x0853, 0x0844, 0x0725, 0x0752, 0x0715, 0x0751, 0x0805, 0x0850, 0x0734, 0x0743, 0x0724, 0x0742, 0x0733, 0x0641, 0x0714, 0x0704,
+            0x0623, 0x0632, 0x0740, 0x0703, 0x0613, 0x0631, 0x0630, 0x0522, 0x0512, 0x0521, 0x0502, 0x0520, 0x0311, 0x0401, 0x0410, 0x0300,
+            // table 16
+            0x0BEF, 0x0BFE, 0x0BDF, 0x0BFD, 0x0BCF, 0x0BFC, 0x0BBF, 0x0BFB, 0x0AAF, 0x0BFA, 0x0B9F, 0x0BF9, 0x0BF8, 0x0A8F, 0x0A7F, 0x0AF7,
+            0x0A6F, 0x0AF6, 0x08FF, 0x0A5F, 0x0AF5, 0x094F, 0x09F4, 0x09F3, 0x09F0, 0x0A3F, 0x10CE, 0x11EC, 0x11DD, 0x0FDE, 0x0FE9, 0x10EA,
+            0x10D9, 0x0EEE, 0x0FED, 0x0FEB, 0x0EBE, 0x0ECD, 0x0FDC, 0x0FDB, 0x0EAE, 0x0ECC, 0x0FAD, 0x0FDA, 0x0F7E, 0x0FAC, 0x0ECA, 0x0FC9,
+            0x0F7D, 0x0E5E, 0x0DBD, 0x08F2, 0x092F, 0x090F, 0x081F, 0x08F1, 0x0D9E, 0x0EBC, 0x0ECB, 0x0E8E, 0x0EE8, 0x0E9D, 0x0EE7, 0x0EBB,
+            0x0E8D, 0x0ED8, 0x0E6E, 0x0DE6, 0x0D9C, 0x0EAB, 0x0EBA, 0x0EE5, 0x0ED7, 0x0D4E, 0x0EE4, 0x0E8C, 0x0DC8, 0x0D3E, 0x0D6D, 0x0ED6,
+            0x0E9B, 0x0EB9, 0x0EAA, 0x0DE1, 0x0DD4, 0x0EB8, 0x0EA9, 0x0D7B, 0x0EB7, 0x0ED0, 0x0CE3, 0x0D0E, 0x0DE0, 0x0D5D, 0x0DD5, 0x0D7C,
+            0x0DC7, 0x0D4D, 0x0D8B, 0x0D9A, 0x0D6C, 0x0DC6, 0x0D3D, 0x0D5C, 0x0DC5, 0x0C0D, 0x0D8A, 0x0DA8, 0x0D99, 0x0D4C, 0x0DB6, 0x0D7A,
+            0x0C3C, 0x0D5B, 0x0D89, 0x0C1C, 0x0CC0, 0x0D98, 0x0D79, 0x0BE2, 0x0C2E, 0x0C1E, 0x0CD3, 0x0C2D, 0x0CD2, 0x0CD1, 0x0C3B, 0x0D97,
+            0x0D88, 0x0B1D, 0x0CC4, 0x0C6B, 0x0CC3, 0x0CA7, 0x0B2C, 0x0CC2, 0x0CB5, 0x0CC1, 0x0C0C, 0x0C4B, 0x0CB4, 0x0C6A, 0x0CA6, 0x0BB3,
+            0x0C5A, 0x0CA5, 0x0B2B, 0x0BB2, 0x0B1B, 0x0BB1, 0x0C0B, 0x0CB0, 0x0C69, 0x0C96, 0x0C4A, 0x0CA4, 0x0C78, 0x0C87, 0x0BA3, 0x0C3A,
+            0x0C59, 0x0B2A, 0x0C95, 0x0C68, 0x0BA1, 0x0C86, 0x0C77, 0x0B94, 0x0C49, 0x0C57, 0x0B67, 0x0AA2, 0x0A1A, 0x0B0A, 0x0BA0, 0x0B39,
+            0x0B93, 0x0B58, 0x0B85, 0x0A29, 0x0A92, 0x0B76, 0x0B09, 0x0A19, 0x0A91, 0x0B90, 0x0B48, 0x0B84, 0x0B75, 0x0B38, 0x0B83, 0x0B66,
+            0x0B28, 0x0A82, 0x0B47, 0x0B74, 0x0A18, 0x0A81, 0x0A80, 0x0B08, 0x0B56, 0x0A37, 0x0A73, 0x0B65, 0x0B46, 0x0A27, 0x0A72, 0x0B64,
+            0x0B55, 0x0A07, 0x0917, 0x0971, 0x0A70, 0x0A36, 0x0A63, 0x0A45, 0x0A54, 0x0A26, 0x0962, 0x0916, 0x0961, 0x0A06, 0x0A60, 0x0953,
+            0x0A35, 0x0A44, 0x0925, 0x0952, 0x0851, 0x0915, 0x0905, 0x0934, 0x0943, 0x0950, 0x0924, 0x0942, 0x0933, 0x0814, 0x0841, 0x0904,
+            0x0940, 0x0823, 0x0832, 0x0713, 0x0731, 0x0803, 0x0830, 0x0722, 0x0612, 0x0621, 0x0602, 0x0620, 0x0411, 0x0401, 0x0310, 0x0100,
+            // table 24
+            0x08EF, 0x08FE, 0x08DF, 0x08FD, 0x08CF, 0x08FC, 0x08BF, 0x08FB, 0x07FA, 0x08AF, 0x089F, 0x07F9, 0x07F8, 0x088F, 0x087F, 0x07F7,
+            0x076F, 0x07F6, 0x075F, 0x07F5, 0x074F, 0x07F4, 0x073F, 0x07F3, 0x072F, 0x07F2, 0x07F1, 0x081F, 0x08F0, 0x090F, 0x0BEE, 0x0BDE,
+            0x0BED, 0x0BCE, 0x0BEC, 0x0BDD, 0x0BBE, 0x0BEB, 0x0BCD, 0x0BDC, 0x0BAE, 0x0BEA, 0x0BBD, 0x0BDB, 0x0BCC, 0x0B9E, 0x0BE9, 0x0BAD,
+            0x0BDA, 0x0BBC, 0x0BCB, 0x0B8E, 0x0BE8, 0x0B9D, 0x0BD9, 0x0B7E, 0x0BE7, 0x0BAC, 0x04FF, 0x0BCA, 0x0BBB, 0x0B8D, 0x0BD8, 0x0C0E,
+            0x0CE0, 0x0B0D, 0x0AE6, 0x0B6E, 0x0B9C, 0x0AC9, 0x0A5E, 0x0ABA, 0x0AE5, 0x0BAB, 0x0B7D, 0x0AD7, 0x0AE4, 0x0A8C, 0x0AC8, 0x0B4E,
+            0x0B2E, 0x0A3E, 0x0A6D, 0x0AD6, 0x0AE3, 0x0A9B, 0x0AB9, 0x0AAA, 0x0AE2, 0x0A1E, 0x0AE1, 0x0A5D, 0x0AD5, 0x0A7C, 0x0AC7, 0x0A4D,
+            0x0A8B, 0x0AB8, 0x0AD4, 0x0A9A, 0x0AA9, 0x0A6C, 0x0AC6, 0x0A3D, 0x0AD3, 0x0A2D, 0x0AD2, 0x0A1D, 0x0A7B, 0x0AB7, 0x0AD1, 0x0A5C,
+            0x0AC5, 0x0A8A, 0x0AA8, 0x0A99, 0x0A4C, 0x0AC4, 0x0A6B, 0x0AB6, 0x0BD0, 0x0B0C, 0x0A3C, 0x0AC3, 0x0A7A, 0x0AA7, 0x0A2C, 0x0AC2,
+            0x0A5B, 0x0AB5, 0x0A1C, 0x0A89, 0x0A98, 0x0AC1, 0x0A4B, 0x0BC0, 0x0B0B, 0x0A3B, 0x0BB0, 0x0B0A, 0x0A1A, 0x09B4, 0x0A6A, 0x0AA6,
+            0x0A79, 0x0A97, 0x0BA0, 0x0B09, 0x0A90, 0x09B3, 0x0988, 0x0A2B, 0x0A5A, 0x09B2, 0x0AA5, 0x0A1B, 0x0AB1, 0x0A69, 0x0996, 0x09A4,
+            0x0A4A, 0x0A78, 0x0987, 0x093A, 0x09A3, 0x0959, 0x0995, 0x092A, 0x09A2, 0x09A1, 0x0968, 0x0986, 0x0977, 0x0949, 0x0994, 0x0939,
+            0x0993, 0x0958, 0x0985, 0x0929, 0x0967, 0x0976, 0x0992, 0x0919, 0x0991, 0x0948, 0x0984, 0x0957, 0x0975, 0x0938, 0x0983, 0x0966,
+            0x0928, 0x0982, 0x0918, 0x0947, 0x0974, 0x0981, 0x0A08, 0x0A80, 0x0956, 0x0965, 0x0917, 0x0A07, 0x0A70, 0x0873, 0x0937, 0x0927,
+            0x0872, 0x0846, 0x0864, 0x0855, 0x0871, 0x0836, 0x0863, 0x0845, 0x0854, 0x0826, 0x0862, 0x0816, 0x0861, 0x0906, 0x0960, 0x0835,
+            0x0853, 0x0844, 0x0825, 0x0852, 0x0815, 0x0905, 0x0950, 0x0751, 0x0834, 0x0843, 0x0724, 0x0742, 0x0733, 0x0714, 0x0741, 0x0804,
+            0x0840, 0x0723, 0x0732, 0x0613, 0x0631, 0x0703, 0x0730, 0x0622, 0x0512, 0x0521, 0x0602, 0x0620, 0x0411, 0x0401, 0x0410, 0x0400
+            };
+            static unsigned short const tableSizes [] = { 4, 9, 9, 16, 16, 36, 36, 36, 64, 64, 64, 256, 256, 256, 256 };
+            static unsigned char  const tableSelect[] = { 1, 2, 3,  5,  6,  7,  8,  9, 10, 11, 12,  13,  15,  16,  24 };
+            std::fill_n( huffmanRoot, 32, static_cast<std::uint16_t>( noHuffmanTable ) );
+            unsigned int poolSize( 0 );
+            std::uint16_t const * pCodes( codes );
+            for ( unsigned int table( 0 ); table < sizeof( tableSelect ); pCodes += tableSizes[ table++ ] )
+            {
+                unsigned int const root( poolSize );
+                poolSize += 256;
+                // Subtable sizes: the longest code sharing each 8 bit prefix.
+                unsigned char subtableBits[ 256 ] = { 0 };
+                std::uint32_t code( 0 );
+                for ( unsigned int entry( 0 ); entry < tableSizes[ table ]; ++entry )
+                {
+                    unsigned int const length( pCodes[ entry ] >> 8 );
+                    if ( length > 8 )
+                        subtableBits[ code >> 24 ] = static_cast<unsigned char>( std::max<unsigned int>( subtableBits[ code >> 24 ], length - 8 ) );
+                    code += 1U << ( 32 - length );
+                }
+                for ( unsigned int prefix( 0 ); prefix < 256; ++prefix )
+                {
+                    if ( subtableBits[ prefix ] )
+                    {
+                        huffman[ root + prefix ] = poolSize | ( subtableBits[ prefix ] << 16 ) | 0x80000000U;
+                        poolSize += 1U << subtableBits[ prefix ];
+                    }
+                }
+                code = 0;
+                for ( unsigned int entry( 0 ); entry < tableSizes[ table ]; ++entry )
+                {
+                    unsigned int  const length( pCodes[ entry ] >> 8                                    );
+                    std::uint32_t const leaf  ( ( pCodes[ entry ] & 0xFF ) | ( length << 8 )            );
+                    if ( length <= 8 )
+                    {
+                        std::fill_n( &huffman[ root + ( code >> 24 ) ], 1U << ( 8 - length ), leaf );
+                    }
+                    else
+                    {
+                        std::uint32_t const subtable( huffman[ root + ( code >> 24 ) ] );
+                        unsigned int  const bits    ( ( subtable >> 16 ) & 0xFF        );
+                        std::fill_n( &huffman[ ( subtable & 0xFFFF ) + ( ( code << 8 ) >> ( 32 - bits ) ) ], 1U << ( bits - ( length - 8 ) ), leaf );
+                    }
+                    code += 1U << ( 32 - length );
+                }
+                huffmanRoot[ tableSelect[ table ] ] = static_cast<std::uint16_t>( root );
+            }
+            LE_ASSERT( poolSize == huffmanTableSize );
+            static unsigned char const escapeBits[ 16 ] = { 1, 2, 3, 4, 6, 8, 10, 13, 4, 5, 6, 7, 8, 9, 11, 13 };
+            std::fill_n( linbits, 16, 0 );
+            for ( unsigned int table( 16 ); table < 32; ++table )
+            {
+                huffmanRoot[ table ] = huffmanRoot[ table < 24 ? 16 : 24 ];
+                linbits    [ table ] = escapeBits[ table - 16 ];
+            }
+
+            // Quadruples (count1 table A), indexed by vwxy.
+            static unsigned char const count1Codes  [ 16 ] = { 1, 5, 4, 5, 6, 5, 4, 4, 7, 3, 6, 0, 7, 2, 3, 1 };
+            static unsigned char const count1Lengths[ 16 ] = { 1, 4, 4, 5, 4, 6, 5, 6, 4, 5, 5, 6, 5, 6, 6, 6 };
+            for ( unsigned int value( 0 ); value < 16; ++value )
+                std::fill_n( &count1A[ count1Codes[ value ] << ( 6 - count1Lengths[ value ] ) ], 1U << ( 6 - count1Lengths[ value ] ), static_cast<unsigned char>( value | ( count1Lengths[ value ] << 4 ) ) );
+
+            // Scale factor band widths for 44.1, 48, 32, 22.05, 24, 16,
+            // 11.025, 12 and 8 kHz.
+            static unsigned char const longWidths[ 9 ][ 22 ] =
+            {
+                {  4,  4,  4,  4,  4,  4,  6,  6,  8,  8, 10, 12, 16, 20, 24, 28, 34, 42, 50, 54,  76, 158 },
+                {  4,  4,  4,  4,  4,  4,  6,  6,  6,  8, 10, 12, 16, 18, 22, 28, 34, 40, 46, 54,  54, 192 },
+                {  4,  4,  4,  4,  4,  4,  6,  6,  8, 10, 12, 16, 20, 24, 30, 38, 46, 56, 68, 84, 102,  26 },
+                {  6,  6,  6,  6,  6,  6,  8, 10, 12, 14, 16, 20, 24, 28, 32, 38, 46, 52, 60, 68,  58,  54 },
+                {  6,  6,  6,  6,  6,  6,  8, 10, 12, 14, 16, 18, 22, 26, 32, 38, 46, 54, 62, 70,  76,  36 },
+                {  6,  6,  6,  6,  6,  6,  8, 10, 12, 14, 16, 20, 24, 28, 32, 38, 46, 52, 60, 68,  58,  54 },
+                {  6,  6,  6,  6,  6,  6,  8, 10, 12, 14, 16, 20, 24, 28, 32, 38, 46, 52, 60, 68,  58,  54 },
+                {  6,  6,  6,  6,  6,  6,  8, 10, 12, 14, 16, 20, 24, 28, 32, 38, 46, 52, 60, 68,  58,  54 },
+                { 12, 12, 12, 12, 12, 12, 16, 20, 24, 28, 32, 40, 48, 56, 64, 76, 90,  2,  2,  2,   2,   2 }
+            };
+            static unsigned char const shortWidths[ 9 ][ 13 ] =
+            {
+                { 4, 4, 4,  4,  6,  8, 10, 12, 14, 18, 22, 30, 56 },
+                { 4, 4, 4,  4,  6,  6, 10, 12, 14, 16, 20, 26, 66 },
+                { 4, 4, 4,  4,  6,  8, 12, 16, 20, 26, 34, 42, 12 },
+                { 4, 4, 4,  6,  6,  8, 10, 14, 18, 26, 32, 42, 18 },
+                { 4, 4, 4,  6,  8, 10, 12, 14, 18, 24, 32, 44, 12 },
+                { 4, 4, 4,  6,  8, 10, 12, 14, 18, 24, 30, 40, 18 },
+                { 4, 4, 4,  6,  8, 10, 12, 14, 18, 24, 30, 40, 18 },
+                { 4, 4, 4,  6,  8, 10, 12, 14, 18, 24, 30, 40, 18 },
+                { 8, 8, 8, 12, 16, 20, 24, 28, 36,  2,  2,  2, 26 }
+            };
+            for ( unsigned int rate( 0 ); rate < 9; ++rate )
+            {
+                longBands [ rate ][ 0 ] = 0;
+                shortBands[ rate ][ 0 ] = 0;
+                for ( unsigned int band( 0 ); band < 22; ++band ) longBands [ rate ][ band + 1 ] = static_cast<std::uint16_t>( longBands [ rate ][ band ] + longWidths [ rate ][ band ] );
+                for ( unsigned int band( 0 ); band < 13; ++band ) shortBands[ rate ][ band + 1 ] = static_cast<std::uint16_t>( shortBands[ rate ][ band ] + shortWidths[ rate ][ band ] );
+            }
+
+            // IMDCT: y[ i ] = sum( X[ k ] * cos( pi / 2n * ( 2i + 1 + n / 2 ) * ( 2k + 1 ) ) ).
+            // Of the 36 long block outputs y[ 17 - i ] = -y[ i ] and
+            // y[ 53 - i ] = y[ i ] so only y[ 0 - 8 ] and y[ 18 - 26 ] are
+            // computed.
+            for ( unsigned int k( 0 ); k < 18; ++k )
+            {
+                for ( unsigned int output( 0 ); output < 18; ++output )
+                {
+                    unsigned int const i( output < 9 ? output : output + 9 );
+                    imdct36[ k ][ output ] = static_cast<float>( std::cos( pi / 72 * ( 2 * i + 19 ) * ( 2 * k + 1 ) ) );
+                }
+                imdct36[ k ][ 18 ] = imdct36[ k ][ 19 ] = 0;
+            }
+            for ( unsigned int k( 0 ); k < 6; ++k )
+                for ( unsigned int i( 0 ); i < 12; ++i )
+                    imdct12[ k ][ i ] = static_cast<float>( std::cos( pi / 24 * ( 2 * i + 7 ) * ( 2 * k + 1 ) ) );
+            for ( unsigned int i( 0 ); i < 36; ++i )
+            {
+                float const sine( static_cast<float>( std::sin( pi / 36 * ( i + 0.5 ) ) ) );
+                longWindows[ 0 ][ i ] = sine;
+                longWindows[ 1 ][ i ] = i < 18 ? sine : i < 24 ? 1 : i < 30 ? static_cast<float>( std::sin( pi / 12 * ( i - 18 + 0.5 ) ) ) : 0; // start
+                longWindows[ 2 ][ i ] = 0;
+                longWindows[ 3 ][ i ] = i < 6 ? 0 : i < 12 ? static_cast<float>( std::sin( pi / 12 * ( i - 6 + 0.5 ) ) ) : i < 18 ? 1 : sine; // stop
+            }
+            for ( unsigned int i( 0 ); i < 12; ++i )
+                shortWindow[ i ] = static_cast<float>( std::sin( pi / 12 * ( i + 0.5 ) ) );
+
+            static double const antialias[ 8 ] = { -0.6, -0.535, -0.33, -0.185, -0.095, -0.041, -0.0142, -0.0037 };
+            for ( unsigned int i( 0 ); i < 8; ++i )
+            {
+                double const norm( std::sqrt( 1 + antialias[ i ] * antialias[ i ] ) );
+                antialiasCS[ i ] = static_cast<float>( 1 / norm            );
+                antialiasCA[ i ] = static_cast<float>( antialias[ i ] / norm );
+            }
+
+            // Polyphase synthesis: the 64 matrixing outputs (cos( ( 16 + i ) *
+            // ( 2k + 1 ) * pi / 64 )) are a 32 point DCT-II, rearranged (see
+            // MP3Decoder::synthesize()), and the window is the standard one
+            // (Table 3-B.3) with 16 fractional bits (its odd symmetry stored
+            // once).
+            for ( unsigned int size( 32 ), offset( 0 ); size > 1; offset += size / 2, size /= 2 )
+                for ( unsigned int n( 0 ); n < size / 2; ++n )
+                    dctFactors[ offset + n ] = static_cast<float>( 0.5 / std::cos( pi / size * ( n + 0.5 ) ) );
+            static std::int32_t const window[ 257 ] =
+            {
+            0, -1, -1, -1, -1, -1, -1, -2, -2, -2, -2, -3,
+            -3, -4, -4, -5, -5, -6, -7, -7, -8, -9, -10, -11,
+            -13, -14, -16, -17, -19, -21, -24, -26, -29, -31, -35, -38,
+            -41, -45, -49, -53, -58, -63, -68, -73, -79, -85, -91, -97,
+            -104, -111, -117, -125, -132, -139, -147, -154, -161, -169, -176, -183,
+            -190, -196, -202, -208, 213, 218, 222, 225, 227, 228, 228, 227,
+            224, 221, 215, 208, 200, 189, 177, 163, 146, 127, 106, 83,
+            57, 29, -2, -36, -72, -111, -153, -197, -244, -294, -347, -401,
+            -459, -519, -581, -645, -711, -779, -848, -919, -991, -1064, -1137, -1210,
+            -1283, -1356, -1428, -1498, -1567, -1634, -1698, -1759, -1817, -1870, -1919, -1962,
+            -2001, -2032, -2057, -2075, -2085, -2087, -2080, -2063, 2037, 2000, 1952, 1893,
+            1822, 1739, 1644, 1535, 1414, 1280, 1131, 970, 794, 605, 402, 185,
+            -45, -288, -545, -814, -1095, -1388, -1692, -2006, -2330, -2663, -3004, -3351,
+            -3705, -4063, -4425, -4788, -5153, -5517, -5879, -6237, -6589, -6935, -7271, -7597,
+            -7910, -8209, -8491, -8755, -8998, -9219, -9416, -9585, -9727, -9838, -9916, -9959,
+            -9966, -9935, -9863, -9750, -9592, -9389, -9139, -8840, -8492, -8092, -7640, -7134,
+            6574, 5959, 5288, 4561, 3776, 2935, 2037, 1082, 70, -998, -2122, -3300,
+            -4533, -5818, -7154, -8540, -9975, -11455, -12980, -14548, -16155, -17799, -19478, -21189,
+            -22929, -24694, -26482, -28289, -30112, -31947, -33791, -35640, -37489, -39336, -41176, -43006,
+            -44821, -46617, -48390, -50137, -51853, -53534, -55178, -56778, -58333, -59838, -61289, -62684,
+            -64019, -65290, -66494, -67629, -68692, -69679, -70590, -71420, -72169, -72835, -73415, -73908,
+            -74313, -74630, -74856, -74992, 75038
+            };
+            for ( unsigned int i( 0 ); i < 257; ++i )
+            {
+                float const value( static_cast<float>( window[ i ] ) / 65536 );
+                synthesisWindow[ i ] = value;
+                if ( i && i < 256 )
+                    synthesisWindow[ 512 - i ] = ( i & 63 ) ? -value : value;
+            }
+
+            // Intensity stereo: MPEG-1 ratios tan( position * pi / 12 ) and
+            // MPEG-2 powers of 2^(-1/4) (intensity_scale 0) or 2^(-1/2).
+            for ( unsigned int position( 0 ); position < 7; ++position )
+            {
+                double const ratio( std::tan( position * pi / 12 ) );
+                float  const left ( position == 6 ? 1 : static_cast<float>( ratio / ( 1 + ratio ) ) );
+                intensityMPEG1[ 0 ][ position     ] = left;
+                intensityMPEG1[ 1 ][ 6 - position ] = left;
+            }
+            for ( unsigned int scale( 0 ); scale < 2; ++scale )
+            {
+                for ( unsigned int position( 0 ); position < 16; ++position )
+                {
+                    float const attenuation( static_cast<float>( std::pow( 2.0, -( scale + 1.0 ) * ( ( position + 1 ) / 2 ) / 4 ) ) );
+                    intensityLSF[ scale ][ 0 ][ position ] = ( position & 1 ) ? attenuation : 1;
+                    intensityLSF[ scale ][ 1 ][ position ] = ( position & 1 ) ? 1 : attenuation;
+                }
+            }
+        }
+
+        MP3Tables( MP3Tables const & );
+        void operator=( MP3Tables const & );
+    }; // struct MP3Tables
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Unnormalized DCT-II (X[ k ] = sum( x[ n ] cos( pi / N ( n + 1/2 ) k ) ))
+    // by Lee's recursive decomposition: N log2( N ) / 2 multiplications
+    // instead of N^2.
+    ////////////////////////////////////////////////////////////////////////////
+
+    template <unsigned int size>
+    struct MP3DCT
+    {
+        /// pFactors: 1 / ( 2 cos( pi / size * ( n + 1/2 ) ) ) for n < size / 2
+        /// followed by those of the smaller sizes.
+        static void transform( float const * LE_RESTRICT const pInput, float * LE_RESTRICT const pOutput, float const * LE_RESTRICT const pFactors )
+        {
+            unsigned int const half( size / 2 );
+            float sums[ half ], differences[ half ];
+            for ( unsigned int n( 0 ); n < half; ++n )
+            {
+                sums       [ n ] =   pInput[ n ] + pInput[ size - 1 - n ];
+                differences[ n ] = ( pInput[ n ] - pInput[ size - 1 - n ] ) * pFactors[ n ];
+            }
+            float even[ half ], odd[ half + 1 ];
+            MP3DCT<half>::transform( sums       , even, pFactors + half );
+            MP3DCT<half>::transform( differences, odd , pFactors + half );
+            odd[ half ] = 0;
+            for ( unsigned int k( 0 ); k < half; ++k )
+            {
+                pOutput[ 2 * k     ] = even[ k ];
+                pOutput[ 2 * k + 1 ] = odd [ k ] + odd[ k + 1 ];
+            }
+        }
+    }; // struct MP3DCT
+
+    template <>
+    struct MP3DCT<1>
+    {
+        static void transform( float const * LE_RESTRICT const pInput, float * LE_RESTRICT const pOutput, float const * ) { pOutput[ 0 ] = pInput[ 0 ]; }
+    }; // struct MP3DCT<1>
+} // namespace Detail
+
+/// \addtogroup AudioIO
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class MP3Decoder
+///
+/// \brief Platform independent decoder for MP3 (MPEG-1, MPEG-2 and MPEG-2.5
+/// Layer III) streams held in memory (e.g. a memory mapped file).
+///
+/// Supports all sample rates and bitrates (except free format), mono, dual
+/// channel and (joint) stereo including MS and intensity stereo and mixed
+/// blocks. ID3v2 tags are skipped and the gapless playback information of
+/// the LAME/Xing header (the encoder delay and padding) is applied, as by
+/// the OS decoders and FFmpeg, so lengthInSamples() is exact for files that
+/// carry it (LAME, FFmpeg and most others).
+///
+/// open() indexes the frames (one header lookup per frame, which also
+/// resynchronizes over junk between frames) so seeking is sample exact: the
+/// bit reservoir is refilled from the preceding frames and the decoding is
+/// restarted two granules (one MPEG-1 or two MPEG-2 frames) before the
+/// target, which brings the IMDCT overlap and the synthesis filterbank into
+/// exactly the state of a continuous decode (the output is identical). The
+/// header CRC is not checked and granules with corrupt side information or
+/// missing main data are decoded as silence.
+///
+/// The decoder does not own the data.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class MP3Decoder
+{
+public:
+    MP3Decoder() { close(); }
+
+    /// <B>Effect:</B> Indexes the frames and prepares the decoding of the
+    /// first sample.<BR>
+    /// \return nullptr if successful, pointer to an error message string
+    /// otherwise.
+    char const * open( char const * const pBegin, char const * const pEnd )
+    {
+        close();
+        pBegin_ = reinterpret_cast<unsigned char const *>( pBegin );
+        pEnd_   = reinterpret_cast<unsigned char const *>( pEnd   );
+        if ( static_cast<std::uint64_t>( pEnd_ - pBegin_ ) > UINT_MAX )
+        {
+            close();
+            return "MP3 file too large.";
+        }
+
+        // (Possibly several) ID3v2 tags.
+        unsigned char const * p( pBegin_ );
+        while ( pEnd_ - p >= 10 && !std::memcmp( p, "ID3", 3 ) && !( ( p[ 6 ] | p[ 7 ] | p[ 8 ] | p[ 9 ] ) & 0x80 ) )
+        {
+            std::uint32_t const size( ( p[ 6 ] << 21 ) | ( p[ 7 ] << 14 ) | ( p[ 8 ] << 7 ) | p[ 9 ] );
+            p += std::min<std::uint64_t>( 10 + size + ( ( p[ 5 ] & 0x10 ) ? 10 : 0 ), pEnd_ - p );
+        }
+
+        FrameHeader first;
+        if ( !findFrame( p, 0, first ) )
+        {
+            char const * const pError( unsupportedFormat( p ) );
+            close();
+            return pError;
+        }
+        p = first.pFrame;
+
+        // An Xing/Info (LAME) or VBRI header frame carries no audio.
+        std::uint32_t taggedFrames( 0 );
+        unsigned int  encoderDelay( 0 ), encoderPadding( 0 );
+        bool          gapless     ( false );
+        unsigned char const * const pXing( p + first.sideInfoOffset + first.sideInfoSize );
+        if ( first.size >= first.sideInfoOffset + first.sideInfoSize + 8 && ( !std::memcmp( pXing, "Xing", 4 ) || !std::memcmp( pXing, "Info", 4 ) ) )
+        {
+            std::uint32_t const flags( readBigEndian( pXing + 4 ) );
+            unsigned char const * pField( pXing + 8 );
+            unsigned char const * const pFrameEnd( p + first.size );
+            if ( ( flags & 1 ) && pFrameEnd - pField >= 4 )
+                taggedFrames = readBigEndian( pField );
+            pField += ( ( flags & 1 ) ? 4 : 0 ) + ( ( flags & 2 ) ? 4 : 0 ) + ( ( flags & 4 ) ? 100 : 0 ) + ( ( flags & 8 ) ? 4 : 0 );
+            if ( pFrameEnd - pField >= 24 && ( !std::memcmp( pField, "LAME", 4 ) || !std::memcmp( pField, "Lavf", 4 ) || !std::memcmp( pField, "Lavc", 4 ) ) )
+            {
+                encoderDelay   = ( pField[ 21 ] << 4 ) | ( pField[ 22 ] >> 4 );
+                encoderPadding = ( ( pField[ 22 ] & 0x0F ) << 8 ) | pField[ 23 ];
+                gapless        = true;
+            }
+            p += first.size;
+        }
+        else if ( first.size >= 36 + 4 && !std::memcmp( p + 36, "VBRI", 4 ) )
+        {
+            p += first.size;
+        }
+
+        numberOfFrames_ = scan( p, first.signature, nullptr );
+        if ( !numberOfFrames_ )
+        {
+            close();
+            return "Corrupt MP3 file.";
+        }
+        pFrames_ .reset( new ( std::nothrow ) std::uint32_t[ numberOfFrames_ ] );
+        pBuffers_.reset( new ( std::nothrow ) Buffers                           );
+        if ( !pFrames_ || !pBuffers_ )
+        {
+            close();
+            return "Out of memory.";
+        }
+        scan( p, first.signature, pFrames_.get() );
+
+        numberOfChannels_ = first.mode == 3 ? 1 : 2;
+        sampleRateIndex_  = first.sampleRateIndex;
+        lsf_              = first.lsf;
+        samplesPerFrame_  = lsf_ ? 576 : 1152;
+
+        // Gapless: skip the encoder delay plus the decoder delay (528 + 1
+        // samples) and drop the padding.
+        std::uint64_t const decodedLength( static_cast<std::uint64_t>( numberOfFrames_ ) * samplesPerFrame_ );
+        std::uint64_t       length       ( decodedLength                                                     );
+        if ( gapless )
+        {
+            skip_ = encoderDelay + 528 + 1;
+            std::uint64_t const taggedLength( static_cast<std::uint64_t>( taggedFrames ? taggedFrames : numberOfFrames_ ) * samplesPerFrame_ );
+            length = std::min
+            (
+                taggedLength  > encoderDelay + encoderPadding ? taggedLength  - encoderDelay - encoderPadding : 0,
+                decodedLength > skip_                         ? decodedLength - skip_                         : 0
+            );
+        }
+        length_ = static_cast<unsigned int>( std::min<std::uint64_t>( length, UINT_MAX ) );
+
+        setSamplePosition( 0 );
+        return nullptr;
+    }
+
+    void close()
+    {
+        pFrames_ .reset();
+        pBuffers_.reset();
+        pBegin_           = nullptr;
+        pEnd_             = nullptr;
+        numberOfFrames_   = 0;
+        nextFrame_        = 0;
+        numberOfChannels_ = 0;
+        sampleRateIndex_  = 0;
+        samplesPerFrame_  = 0;
+        lsf_              = false;
+        skip_             = 0;
+        length_           = 0;
+        blockFirstSample_ = 0;
+        blockFrames_      = 0;
+        blockPosition_    = 0;
+    }
+
+    /// <B>Effect:</B> Decodes up to <VAR>numberOfSampleFrames</VAR>
+    /// interleaved sample frames.<BR>
+    /// \return The number of sample frames decoded (less than requested only
+    /// at the end of the stream).
+    unsigned int read( float * const pOutput, unsigned int const numberOfSampleFrames )
+    {
+        unsigned int const channels( numberOfChannels_ );
+        unsigned int frames( 0 );
+        while ( frames < numberOfSampleFrames && position() < length_ )
+        {
+            if ( blockPosition_ == blockFrames_ && !decodeFrame() )
+                break;
+            unsigned int const available( std::min( std::min( numberOfSampleFrames - frames, blockFrames_ - blockPosition_ ), length_ - position() ) );
+            convert( &pOutput[ frames * channels ], available );
+            blockPosition_ += available;
+            frames         += available;
+        }
+        return frames;
+    }
+
+    /// <B>Effect:</B> Sample exact seek.<BR>
+    void setSamplePosition( unsigned int const positionInSampleFrames )
+    {
+        blockFrames_   = 0;
+        blockPosition_ = 0;
+        if ( positionInSampleFrames >= length_ )
+        {
+            nextFrame_        = numberOfFrames_;
+            blockFirstSample_ = static_cast<std::uint64_t>( length_ ) + skip_;
+            return;
+        }
+        Buffers & buffers( *pBuffers_ );
+        std::memset( buffers.overlap  , 0, sizeof( buffers.overlap   ) );
+        std::memset( buffers.synthesis, 0, sizeof( buffers.synthesis ) );
+        buffers.synthesisOffset[ 0 ] = 0;
+        buffers.synthesisOffset[ 1 ] = 0;
+        buffers.reservoirSize        = 0;
+
+        std::uint64_t const target( static_cast<std::uint64_t>( positionInSampleFrames ) + skip_ );
+        std::uint32_t const frame ( static_cast<std::uint32_t>( target / samplesPerFrame_ )     );
+        // Two granules of state (the IMDCT overlap of the preceding granule
+        // which itself depends on the one before) plus the bit reservoir
+        // (at most 511 bytes of the main data of the preceding frames).
+        std::uint32_t const priming( lsf_ ? 2 : 1 );
+        std::uint32_t const start  ( frame > priming ? frame - priming : 0 );
+        std::uint32_t       first  ( start );
+        for ( unsigned int bytes( 0 ); first && bytes < maximumMainDataBegin; )
+        {
+            FrameHeader header;
+            parseHeader( pBegin_ + pFrames_[ --first ], header );
+            bytes += header.size - header.sideInfoOffset - header.sideInfoSize;
+        }
+        for ( ; first < start; ++first )
+        {
+            FrameHeader header;
+            parseHeader( pBegin_ + pFrames_[ first ], header );
+            appendMainData( header );
+        }
+        nextFrame_ = start;
+        while ( nextFrame_ <= frame && decodeFrame() ) {}
+        blockPosition_ = static_cast<unsigned int>( target - blockFirstSample_ );
+    }
+
+    unsigned short numberOfChannels() const { return numberOfChannels_;                                         }
+    unsigned int   sampleRate      () const { return sampleRateIndex_ < 9 ? sampleRates()[ sampleRateIndex_ ] : 0; }
+    unsigned int   lengthInSamples () const { return length_;                                                   }
+
+    /// \return The position of the next decoded sample frame.
+    unsigned int position() const { return static_cast<unsigned int>( blockFirstSample_ + blockPosition_ - skip_ ); }
+
+    bool operator!() const { return !pBuffers_; }
+
+private:
+    enum
+    {
+        maximumMainDataBegin = 511 , // bytes (9 bit main_data_begin)
+        reservoirCapacity    = 2048, // main_data_begin plus the largest frame
+        granuleSize          = 576
+    };
+
+    struct FrameHeader
+    {
+        unsigned char const * pFrame         ;
+        std::uint32_t         signature      ; // the header bits that are constant within a stream
+        unsigned int          size           ;
+        unsigned int          sideInfoOffset ; // header + CRC
+        unsigned int          sideInfoSize   ;
+        unsigned int          sampleRateIndex; // 44.1, 48, 32, 22.05, 24, 16, 11.025, 12, 8 kHz
+        unsigned int          mode           ; // stereo, joint stereo, dual channel, mono
+        unsigned int          modeExtension  ;
+        bool                  lsf            ; // MPEG-2/2.5: one granule per frame
+    }; // struct FrameHeader
+
+    struct Granule
+    {
+        unsigned int part23Length    ;
+        unsigned int bigValues       ;
+        unsigned int globalGain      ;
+        unsigned int scalefacCompress;
+        unsigned int blockType       ; // normal, start, short, stop
+        unsigned int tableSelect     [ 3 ];
+        unsigned int subblockGain    [ 3 ];
+        unsigned int region1Start    ; // lines
+        unsigned int region2Start    ;
+        unsigned int longEnd         ; // long scale factor bands (8 or 6 for mixed blocks)
+        unsigned int shortStart      ; // first short scale factor band (3 for mixed blocks, 13 for long blocks)
+        bool         mixed           ;
+        bool         preflag         ;
+        bool         scalefacScale   ;
+        bool         count1TableB    ;
+    }; // struct Granule
+
+    struct SideInfo
+    {
+        unsigned int mainDataBegin;
+        unsigned int scfsi        [ 2 ];
+        Granule      granules     [ 2 ][ 2 ]; // [granule][channel]
+    }; // struct SideInfo
+
+    struct Buffers
+    {
+        float         block       [ 2 ][ 2 * granuleSize ]; // decoded frame
+        float         spectrum    [ 2 ][ granuleSize     ];
+        float         overlap     [ 2 ][ granuleSize     ]; // IMDCT overlap
+        float         synthesis   [ 2 ][ 2 * 1024        ]; // polyphase FIFO (stored twice for contiguous reads)
+        float         subbands    [ 18 ][ 32             ]; // hybrid filterbank output, time major
+        unsigned char scalefactors[ 2 ][ 40              ]; // long bands then 3 per short band
+        bool          illegal     [ 40                   ]; // MPEG-2 intensity positions of the right channel
+        unsigned char reservoir   [ reservoirCapacity    ];
+        unsigned int  synthesisOffset[ 2 ];
+        unsigned int  reservoirSize        ;
+    }; // struct Buffers
+
+    static unsigned int const * sampleRates()
+    {
+        static unsigned int const rates[ 9 ] = { 44100, 48000, 32000, 22050, 24000, 16000, 11025, 12000, 8000 };
+        return rates;
+    }
+
+    static std::uint32_t readBigEndian( unsigned char const * const p ) { return ( static_cast<std::uint32_t>( p[ 0 ] ) << 24 ) | ( p[ 1 ] << 16 ) | ( p[ 2 ] << 8 ) | p[ 3 ]; }
+
+    /// <B>Effect:</B> Parses the (Layer III, fixed bitrate) frame header at
+    /// <VAR>p</VAR>.<BR>
+    bool parseHeader( unsigned char const * const p, FrameHeader & header ) const
+    {
+        if ( pEnd_ - p < 4 || p[ 0 ] != 0xFF || ( p[ 1 ] & 0xE0 ) != 0xE0 )
+            return false;
+        unsigned int const version     ( ( p[ 1 ] >> 3 ) & 3 ); // 2.5, reserved, 2, 1
+        unsigned int const layer       ( ( p[ 1 ] >> 1 ) & 3 ); // reserved, III, II, I
+        unsigned int const bitrateIndex( p[ 2 ] >> 4         );
+        unsigned int const rateIndex   ( ( p[ 2 ] >> 2 ) & 3 );
+        if ( version == 1 || layer != 1 || !bitrateIndex || bitrateIndex == 15 || rateIndex == 3 || ( p[ 3 ] & 3 ) == 2 )
+            return false;
+        static unsigned short const bitrates[ 2 ][ 15 ] =
+        {
+            { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 },
+            { 0,  8, 16, 24, 32, 40, 48, 56,  64,  80,  96, 112, 128, 144, 160 }
+        };
+        bool         const lsf     ( version != 3                                        );
+        bool         const mono    ( ( p[ 3 ] >> 6 ) == 3                                );
+        unsigned int const rate    ( ( version == 3 ? 0 : version == 2 ? 3 : 6 ) + rateIndex );
+        header.pFrame          = p;
+        header.signature       = ( static_cast<std::uint32_t>( p[ 1 ] & 0xFE ) << 8 ) | ( p[ 2 ] & 0x0C ) | ( mono ? 1 : 0 );
+        header.size            = ( lsf ? 72000 : 144000 ) * bitrates[ lsf ][ bitrateIndex ] / sampleRates()[ rate ] + ( ( p[ 2 ] >> 1 ) & 1 );
+        header.sideInfoOffset  = ( p[ 1 ] & 1 ) ? 4 : 6;
+        header.sideInfoSize    = lsf ? ( mono ? 9 : 17 ) : ( mono ? 17 : 32 );
+        header.sampleRateIndex = rate;
+        header.mode            = p[ 3 ] >> 6;
+        header.modeExtension   = ( p[ 3 ] >> 4 ) & 3;
+        header.lsf             = lsf;
+        return header.size > header.sideInfoOffset + header.sideInfoSize;
+    }
+
+    /// <B>Effect:</B> Finds the first frame at or after <VAR>p</VAR> (with
+    /// the given signature unless zero) that is followed by another such
+    /// frame (or ends the data).<BR>
+    bool findFrame( unsigned char const * p, std::uint32_t const signature, FrameHeader & header ) const
+    {
+        for ( ; p < pEnd_; ++p )
+        {
+            p = static_cast<unsigned char const *>( std::memchr( p, 0xFF, pEnd_ - p ) );
+            if ( !p )
+                return false;
+            FrameHeader next;
+            if
+            (
+                parseHeader( p, header ) && ( !signature || header.signature == signature ) && header.size <= static_cast<std::size_t>( pEnd_ - p ) &&
+                ( p + header.size == pEnd_ || ( parseHeader( p + header.size, next ) && next.signature == header.signature ) )
+            )
+                return true;
+        }
+        return false;
+    }
+
+    /// <B>Effect:</B> Counts (and stores the offsets of, if
+    /// <VAR>pOffsets</VAR> is not null) the consecutive frames from
+    /// <VAR>p</VAR> on, skipping over junk (and tags) between them.<BR>
+    std::uint32_t scan( unsigned char const * p, std::uint32_t const signature, std::uint32_t * const pOffsets ) const
+    {
+        std::uint32_t count( 0 );
+        FrameHeader header;
+        while ( p < pEnd_ )
+        {
+            if ( !parseHeader( p, header ) || header.signature != signature || header.size > static_cast<std::size_t>( pEnd_ - p ) )
+            {
+                if ( !findFrame( p + 1, signature, header ) )
+                    break;
+                p = header.pFrame;
+            }
+            if ( pOffsets )
+                pOffsets[ count ] = static_cast<std::uint32_t>( p - pBegin_ );
+            ++count;
+            p += header.size;
+        }
+        return count;
+    }
+
+    char const * unsupportedFormat( unsigned char const * const p ) const
+    {
+        if ( pEnd_ - p >= 4 && p[ 0 ] == 0xFF && ( p[ 1 ] & 0xE0 ) == 0xE0 )
+        {
+            if ( ( ( p[ 1 ] >> 1 ) & 3 ) != 1 )
+                return "Unsupported MPEG audio format (only Layer III/MP3 is supported).";
+            if ( !( p[ 2 ] >> 4 ) )
+                return "Unsupported MP3 file (free format).";
+        }
+        return "Corrupt MP3 file.";
+    }
+
+    bool parseSideInfo( FrameHeader const & header, SideInfo & side )
+    {
+        reader_.reset( header.pFrame + header.sideInfoOffset, header.pFrame + header.sideInfoOffset + header.sideInfoSize );
+        unsigned int const channels( numberOfChannels_ );
+        if ( !lsf_ )
+        {
+            side.mainDataBegin = reader_.read( 9 );
+            reader_.read( channels == 1 ? 5 : 3 );
+            for ( unsigned int channel( 0 ); channel < channels; ++channel )
+                side.scfsi[ channel ] = reader_.read( 4 );
+        }
+        else
+        {
+            side.mainDataBegin = reader_.read( 8 );
+            reader_.read( channels == 1 ? 1 : 2 );
+            side.scfsi[ 0 ] = side.scfsi[ 1 ] = 0;
+        }
+
+        Detail::MP3Tables const & tables( Detail::MP3Tables::get() );
+        bool const lowestRate( sampleRateIndex_ == 8 );
+        bool valid( true );
+        for ( unsigned int granule( 0 ); granule < ( lsf_ ? 1U : 2U ); ++granule )
+        {
+            for ( unsigned int channel( 0 ); channel < channels; ++channel )
+            {
+                Granule & g( side.granules[ granule ][ channel ] );
+                g.part23Length     = reader_.read( 12 );
+                g.bigValues        = reader_.read( 9  );
+                g.globalGain       = reader_.read( 8  );
+                g.scalefacCompress = reader_.read( lsf_ ? 9 : 4 );
+                if ( reader_.read( 1 ) ) // window switching
+                {
+                    g.blockType         = reader_.read( 2 );
+                    g.mixed             = reader_.read( 1 ) && g.blockType == 2;
+                    g.tableSelect [ 0 ] = reader_.read( 5 );
+                    g.tableSelect [ 1 ] = reader_.read( 5 );
+                    g.tableSelect [ 2 ] = 0;
+                    g.subblockGain[ 0 ] = reader_.read( 3 );
+                    g.subblockGain[ 1 ] = reader_.read( 3 );
+                    g.subblockGain[ 2 ] = reader_.read( 3 );
+                    g.region1Start      = g.blockType == 2 ? ( lowestRate ? 72 : 36 ) : ( !lsf_ ? 36 : lowestRate ? 108 : 54 );
+                    g.region2Start      = granuleSize;
+                    valid               = valid && g.blockType != 0;
+                }
+                else
+                {
+                    g.blockType        = 0;
+                    g.mixed            = false;
+                    g.tableSelect[ 0 ] = reader_.read( 5 );
+                    g.tableSelect[ 1 ] = reader_.read( 5 );
+                    g.tableSelect[ 2 ] = reader_.read( 5 );
+                    unsigned int const region0Count( reader_.read( 4 ) );
+                    unsigned int const region1Count( reader_.read( 3 ) );
+                    g.region1Start = tables.longBands[ sampleRateIndex_ ][ std::min( region0Count + 1               , 22U ) ];
+                    g.region2Start = tables.longBands[ sampleRateIndex_ ][ std::min( region0Count + region1Count + 2, 22U ) ];
+                }
+                g.preflag       = !lsf_ && reader_.read( 1 );
+                g.scalefacScale = reader_.read( 1 ) != 0;
+                g.count1TableB  = reader_.read( 1 ) != 0;
+                g.longEnd       = g.blockType != 2 ? 22 : g.mixed ? ( sampleRateIndex_ <= 2 ? 8 : 6 ) : 0;
+                g.shortStart    = g.blockType != 2 ? 13 : g.mixed ? 3 : 0;
+                for ( unsigned int region( 0 ); region < 3; ++region )
+                    valid = valid && ( !g.tableSelect[ region ] || tables.huffmanRoot[ g.tableSelect[ region ] ] != Detail::MP3Tables::noHuffmanTable );
+                valid = valid && g.bigValues <= granuleSize / 2;
+            }
+        }
+        return valid && !reader_.overrun();
+    }
+
+    /// <B>Effect:</B> Appends the main data of the given frame to the bit
+    /// reservoir (keeping the last maximumMainDataBegin bytes before it).<BR>
+    /// \return The number of reservoir bytes preceding the frame's own.
+    unsigned int appendMainData( FrameHeader const & header )
+    {
+        Buffers & buffers( *pBuffers_ );
+        if ( buffers.reservoirSize > maximumMainDataBegin )
+        {
+            std::memmove( buffers.reservoir, &buffers.reservoir[ buffers.reservoirSize - maximumMainDataBegin ], maximumMainDataBegin );
+            buffers.reservoirSize = maximumMainDataBegin;
+        }
+        unsigned int const offset( header.sideInfoOffset + header.sideInfoSize );
+        unsigned int const size  ( header.size - offset                        );
+        unsigned int const before( buffers.reservoirSize                        );
+        std::memcpy( &buffers.reservoir[ before ], header.pFrame + offset, size );
+        buffers.reservoirSize += size;
+        return before;
+    }
+
+    /// <B>Effect:</B> Decodes the next frame, decoding granules with corrupt
+    /// side information or missing (bit reservoir) data as silence so that
+    /// every sample keeps its position.<BR>
+    /// \return false at the end of the stream.
+    bool decodeFrame()
+    {
+        if ( nextFrame_ >= numberOfFrames_ )
+            return false;
+        Buffers & buffers( *pBuffers_ );
+        FrameHeader header;
+        parseHeader( pBegin_ + pFrames_[ nextFrame_ ], header );
+        SideInfo side;
+        bool         const valid    ( parseSideInfo( header, side ) );
+        unsigned int const available( appendMainData( header )     );
+        bool         const complete ( valid && side.mainDataBegin <= available );
+
+        unsigned int const channels ( numberOfChannels_ );
+        std::size_t        bitOffset( complete ? ( available - side.mainDataBegin ) * std::size_t( 8 ) : 0 );
+        std::size_t  const bitsEnd  ( buffers.reservoirSize * std::size_t( 8 )  );
+        for ( unsigned int granule( 0 ); granule < ( lsf_ ? 1U : 2U ); ++granule )
+        {
+            unsigned int nonZero[ 2 ] = { 0, 0 };
+            for ( unsigned int channel( 0 ); channel < channels; ++channel )
+            {
+                Granule const & g( side.granules[ granule ][ channel ] );
+                float * const pSpectrum( buffers.spectrum[ channel ] );
+                if ( complete && bitOffset + g.part23Length <= bitsEnd )
+                    nonZero[ channel ] = decodeSpectrum( g, side.scfsi[ channel ], granule, channel, header, bitOffset, pSpectrum );
+                std::fill( &pSpectrum[ nonZero[ channel ] ], &pSpectrum[ granuleSize ], 0.0f );
+                bitOffset += complete ? g.part23Length : 0;
+            }
+            if ( channels == 2 && header.mode == 1 && header.modeExtension )
+            {
+                nonZero[ 0 ] = nonZero[ 1 ] = std::max( nonZero[ 0 ], nonZero[ 1 ] );
+                if ( complete )
+                    processStereo( side.granules[ granule ][ 1 ], header.modeExtension, nonZero[ 0 ] );
+            }
+            for ( unsigned int channel( 0 ); channel < channels; ++channel )
+            {
+                Granule const & g( side.granules[ granule ][ channel ] );
+                hybridSynthesis( complete ? g.blockType : 0, complete && g.mixed, complete ? g.shortStart : 13, nonZero[ channel ], channel );
+                synthesize( channel, &buffers.block[ channel ][ granule * granuleSize ] );
+            }
+        }
+
+        blockFirstSample_ = static_cast<std::uint64_t>( nextFrame_ ) * samplesPerFrame_;
+        blockFrames_      = samplesPerFrame_;
+        blockPosition_    = 0;
+        ++nextFrame_;
+        return true;
+    }
+
+    /// <B>Effect:</B> Reads the scale factors and the Huffman coded values of
+    /// one granule and channel and requantizes them.<BR>
+    /// \return The number of (possibly) non-zero lines.
+    unsigned int decodeSpectrum( Granule const & g, unsigned int const scfsi, unsigned int const granule, unsigned int const channel, FrameHeader const & header, std::size_t const bitOffset, float * LE_RESTRICT const pSpectrum )
+    {
+        Detail::MP3Tables const & tables ( Detail::MP3Tables::get() );
+        Buffers                 & buffers( *pBuffers_              );
+        reader_.reset( &buffers.reservoir[ bitOffset / 8 ], &buffers.reservoir[ buffers.reservoirSize ] );
+        reader_.read( bitOffset % 8 );
+        std::size_t const end( bitOffset % 8 + g.part23Length );
+
+        unsigned char * const pScalefactors( buffers.scalefactors[ channel ] );
+        bool preflag( g.preflag );
+        if ( !lsf_ )
+        {
+            static unsigned char const lengths[ 16 ][ 2 ] = { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 3, 0 }, { 1, 1 }, { 1, 2 }, { 1, 3 }, { 2, 1 }, { 2, 2 }, { 2, 3 }, { 3, 1 }, { 3, 2 }, { 3, 3 }, { 4, 2 }, { 4, 3 } };
+            unsigned int const length1( lengths[ g.scalefacCompress ][ 0 ] );
+            unsigned int const length2( lengths[ g.scalefacCompress ][ 1 ] );
+            if ( g.blockType == 2 )
+            {
+                unsigned int index( 0 );
+                for ( unsigned int band( 0 ); band < g.longEnd; ++band )
+                    pScalefactors[ index++ ] = static_cast<unsigned char>( reader_.read( length1 ) );
+                for ( unsigned int band( g.shortStart ); band < 12; ++band )
+                    for ( unsigned int window( 0 ); window < 3; ++window )
+                        pScalefactors[ index++ ] = static_cast<unsigned char>( reader_.read( band < 6 ? length1 : length2 ) );
+                pScalefactors[ index ] = pScalefactors[ index + 1 ] = pScalefactors[ index + 2 ] = 0;
+            }
+            else
+            {
+                static unsigned char const groups[ 5 ] = { 0, 6, 11, 16, 21 };
+                for ( unsigned int group( 0 ); group < 4; ++group )
+                {
+                    if ( granule && ( scfsi & ( 8 >> group ) ) )
+                        continue; // shared with the first granule
+                    for ( unsigned int band( groups[ group ] ); band < groups[ group + 1 ]; ++band )
+                        pScalefactors[ band ] = static_cast<unsigned char>( reader_.read( group < 2 ? length1 : length2 ) );
+                }
+                pScalefactors[ 21 ] = 0;
+            }
+        }
+        else
+        {
+            static unsigned char const bandCounts[ 6 ][ 3 ][ 4 ] =
+            {
+                { {  6,  5, 5, 5 }, {  9,  9,  9, 9 }, {  6,  9,  9, 9 } },
+                { {  6,  5, 7, 3 }, {  9,  9, 12, 6 }, {  6,  9, 12, 6 } },
+                { { 11, 10, 0, 0 }, { 18, 18,  0, 0 }, { 15, 18,  0, 0 } },
+                { {  7,  7, 7, 0 }, { 12, 12, 12, 0 }, {  6, 15, 12, 0 } },
+                { {  6,  6, 6, 3 }, { 12,  9,  9, 6 }, {  6, 12,  9, 6 } },
+                { {  8,  8, 5, 0 }, { 15, 12,  9, 0 }, {  6, 18,  9, 0 } }
+            };
+            unsigned int lengths[ 4 ];
+            unsigned int table;
+            unsigned int compress( g.scalefacCompress );
+            bool const intensity( channel == 1 && header.mode == 1 && ( header.modeExtension & 1 ) );
+            if ( !intensity )
+            {
+                if      ( compress < 400 ) { table = 0; lengths[ 0 ] = ( compress >> 4 ) / 5; lengths[ 1 ] = ( compress >> 4 ) % 5; lengths[ 2 ] = ( compress & 15 ) >> 2; lengths[ 3 ] = compress & 3; }
+                else if ( compress < 500 ) { compress -= 400; table = 1; lengths[ 0 ] = ( compress >> 2 ) / 5; lengths[ 1 ] = ( compress >> 2 ) % 5; lengths[ 2 ] = compress & 3; lengths[ 3 ] = 0; }
+                else                       { compress -= 500; table = 2; lengths[ 0 ] = compress / 3; lengths[ 1 ] = compress % 3; lengths[ 2 ] = lengths[ 3 ] = 0; preflag = true; }
+            }
+            else
+            {
+                compress >>= 1;
+                if      ( compress < 180 ) { table = 3; lengths[ 0 ] = compress / 36; lengths[ 1 ] = ( compress % 36 ) / 6; lengths[ 2 ] = ( compress % 36 ) % 6; lengths[ 3 ] = 0; }
+                else if ( compress < 244 ) { compress -= 180; table = 4; lengths[ 0 ] = ( compress & 63 ) >> 4; lengths[ 1 ] = ( compress & 15 ) >> 2; lengths[ 2 ] = compress & 3; lengths[ 3 ] = 0; }
+                else                       { compress -= 244; table = 5; lengths[ 0 ] = compress / 3; lengths[ 1 ] = compress % 3; lengths[ 2 ] = lengths[ 3 ] = 0; }
+            }
+            unsigned int const blockIndex( g.blockType != 2 ? 0 : g.mixed ? 2 : 1 );
+            unsigned int index( 0 );
+            for ( unsigned int part( 0 ); part < 4; ++part )
+            {
+                unsigned int const length ( lengths[ part ]          );
+                unsigned int const illegal( ( 1U << length ) - 1 );
+                for ( unsigned int band( 0 ); band < bandCounts[ table ][ blockIndex ][ part ]; ++band, ++index )
+                {
+                    unsigned int const value( reader_.read( length ) );
+                    pScalefactors  [ index ] = static_cast<unsigned char>( value );
+                    buffers.illegal[ index ] = length && value == illegal;
+                }
+            }
+            std::fill( &pScalefactors  [ index ], &pScalefactors  [ 40 ], 0     );
+            std::fill( &buffers.illegal[ index ], &buffers.illegal[ 40 ], false );
+        }
+        if ( reader_.overrun() || reader_.bitPosition() > end )
+            return 0;
+
+        // Huffman coded big values (pairs) and count1 (quadruples) regions,
+        // stored as sign( x ) * |x|^(4/3).
+        float const * LE_RESTRICT const pPow43( tables.pow43 );
+        unsigned int const bigValuesEnd( g.bigValues * 2 );
+        unsigned int const regionEnds[ 3 ] = { std::min( g.region1Start, bigValuesEnd ), std::min( g.region2Start, bigValuesEnd ), bigValuesEnd };
+        unsigned int line( 0 );
+        for ( unsigned int region( 0 ); region < 3; ++region )
+        {
+            unsigned int const table( g.tableSelect[ region ] );
+            if ( !table )
+            {
+                for ( ; line < regionEnds[ region ]; ++line )
+                    pSpectrum[ line ] = 0;
+                continue;
+            }
+            std::uint32_t const * LE_RESTRICT const pRoot( &tables.huffman[ tables.huffmanRoot[ table ] ] );
+            unsigned int const escapeBits( tables.linbits[ table ] );
+            for ( ; line < regionEnds[ region ]; line += 2 )
+            {
+                std::uint32_t entry( pRoot[ reader_.peek( 8 ) ] );
+                if ( entry & 0x80000000U )
+                {
+                    reader_.skip( 8 );
+                    entry = tables.huffman[ ( entry & 0xFFFF ) + reader_.peek( ( entry >> 16 ) & 0xFF ) ];
+                    reader_.skip( ( entry >> 8 ) - 8 );
+                }
+                else
+                {
+                    reader_.skip( entry >> 8 );
+                }
+                unsigned int x( ( entry >> 4 ) & 15 );
+                unsigned int y( entry & 15          );
+                if ( x == 15 ) x += reader_.read( escapeBits );
+                float valueX( pPow43[ x ] );
+                if ( x && reader_.read( 1 ) ) valueX = -valueX;
+                if ( y == 15 ) y += reader_.read( escapeBits );
+                float valueY( pPow43[ y ] );
+                if ( y && reader_.read( 1 ) ) valueY = -valueY;
+                pSpectrum[ line     ] = valueX;
+                pSpectrum[ line + 1 ] = valueY;
+            }
+        }
+        while ( line + 4 <= granuleSize && reader_.bitPosition() < end )
+        {
+            unsigned int values;
+            if ( g.count1TableB )
+            {
+                values = 15 - reader_.read( 4 );
+            }
+            else
+            {
+                unsigned int const entry( tables.count1A[ reader_.peek( 6 ) ] );
+                reader_.skip( entry >> 4 );
+                values = entry & 15;
+            }
+            float quadruple[ 4 ];
+            for ( unsigned int value( 0 ); value < 4; ++value )
+            {
+                quadruple[ value ] = static_cast<float>( ( values >> ( 3 - value ) ) & 1 );
+                if ( quadruple[ value ] != 0 && reader_.read( 1 ) )
+                    quadruple[ value ] = -1;
+            }
+            if ( reader_.bitPosition() > end )
+                break; // (the last quadruple overran the granule)
+            std::copy( quadruple, quadruple + 4, &pSpectrum[ line ] );
+            line += 4;
+        }
+        if ( reader_.overrun() )
+            return 0;
+
+        // Requantization: the scaling by 2^( gain / 4 ) per band.
+        static unsigned char const pretab[ 22 ] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 3, 3, 2, 0 };
+        int const globalGain    ( static_cast<int>( g.globalGain ) - 210 );
+        int const scalefacShift ( g.scalefacScale ? 4 : 2               );
+        std::uint16_t const * const pLongBands ( tables.longBands [ sampleRateIndex_ ] );
+        std::uint16_t const * const pShortBands( tables.shortBands[ sampleRateIndex_ ] );
+        unsigned int const nonZero( line );
+        for ( unsigned int band( 0 ); band < g.longEnd && pLongBands[ band ] < nonZero; ++band )
+        {
+            int const gain( globalGain - scalefacShift * ( pScalefactors[ band ] + ( preflag ? pretab[ band ] : 0 ) ) );
+            scale( pSpectrum, pLongBands[ band ], std::min<unsigned int>( pLongBands[ band + 1 ], nonZero ), gain );
+        }
+        for ( unsigned int band( g.shortStart ), index( g.longEnd ); band < 13 && 3 * pShortBands[ band ] < nonZero; ++band )
+        {
+            unsigned int const width( pShortBands[ band + 1 ] - pShortBands[ band ] );
+            for ( unsigned int window( 0 ); window < 3; ++window, ++index )
+            {
+                unsigned int const begin( 3 * pShortBands[ band ] + window * width );
+                int const gain( globalGain - 8 * static_cast<int>( g.subblockGain[ window ] ) - scalefacShift * pScalefactors[ index ] );
+                scale( pSpectrum, std::min( begin, nonZero ), std::min( begin + width, nonZero ), gain );
+            }
+        }
+        return nonZero;
+    }
+
+    static void scale( float * LE_RESTRICT const pSpectrum, unsigned int const begin, unsigned int const end, int const quarterExponent )
+    {
+        static float const quarterPowers[ 4 ] = { 1.0f, 1.18920712f, 1.41421356f, 1.68179283f };
+        float const gain( std::ldexp( quarterPowers[ quarterExponent & 3 ], quarterExponent >> 2 ) );
+        for ( unsigned int line( begin ); line < end; ++line )
+            pSpectrum[ line ] *= gain;
+    }
+
+    /// <B>Effect:</B> MS and/or intensity stereo (on the spectra as read, i.e.
+    /// before the reordering of short blocks), the scale factor band layout
+    /// and the intensity positions are those of the right channel.<BR>
+    void processStereo( Granule const & right, unsigned int const modeExtension, unsigned int const nonZero )
+    {
+        Detail::MP3Tables const & tables ( Detail::MP3Tables::get() );
+        Buffers                 & buffers( *pBuffers_              );
+        float * LE_RESTRICT const pLeft ( buffers.spectrum[ 0 ] );
+        float * LE_RESTRICT const pRight( buffers.spectrum[ 1 ] );
+        bool const midSide( ( modeExtension & 2 ) != 0 );
+        if ( !( modeExtension & 1 ) )
+        {
+            if ( midSide )
+                processMidSide( pLeft, pRight, 0, nonZero );
+            return;
+        }
+
+        unsigned char const * const pPositions( buffers.scalefactors[ 1 ] );
+        float const ( * const pLSF )[ 16 ]( tables.intensityLSF[ right.scalefacCompress & 1 ] );
+        // Intensity stereo applies from the top down to (above) the highest
+        // non-zero band of the right channel (per window for short blocks).
+        auto const process = [ & ]( unsigned int const begin, unsigned int const end, unsigned int const position, bool & nonZeroFound )
+        {
+            if ( !nonZeroFound )
+            {
+                for ( unsigned int line( begin ); line < end; ++line )
+                    nonZeroFound = nonZeroFound || pRight[ line ] != 0;
+            }
+            bool const legal( lsf_ ? !buffers.illegal[ position ] : pPositions[ position ] < 7 );
+            if ( !nonZeroFound && legal )
+            {
+                float const leftGain ( lsf_ ? pLSF[ 0 ][ pPositions[ position ] & 15 ] : tables.intensityMPEG1[ 0 ][ pPositions[ position ] ] );
+                float const rightGain( lsf_ ? pLSF[ 1 ][ pPositions[ position ] & 15 ] : tables.intensityMPEG1[ 1 ][ pPositions[ position ] ] );
+                for ( unsigned int line( begin ); line < end; ++line )
+                {
+                    float const value( pLeft[ line ] );
+                    pLeft [ line ] = value * leftGain ;
+                    pRight[ line ] = value * rightGain;
+                }
+            }
+            else if ( midSide )
+            {
+                processMidSide( pLeft, pRight, begin, end );
+            }
+        };
+        std::uint16_t const * const pLongBands ( tables.longBands [ sampleRateIndex_ ] );
+        std::uint16_t const * const pShortBands( tables.shortBands[ sampleRateIndex_ ] );
+        bool nonZeroFound[ 3 ] = { false, false, false };
+        for ( unsigned int band( 13 ); band-- > right.shortStart; )
+        {
+            // (the last band uses the position of the one below it)
+            unsigned int const positionBand( std::min( band, 11U ) );
+            unsigned int const width( pShortBands[ band + 1 ] - pShortBands[ band ] );
+            for ( unsigned int window( 3 ); window--; )
+            {
+                unsigned int const begin( 3 * pShortBands[ band ] + window * width );
+                process( begin, begin + width, right.longEnd + 3 * ( positionBand - right.shortStart ) + window, nonZeroFound[ window ] );
+            }
+        }
+        bool longNonZeroFound( nonZeroFound[ 0 ] || nonZeroFound[ 1 ] || nonZeroFound[ 2 ] );
+        for ( unsigned int band( right.longEnd ); band--; )
+            process( pLongBands[ band ], pLongBands[ band + 1 ], std::min( band, 20U ), longNonZeroFound );
+    }
+
+    static void processMidSide( float * LE_RESTRICT const pLeft, float * LE_RESTRICT const pRight, unsigned int const begin, unsigned int const end )
+    {
+        float const scale( 0.70710678f );
+        for ( unsigned int line( begin ); line < end; ++line )
+        {
+            float const mid ( pLeft [ line ] );
+            float const side( pRight[ line ] );
+            pLeft [ line ] = ( mid + side ) * scale;
+            pRight[ line ] = ( mid - side ) * scale;
+        }
+    }
+
+    /// <B>Effect:</B> Reorders short blocks, reduces aliasing and applies
+    /// the IMDCT (with overlap-add and frequency inversion) to the channel's
+    /// spectrum, producing the time major subband samples.<BR>
+    void hybridSynthesis( unsigned int const blockType, bool const mixed, unsigned int const shortStart, unsigned int const nonZero, unsigned int const channel )
+    {
+        Detail::MP3Tables const & tables ( Detail::MP3Tables::get() );
+        Buffers                 & buffers( *pBuffers_              );
+        float * LE_RESTRICT const pSpectrum( buffers.spectrum[ channel ] );
+        float * LE_RESTRICT const pOverlap ( buffers.overlap [ channel ] );
+
+        unsigned int subbandLimit( ( nonZero + 17 ) / 18 );
+        if ( blockType == 2 )
+        {
+            // Window major to frequency major (each subband holds 6 lines of
+            // each of the 3 windows interleaved).
+            std::uint16_t const * const pShortBands( tables.shortBands[ sampleRateIndex_ ] );
+            float reordered[ granuleSize ];
+            for ( unsigned int band( shortStart ); band < 13; ++band )
+            {
+                unsigned int const begin( 3 * pShortBands[ band ]                      );
+                unsigned int const width( pShortBands[ band + 1 ] - pShortBands[ band ] );
+                for ( unsigned int window( 0 ); window < 3; ++window )
+                    for ( unsigned int line( 0 ); line < width; ++line )
+                        reordered[ begin + 3 * line + window ] = pSpectrum[ begin + window * width + line ];
+            }
+            unsigned int const begin( 3 * pShortBands[ shortStart ] );
+            std::copy( &reordered[ begin ], &reordered[ granuleSize ], &pSpectrum[ begin ] );
+            subbandLimit = 32;
+        }
+
+        // Alias reduction between the long block subbands.
+        unsigned int const aliasBoundaries( blockType != 2 ? std::min( subbandLimit, 31U ) : mixed ? 1 : 0 );
+        for ( unsigned int boundary( 1 ); boundary <= aliasBoundaries; ++boundary )
+        {
+            float * LE_RESTRICT const pBelow( &pSpectrum[ boundary * 18 - 8 ] );
+            float * LE_RESTRICT const pAbove( &pSpectrum[ boundary * 18     ] );
+            for ( unsigned int i( 0 ); i < 8; ++i )
+            {
+                float const below( pBelow[ 7 - i ] );
+                float const above( pAbove[ i     ] );
+                pBelow[ 7 - i ] = below * tables.antialiasCS[ i ] - above * tables.antialiasCA[ i ];
+                pAbove[ i     ] = above * tables.antialiasCS[ i ] + below * tables.antialiasCA[ i ];
+            }
+        }
+        if ( blockType != 2 )
+            subbandLimit = std::min( subbandLimit + 1, 32U );
+
+        for ( unsigned int subband( 0 ); subband < 32; ++subband )
+        {
+            float * LE_RESTRICT const pOverlapped( &pOverlap[ subband * 18 ] );
+            float output[ 18 ];
+            if ( subband >= subbandLimit )
+            {
+                std::copy( pOverlapped, pOverlapped + 18, output );
+                std::fill( pOverlapped, pOverlapped + 18, 0.0f );
+            }
+            else if ( blockType != 2 || ( mixed && subband < 2 ) )
+            {
+                imdct36( &pSpectrum[ subband * 18 ], tables.longWindows[ blockType == 2 ? 0 : blockType ], pOverlapped, output );
+            }
+            else
+            {
+                imdct12( &pSpectrum[ subband * 18 ], pOverlapped, output );
+            }
+            // Frequency inversion (of the odd time samples of odd subbands).
+            float const sign( ( subband & 1 ) ? -1.0f : 1.0f );
+            for ( unsigned int time( 0 ); time < 18; time += 2 )
+            {
+                buffers.subbands[ time     ][ subband ] = output[ time     ];
+                buffers.subbands[ time + 1 ][ subband ] = output[ time + 1 ] * sign;
+            }
+        }
+    }
+
+    static void imdct36( float const * LE_RESTRICT const pInput, float const * LE_RESTRICT const pWindow, float * LE_RESTRICT const pOverlap, float * LE_RESTRICT const pOutput )
+    {
+        Detail::MP3Tables const & tables( Detail::MP3Tables::get() );
+        float distinct[ 20 ] = { 0 };
+        for ( unsigned int k( 0 ); k < 18; ++k )
+        {
+            float const input( pInput[ k ] );
+            for ( unsigned int output( 0 ); output < 20; ++output )
+                distinct[ output ] += input * tables.imdct36[ k ][ output ];
+        }
+        float y[ 36 ];
+        for ( unsigned int i( 0 ); i < 9; ++i )
+        {
+            y[ i      ] =  distinct[ i     ];
+            y[ 17 - i ] = -distinct[ i     ];
+            y[ 18 + i ] =  distinct[ 9 + i ];
+            y[ 35 - i ] =  distinct[ 9 + i ];
+        }
+        for ( unsigned int i( 0 ); i < 18; ++i )
+        {
+            pOutput [ i ] = pOverlap[ i ] + y[ i ] * pWindow[ i ];
+            pOverlap[ i ] = y[ 18 + i ] * pWindow[ 18 + i ];
+        }
+    }
+
+    static void imdct12( float const * LE_RESTRICT const pInput, float * LE_RESTRICT const pOverlap, float * LE_RESTRICT const pOutput )
+    {
+        Detail::MP3Tables const & tables( Detail::MP3Tables::get() );
+        float z[ 36 ] = { 0 };
+        for ( unsigned int window( 0 ); window < 3; ++window )
+        {
+            float y[ 12 ] = { 0 };
+            for ( unsigned int k( 0 ); k < 6; ++k )
+            {
+                float const input( pInput[ 3 * k + window ] );
+                for ( unsigned int i( 0 ); i < 12; ++i )
+                    y[ i ] += input * tables.imdct12[ k ][ i ];
+            }
+            for ( unsigned int i( 0 ); i < 12; ++i )
+                z[ 6 + 6 * window + i ] += y[ i ] * tables.shortWindow[ i ];
+        }
+        for ( unsigned int i( 0 ); i < 18; ++i )
+        {
+            pOutput [ i ] = pOverlap[ i ] + z[ i ];
+            pOverlap[ i ] = z[ 18 + i ];
+        }
+    }
+
+    /// <B>Effect:</B> Polyphase synthesis of a granule's 18 subband sample
+    /// sets into 576 PCM samples.<BR>
+    void synthesize( unsigned int const channel, float * LE_RESTRICT const pPCM )
+    {
+        Detail::MP3Tables const & tables ( Detail::MP3Tables::get() );
+        Buffers                 & buffers( *pBuffers_              );
+        float * LE_RESTRICT const pFIFO( buffers.synthesis[ channel ] );
+        float const * LE_RESTRICT const pWindow( tables.synthesisWindow );
+        for ( unsigned int time( 0 ); time < 18; ++time )
+        {
+            // Matrixing: a DCT-II (A) from which the 64 new V values follow as
+            // V[ 0 - 16 ] = A[ 16 - 32 ] (A[ 32 ] = 0), V[ 17 - 48 ] =
+            // -A[ 31 - 0 ] and V[ 49 - 63 ] = -A[ 1 - 15 ].
+            float a[ 33 ];
+            Detail::MP3DCT<32>::transform( buffers.subbands[ time ], a, tables.dctFactors );
+            a[ 32 ] = 0;
+            unsigned int const offset( buffers.synthesisOffset[ channel ] = ( buffers.synthesisOffset[ channel ] + 1024 - 64 ) & 1023 );
+            float * LE_RESTRICT const pV ( &pFIFO[ offset        ] );
+            float * LE_RESTRICT const pV2( &pFIFO[ offset + 1024 ] );
+            for ( unsigned int i( 0 ); i <= 16; ++i ) pV[ i ] =  a[ 16 + i ];
+            for ( unsigned int i( 17 ); i <= 48; ++i ) pV[ i ] = -a[ 48 - i ];
+            for ( unsigned int i( 49 ); i < 64; ++i ) pV[ i ] = -a[ i - 48 ];
+            std::copy( pV, pV + 64, pV2 );
+
+            // Windowing (of U[ 64i + j ] = V[ 128i + j ] and U[ 64i + 32 + j ]
+            // = V[ 128i + 96 + j ]) accumulated per output sample.
+            float * LE_RESTRICT const pOutput( &pPCM[ time * 32 ] );
+            std::fill_n( pOutput, 32, 0.0f );
+            for ( unsigned int i( 0 ); i < 8; ++i )
+            {
+                float const * LE_RESTRICT const pFirst ( &pFIFO[ offset + 128 * i      ] );
+                float const * LE_RESTRICT const pSecond( &pFIFO[ offset + 128 * i + 96 ] );
+                float const * LE_RESTRICT const pFirstWindow ( &pWindow[ 64 * i      ] );
+                float const * LE_RESTRICT const pSecondWindow( &pWindow[ 64 * i + 32 ] );
+                for ( unsigned int j( 0 ); j < 32; ++j )
+                    pOutput[ j ] += pFirst[ j ] * pFirstWindow[ j ] + pSecond[ j ] * pSecondWindow[ j ];
+            }
+        }
+    }
+
+    /// <B>Effect:</B> Interleaves decoded samples, with dedicated
+    /// (vectorizable) loops for mono and stereo.<BR>
+    void convert( float * LE_RESTRICT const pOutput, unsigned int const frames ) const
+    {
+        float const * LE_RESTRICT const pFirst( &pBuffers_->block[ 0 ][ blockPosition_ ] );
+        if ( numberOfChannels_ == 1 )
+        {
+            std::copy( pFirst, pFirst + frames, pOutput );
+        }
+        else
+        {
+            // (size_t indices: no unsigned wrap around to prevent vectorization)
+            float const * LE_RESTRICT const pSecond( &pBuffers_->block[ 1 ][ blockPosition_ ] );
+            for ( std::size_t frame( 0 ); frame < frames; ++frame )
+            {
+                pOutput[ frame * 2 + 0 ] = pFirst [ frame ];
+                pOutput[ frame * 2 + 1 ] = pSecond[ frame ];
+            }
+        }
+    }
+
+private: // noncopyable
+    MP3Decoder( MP3Decoder const & );
+    void operator=( MP3Decoder const & );
+
+private:
+    std::unique_ptr<std::uint32_t[]> pFrames_ ; // frame offsets (from pBegin_)
+    std::unique_ptr<Buffers        > pBuffers_;
+    Detail::BitReader                reader_  ;
+
+    unsigned char const * pBegin_;
+    unsigned char const * pEnd_  ;
+
+    std::uint32_t  numberOfFrames_  ;
+    std::uint32_t  nextFrame_       ;
+    unsigned short numberOfChannels_;
+    unsigned int   sampleRateIndex_ ;
+    unsigned int   samplesPerFrame_ ;
+    bool           lsf_             ;
+    unsigned int   skip_            ; // encoder + decoder delay (decoded samples preceding the first sample)
+    unsigned int   length_          ;
+
+    std::uint64_t blockFirstSample_; // of the current (decoded) frame, including skip_
+    unsigned int  blockFrames_     ;
+    unsigned int  blockPosition_   ; // next frame of the current block to read
+}; // class MP3Decoder
+
+/// @} // group AudioIO
+
+//------------------------------------------------------------------------------
+} // namespace AudioIO
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // mp3Decoder_hpp
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file portableFile.hpp
+/// ----------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef portableFile_hpp__B1B3D447_A444_49A6_B7B0_D7AD4E0DB179
+#define portableFile_hpp__B1B3D447_A444_49A6_B7B0_D7AD4E0DB179
+#pragma once
+//------------------------------------------------------------------------------
+#include "file.hpp"
+#include "flacDecoder.hpp"
+#include "mappedWaveFile.hpp"
+#include "mp3Decoder.hpp"
+
+#include "le/utility/filesystem.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace AudioIO
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup AudioIO
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class PortableFile
+///
+/// \brief Platform independent, drop-in alternative to File for uncompressed
+/// WAVE, FLAC and MP3 files.
+///
+/// Same interface as File but with its own (header only) decoders that need
+/// nothing from the OS beyond memory mapping, i.e. also work on platforms
+/// without an OS decoder backend (e.g. Linux). The file is memory mapped and
+/// decoded straight from the mapping, the format is detected from the
+/// contents (not the file name extension), the format to float conversion
+/// loops are vectorized (see MappedWaveFile, FLACDecoder and MP3Decoder)
+/// and, unlike with File, lengthInSamples() and remainingSamples() are exact
+/// and seeking is sample exact (MP3 files included, with the encoder delay
+/// and padding removed as described by their LAME/Xing header).
+///
+/// \note AAC (and any other compressed format except FLAC and MP3) is not
+/// supported.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class PortableFile
+{
+public:
+    PortableFile() : position_( 0 ), format_( none ) {}
+
+    /// <B>Effect:</B> Opens the file pointed to by <VAR>relativePathToFile</VAR>
+    /// within/relative to <VAR>rootLocation</VAR> (see File::open()).<BR>
+    template <Utility::SpecialLocations rootLocation>
+    error_msg_t open( char const * const relativePathToFile ) { return open( Utility::File::map<rootLocation>( relativePathToFile ) ); }
+
+    /// \overload
+    error_msg_t open( Utility::File::MemoryMapping && mapping )
+    {
+        close();
+        if ( !mapping )
+            return "Unable to open the audio file.";
+        error_msg_t pError;
+        if ( mapping.size() >= 12 && !std::memcmp( mapping.begin(), "RIFF", 4 ) && !std::memcmp( mapping.begin() + 8, "WAVE", 4 ) )
+        {
+            format_ = wave;
+            pError  = waveFile_.open( std::move( mapping ) );
+        }
+        else if ( mapping.size() >= 4 && !std::memcmp( mapping.begin(), "fLaC", 4 ) )
+        {
+            format_  = flac;
+            mapping_ = std::move( mapping );
+            pError   = flac_.open( mapping_.begin(), mapping_.end() );
+        }
+        else if ( isMPEGAudio( mapping ) )
+        {
+            format_  = mp3;
+            mapping_ = std::move( mapping );
+            pError   = mp3_.open( mapping_.begin(), mapping_.end() );
+        }
+        else
+        {
+            pError = "Unsupported audio file format.";
+        }
+        if ( pError )
+            close();
+        return pError;
+    }
+
+    void close()
+    {
+        waveFile_.close();
+        flac_    .close();
+        mp3_     .close();
+        mapping_  = Utility::File::MemoryMapping();
+        position_ = 0;
+        format_   = none;
+    }
+
+    /// <B>Effect:</B> Reads up to <VAR>numberOfSampleFrames</VAR> interleaved
+    /// sample frames (see File::read()).<BR>
+    /// \return The number of sample frames read (less than requested only at
+    /// the end of the file).
+    unsigned int read( float * const pOutput, unsigned int const numberOfSampleFrames )
+    {
+        if ( format_ == flac ) return flac_.read( pOutput, numberOfSampleFrames );
+        if ( format_ == mp3  ) return mp3_ .read( pOutput, numberOfSampleFrames );
+        unsigned int const frames( waveFile_.read( pOutput, position_, numberOfSampleFrames ) );
+        position_ += frames;
+        return frames;
+    }
+
+    unsigned short numberOfChannels() const { return format_ == flac ? flac_.numberOfChannels() : format_ == mp3 ? mp3_.numberOfChannels() : waveFile_.numberOfChannels(); }
+    unsigned int   sampleRate      () const { return format_ == flac ? flac_.sampleRate      () : format_ == mp3 ? mp3_.sampleRate      () : waveFile_.sampleRate      (); }
+    unsigned int   lengthInSamples () const { return format_ == flac ? flac_.lengthInSamples () : format_ == mp3 ? mp3_.lengthInSamples () : waveFile_.lengthInSamples (); } ///< Exact total number of sample frames.
+    unsigned int   remainingSamples() const { return lengthInSamples() - ( format_ == flac ? flac_.position() : format_ == mp3 ? mp3_.position() : position_ ); } ///< Exact number of sample frames not yet read.
+
+    void setTimePosition( unsigned int const positionInMilliseconds ) { setSamplePosition( static_cast<unsigned int>( static_cast<std::uint64_t>( positionInMilliseconds ) * sampleRate() / 1000 ) ); }
+
+    /// <B>Effect:</B> Sample exact seek.<BR>
+    void setSamplePosition( unsigned int const positionInSampleFrames )
+    {
+        if      ( format_ == flac ) flac_.setSamplePosition( positionInSampleFrames );
+        else if ( format_ == mp3  ) mp3_ .setSamplePosition( positionInSampleFrames );
+        else                        position_ = std::min( positionInSampleFrames, waveFile_.lengthInSamples() );
+    }
+
+    void restart() { setSamplePosition( 0 ); }
+
+    bool operator!() const { return format_ == flac ? !flac_ : format_ == mp3 ? !mp3_ : !waveFile_; }
+
+    /// \brief A semicolon separated list of supported audio file formats.
+    static char const * supportedFormats() { return "*.flac;*.mp3;*.wav"; }
+
+private:
+    /// \return Whether the data starts with an ID3v2 tag or an MPEG audio
+    /// frame sync (MP3Decoder::open() rejects the non Layer III ones, e.g.
+    /// ADTS AAC).
+    static bool isMPEGAudio( Utility::File::MemoryMapping const & mapping )
+    {
+        return
+            ( mapping.size() >= 3 && !std::memcmp( mapping.begin(), "ID3", 3 ) ) ||
+            ( mapping.size() >= 2 && static_cast<unsigned char>( mapping.begin()[ 0 ] ) == 0xFF && ( static_cast<unsigned char>( mapping.begin()[ 1 ] ) & 0xE0 ) == 0xE0 );
+    }
+
+private: // noncopyable
+    PortableFile( PortableFile const & );
+    void operator=( PortableFile const & );
+
+private:
+    enum Format { none, wave, flac, mp3 };
+
+    Utility::File::MemoryMapping mapping_ ; // FLAC/MP3 data (MappedWaveFile owns its own mapping)
+    MappedWaveFile               waveFile_;
+    FLACDecoder                  flac_    ;
+    MP3Decoder                   mp3_     ;
+    unsigned int                 position_; // WAVE read position
+    Format                       format_  ;
+}; // class PortableFile
+
+/// @} // group AudioIO
+
+//------------------------------------------------------------------------------
+} // namespace AudioIO
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // portableFile_hpp
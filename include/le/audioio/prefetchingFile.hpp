@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file prefetchingFile.hpp
+/// -------------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef prefetchingFile_hpp__C6489F99_3ACB_4533_8BC7_80317A534606
+#define prefetchingFile_hpp__C6489F99_3ACB_4533_8BC7_80317A534606
+#pragma once
+//------------------------------------------------------------------------------
+#include "file.hpp"
+
+#include "le/utility/ringBuffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <thread>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace AudioIO
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup AudioIO
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class PrefetchingFile
+///
+/// \brief An AudioIO::File reader that decodes ahead on a worker thread.
+///
+/// After open() a worker thread decodes the file, one chunk at a time, into a
+/// bounded, wait-free Utility::RingBuffer. read() only copies the frames that
+/// are already decoded so it never blocks, decodes or allocates and can be
+/// called from real time (audio) threads. waitAndRead() is the blocking
+/// variant for offline consumers that want the decoding to overlap with
+/// their own processing (or with the decoding of other files).
+///
+/// The worker polls (sleeps for a few milliseconds) while the buffer is full
+/// so that the consumer never has to signal it.
+///
+/// \note The control functions (open(), close(), setSamplePosition()) and
+/// the read functions must be called from the same (consumer) thread.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class PrefetchingFile
+{
+public:
+    /// \param bufferLengthInSampleFrames Amount of audio decoded ahead (at
+    ///                                   least one decoding chunk).
+    explicit PrefetchingFile( unsigned int const bufferLengthInSampleFrames = 65536 )
+        :
+        bufferLength_    ( std::max( bufferLengthInSampleFrames, static_cast<unsigned int>( chunkSize ) ) ),
+        numberOfChannels_( 0 ),
+        sampleRate_      ( 0 ),
+        lengthInSamples_ ( 0 ),
+        stop_            ( false ),
+        decodingDone_    ( false )
+    {}
+
+    ~PrefetchingFile() { close(); }
+
+    /// <B>Effect:</B> Opens the file (see File::open()) and starts decoding it
+    /// in the background.<BR>
+    template <Utility::SpecialLocations rootLocation>
+    error_msg_t open( char const * const relativePathToFile )
+    {
+        close();
+        if ( error_msg_t const pError = file_.open<rootLocation>( relativePathToFile ) )
+            return pError;
+
+        // The File accessors are queried once, here, so that the consumer
+        // never touches the File instance the worker is decoding from.
+        numberOfChannels_ = file_.numberOfChannels();
+        sampleRate_       = file_.sampleRate      ();
+        lengthInSamples_  = file_.lengthInSamples ();
+
+        pBuffer_.reset( new ( std::nothrow ) Utility::RingBuffer<float>( bufferLength_ * numberOfChannels_ ) );
+        pChunk_ .reset( new ( std::nothrow ) float[ chunkSize * numberOfChannels_ ]               );
+        if ( !pBuffer_ || !*pBuffer_ || !pChunk_ )
+        {
+            close();
+            return "Out of memory.";
+        }
+        start();
+        return nullptr;
+    }
+
+    /// <B>Effect:</B> Stops the worker thread and closes the file.<BR>
+    void close()
+    {
+        stop();
+        file_.close();
+        pBuffer_.reset();
+        pChunk_ .reset();
+        numberOfChannels_ = 0;
+    }
+
+    /// <B>Effect:</B> Copies up to <VAR>numberOfSampleFrames</VAR> already
+    /// decoded frames (wait-free, real time safe).<BR>
+    /// \return The number of sample frames read (less than requested on a
+    /// buffer underrun or at the end of the file, see endOfFile()).
+    unsigned int read( float * const pOutput, unsigned int const numberOfSampleFrames )
+    {
+        unsigned int const channels( numberOfChannels_ );
+        unsigned int const frames  ( std::min( numberOfSampleFrames, pBuffer_->size() / channels ) );
+        return pBuffer_->read( pOutput, frames * channels ) / channels;
+    }
+
+    /// <B>Effect:</B> Reads exactly <VAR>numberOfSampleFrames</VAR>, waiting
+    /// for the worker if necessary, unless the end of the file is reached
+    /// first (blocking, not for real time threads).<BR>
+    /// \return The number of sample frames read.
+    unsigned int waitAndRead( float * const pOutput, unsigned int const numberOfSampleFrames )
+    {
+        unsigned int framesRead( 0 );
+        while ( framesRead < numberOfSampleFrames )
+        {
+            unsigned int const frames( read( &pOutput[ framesRead * numberOfChannels_ ], numberOfSampleFrames - framesRead ) );
+            framesRead += frames;
+            if ( !frames )
+            {
+                if ( endOfFile() )
+                    break;
+                std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+            }
+        }
+        return framesRead;
+    }
+
+    /// \return True if the whole file was decoded and read.
+    bool endOfFile() const { return decodingDone_.load( std::memory_order_acquire ) && !pBuffer_->size(); }
+
+    /// \return The number of decoded sample frames ready to be read.
+    unsigned int bufferedSamples() const { return pBuffer_->size() / numberOfChannels_; }
+
+    /// <B>Effect:</B> Discards the decoded data and restarts decoding at the
+    /// given position.<BR>
+    void setSamplePosition( unsigned int const positionInSampleFrames )
+    {
+        stop();
+        float discarded[ 1024 ];
+        while ( pBuffer_->read( discarded, sizeof( discarded ) / sizeof( discarded[ 0 ] ) ) ) {}
+        file_.setSamplePosition( positionInSampleFrames );
+        start();
+    }
+
+    unsigned short numberOfChannels() const { return numberOfChannels_; } ///< \see File::numberOfChannels()
+    unsigned int   sampleRate      () const { return sampleRate_      ; } ///< \see File::sampleRate()
+    unsigned int   lengthInSamples () const { return lengthInSamples_ ; } ///< \see File::lengthInSamples()
+
+    bool operator!() const { return !pBuffer_; }
+
+private:
+    void start()
+    {
+        stop_        .store( false, std::memory_order_relaxed );
+        decodingDone_.store( false, std::memory_order_relaxed );
+        worker_ = std::thread( &PrefetchingFile::decode, this );
+    }
+
+    void stop()
+    {
+        if ( !worker_.joinable() )
+            return;
+        stop_.store( true, std::memory_order_relaxed );
+        worker_.join();
+    }
+
+    void decode()
+    {
+        unsigned int const channels( numberOfChannels_ );
+        while ( !stop_.load( std::memory_order_relaxed ) )
+        {
+            if ( pBuffer_->freeSpace() < chunkSize * channels )
+            {
+                std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+                continue;
+            }
+            unsigned int const frames( file_.read( pChunk_.get(), chunkSize ) );
+            pBuffer_->write( pChunk_.get(), frames * channels );
+            if ( frames < chunkSize )
+                break;
+        }
+        decodingDone_.store( true, std::memory_order_release );
+    }
+
+private: // noncopyable
+    PrefetchingFile( PrefetchingFile const & );
+    void operator=( PrefetchingFile const & );
+
+private:
+    static unsigned int const chunkSize = 4096; // sample frames decoded at a time
+
+    File                                        file_  ; // worker thread (after open())
+    std::unique_ptr<Utility::RingBuffer<float>> pBuffer_; // worker thread -> consumer
+    std::unique_ptr<float[]                   > pChunk_ ; // worker thread
+    std::thread                                 worker_ ;
+
+    unsigned int   const bufferLength_    ;
+    unsigned short       numberOfChannels_;
+    unsigned int         sampleRate_      ;
+    unsigned int         lengthInSamples_ ;
+
+    std::atomic<bool> stop_        ;
+    std::atomic<bool> decodingDone_;
+}; // class PrefetchingFile
+
+/// @} // group AudioIO
+
+//------------------------------------------------------------------------------
+} // namespace AudioIO
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // prefetchingFile_hpp
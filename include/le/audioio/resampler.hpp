@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file resampler.hpp
+/// -------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef resampler_hpp__8204DAB4_D542_44AC_A907_CA1FAA41043A
+#define resampler_hpp__8204DAB4_D542_44AC_A907_CA1FAA41043A
+#pragma once
+//------------------------------------------------------------------------------
+#include "le/utility/abi.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <new>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace AudioIO
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup AudioIO
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class Resampler
+///
+/// \brief Streaming, polyphase, windowed sinc sample rate converter for
+/// interleaved float data.
+///
+/// The conversion ratio is the exact rational ratio of the two sample rates
+/// (e.g. 147:160 for 44.1 kHz -> 48 kHz) so there is no drift regardless of
+/// the stream length. The anti-aliasing/anti-imaging lowpass (Kaiser window,
+/// ~90 dB stopband) is precomputed into one short filter per output phase in
+/// setup() so processing is a plain, four-way unrolled (auto-vectorizable)
+/// dot product per output sample and channel. The data is processed in
+/// streaming fashion with a fixed amount of internal memory (the filter
+/// history plus one block) so arbitrarily long streams can be converted
+/// without full length intermediate buffers.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class Resampler
+{
+public:
+    Resampler() : upFactor_( 0 ), downFactor_( 0 ), numberOfChannels_( 0 ), numberOfTaps_( 0 ) {}
+
+    ////////////////////////////////////////////////////////////////////////////
+    //
+    // Resampler::setup()
+    // ------------------
+    //
+    ////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \param tapsPerPhase Filter length (in input samples, multiplied by the
+    ///                     decimation ratio when downsampling), rounded up to
+    ///                     a multiple of four. Longer filters give a sharper
+    ///                     transition band at a proportional cost.
+    ///
+    /// \return nullptr if successful, pointer to an error message string
+    /// otherwise.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+
+    char const * setup( unsigned int const inputSampleRate, unsigned int const outputSampleRate, unsigned int const numberOfChannels, unsigned int const tapsPerPhase = 64 )
+    {
+        if ( !inputSampleRate || !outputSampleRate || !numberOfChannels )
+            return "Invalid resampler parameters.";
+
+        unsigned int divisor( inputSampleRate );
+        for ( unsigned int remainder( outputSampleRate ); remainder; )
+        {
+            unsigned int const next( divisor % remainder );
+            divisor   = remainder;
+            remainder = next;
+        }
+        unsigned int const upFactor  ( outputSampleRate / divisor  );
+        unsigned int const downFactor( inputSampleRate  / divisor  );
+        // When decimating the filter has to be proportionally longer (in input
+        // samples) for the same transition band (relative to the output rate).
+        unsigned int const taps      ( ( std::max( tapsPerPhase, 4U ) * ( ( downFactor + upFactor - 1 ) / upFactor ) + 3 ) & ~3U );
+        if ( upFactor > maximumNumberOfPhases || taps > maximumNumberOfTaps )
+            return "Unsupported sample rate ratio.";
+
+        std::unique_ptr<float[]> pFilters( new ( std::nothrow ) float[ upFactor * taps                          ] );
+        std::unique_ptr<float[]> pHistory( new ( std::nothrow ) float[ numberOfChannels * ( taps - 1 + blockSize ) ] );
+        if ( !pFilters || !pHistory )
+            return "Out of memory.";
+
+        // Prototype lowpass at the (virtual) upsampled rate, cut off just
+        // below the lower of the two Nyquist frequencies, split into upFactor
+        // phases each stored reversed (oldest input sample first). It is
+        // centred on an integer upsampled index so that, with the proper
+        // starting phase (see reset()), the delay is a whole number of output
+        // frames.
+        double const pi        ( 3.14159265358979323846                                   );
+        double const cutoff    ( 0.5 * 0.94 / std::max( upFactor, downFactor )            );
+        double const beta      ( 9.0                                                      );
+        double const length    ( static_cast<double>( upFactor ) * taps                  );
+        double const centre    ( length / 2                                               );
+        double const windowNorm( besselI0( beta )                                         );
+        for ( unsigned int phase( 0 ); phase < upFactor; ++phase )
+        {
+            for ( unsigned int tap( 0 ); tap < taps; ++tap )
+            {
+                double const index ( phase + static_cast<double>( tap ) * upFactor );
+                double const x     ( index - centre                                 );
+                double const sinc  ( x == 0 ? 1 : std::sin( 2 * pi * cutoff * x ) / ( 2 * pi * cutoff * x ) );
+                double const r     ( 2 * x / length                                 );
+                double const window( besselI0( beta * std::sqrt( std::max( 0.0, 1 - r * r ) ) ) / windowNorm );
+                pFilters[ phase * taps + ( taps - 1 - tap ) ] = static_cast<float>( upFactor * 2 * cutoff * sinc * window );
+            }
+        }
+
+        upFactor_         = upFactor  ;
+        downFactor_       = downFactor;
+        numberOfChannels_ = numberOfChannels;
+        numberOfTaps_     = taps;
+        pFilters_.swap( pFilters );
+        pHistory_.swap( pHistory );
+        reset();
+        return nullptr;
+    }
+
+    /// <B>Effect:</B> Clears the filter history (e.g. before converting a new stream).<BR>
+    void reset()
+    {
+        std::fill_n( &pHistory_[ 0 ], numberOfChannels_ * ( numberOfTaps_ - 1 + blockSize ), 0.0f );
+        // Start the output clock so that output frame latencyInOutputFrames()
+        // lines up exactly with input frame zero.
+        unsigned int const startOffset( upFactor_ * numberOfTaps_ / 2 - latencyInOutputFrames() * downFactor_ );
+        bufferedFrames_ = numberOfTaps_ - 1;
+        nextFrame_      = numberOfTaps_ - 1 + startOffset / upFactor_;
+        phase_          =                     startOffset % upFactor_;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //
+    // Resampler::process()
+    // --------------------
+    //
+    ////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \brief Converts as much of the given input as fits into the given
+    /// output.
+    ///
+    /// \param inputFrames  [in] The number of available input frames.<BR>
+    ///                     [out] The number of input frames consumed.
+    /// \param outputFrames [in] The capacity of the output (in frames).<BR>
+    ///                     [out] The number of frames produced.
+    ///
+    /// Either all of the input is consumed or the output is filled (or both).
+    /// Input is consumed only as far as needed to fill the output so the
+    /// amount of data held inside the resampler stays bounded by the filter
+    /// length.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+
+    void process( float const * LE_RESTRICT const pInput, unsigned int & inputFrames, float * LE_RESTRICT const pOutput, unsigned int & outputFrames )
+    {
+        unsigned int const channels( numberOfChannels_ );
+        unsigned int const capacity( numberOfTaps_ - 1 + blockSize );
+        unsigned int consumed( 0 );
+        unsigned int produced( 0 );
+        for ( ; ; )
+        {
+            while ( nextFrame_ < bufferedFrames_ && produced < outputFrames )
+            {
+                float const * LE_RESTRICT const pFilter( &pFilters_[ phase_ * numberOfTaps_ ] );
+                for ( unsigned int channel( 0 ); channel < channels; ++channel )
+                {
+                    float const * LE_RESTRICT const pHistory( &pHistory_[ channel * capacity + nextFrame_ + 1 - numberOfTaps_ ] );
+                    pOutput[ produced * channels + channel ] = dotProduct( pFilter, pHistory, numberOfTaps_ );
+                }
+                ++produced;
+                phase_     += downFactor_;
+                nextFrame_ += phase_ / upFactor_;
+                phase_     %= upFactor_;
+            }
+            if ( produced == outputFrames || consumed == inputFrames )
+                break;
+
+            // Discard the history no longer needed and append (only) as much
+            // input as is needed for the remaining output.
+            std::uint64_t const needed ( nextFrame_ + 1 + ( phase_ + static_cast<std::uint64_t>( outputFrames - produced - 1 ) * downFactor_ ) / upFactor_ );
+            unsigned int  const discard( std::min( nextFrame_, bufferedFrames_ ) + 1 - numberOfTaps_ );
+            unsigned int  const keep   ( bufferedFrames_ - discard );
+            unsigned int  const append ( static_cast<unsigned int>( std::min<std::uint64_t>( std::min( capacity - keep, inputFrames - consumed ), needed - bufferedFrames_ ) ) );
+            for ( unsigned int channel( 0 ); channel < channels; ++channel )
+            {
+                float * const pChannel( &pHistory_[ channel * capacity ] );
+                std::copy( pChannel + discard, pChannel + bufferedFrames_, pChannel );
+                for ( unsigned int frame( 0 ); frame < append; ++frame )
+                    pChannel[ keep + frame ] = pInput[ ( consumed + frame ) * channels + channel ];
+            }
+            bufferedFrames_  = keep + append;
+            nextFrame_      -= discard;
+            consumed        += append;
+        }
+        inputFrames  = consumed;
+        outputFrames = produced;
+    }
+
+    /// \return The number of output frames corresponding to the given number
+    /// of input frames (rounded up).
+    unsigned int outputLength( unsigned int const inputFrames ) const
+    {
+        return static_cast<unsigned int>( ( static_cast<std::uint64_t>( inputFrames ) * upFactor_ + downFactor_ - 1 ) / downFactor_ );
+    }
+
+    /// \return The (exact) delay introduced by the linear phase filter in
+    /// output frames (i.e. the number of leading output frames to skip for the
+    /// output to be aligned with the input).
+    unsigned int latencyInOutputFrames() const { return upFactor_ * numberOfTaps_ / 2 / downFactor_; }
+
+    /// \return The number of trailing (zero) input frames needed to flush the
+    /// filter.
+    unsigned int flushLengthInInputFrames() const { return numberOfTaps_; }
+
+private:
+    static float dotProduct( float const * LE_RESTRICT const pA, float const * LE_RESTRICT const pB, unsigned int const length )
+    {
+        float sum0( 0 ), sum1( 0 ), sum2( 0 ), sum3( 0 );
+        for ( unsigned int index( 0 ); index < length; index += 4 )
+        {
+            sum0 += pA[ index + 0 ] * pB[ index + 0 ];
+            sum1 += pA[ index + 1 ] * pB[ index + 1 ];
+            sum2 += pA[ index + 2 ] * pB[ index + 2 ];
+            sum3 += pA[ index + 3 ] * pB[ index + 3 ];
+        }
+        return ( sum0 + sum1 ) + ( sum2 + sum3 );
+    }
+
+    static double besselI0( double const x )
+    {
+        double sum( 1 ), term( 1 );
+        for ( unsigned int k( 1 ); k < 50; ++k )
+        {
+            double const factor( x / ( 2 * k ) );
+            term *= factor * factor;
+            sum  += term;
+            if ( term < sum * 1e-12 )
+                break;
+        }
+        return sum;
+    }
+
+private: // noncopyable
+    Resampler( Resampler const & );
+    void operator=( Resampler const & );
+
+private:
+    static unsigned int const maximumNumberOfPhases = 4096;
+    static unsigned int const maximumNumberOfTaps   = 4096;
+    static unsigned int const blockSize             = 1024;
+
+    std::unique_ptr<float[]> pFilters_; // upFactor_ phases x numberOfTaps_
+    std::unique_ptr<float[]> pHistory_; // numberOfChannels_ x ( numberOfTaps_ - 1 + blockSize )
+
+    unsigned int upFactor_        ;
+    unsigned int downFactor_      ;
+    unsigned int numberOfChannels_;
+    unsigned int numberOfTaps_    ;
+
+    unsigned int bufferedFrames_; // valid frames in each history channel
+    unsigned int nextFrame_     ; // newest history frame used by the next output frame
+    unsigned int phase_         ; // filter phase of the next output frame
+}; // class Resampler
+
+/// @} // group AudioIO
+
+//------------------------------------------------------------------------------
+} // namespace AudioIO
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // resampler_hpp
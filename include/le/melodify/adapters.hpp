@@ -0,0 +1,472 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file adapters.hpp
+/// ------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef adapters_hpp__66E4F0B4_8C9A_4C1B_9D43_7F2B1A6E0C58
+#define adapters_hpp__66E4F0B4_8C9A_4C1B_9D43_7F2B1A6E0C58
+#pragma once
+//------------------------------------------------------------------------------
+#include "melodifyer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Melodify
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Melodifyer::process() adapters for data layouts other than the native
+/// (interleaved float) one.
+///
+/// The adapters convert the data in small, cache resident chunks (using a
+/// fixed amount of stack space) so that they never require full length
+/// intermediate buffers and are usable from real time callbacks. Their inner
+/// loops are instantiated separately for mono, stereo and any other channel
+/// count (see Detail::dispatch()) so that the common cases have compile time
+/// trip counts and no per sample channel loop overhead.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+typedef float const * LE_RESTRICT const * LE_RESTRICT PlanarInputData ; ///< A pointer to an array of pointers to read-only channel data (same as AudioIO::Device::InputData).
+typedef float       * LE_RESTRICT const * LE_RESTRICT PlanarOutputData; ///< A pointer to an array of pointers to channel data (same as AudioIO::Device::OutputData).
+
+/// A packed (three byte, little endian) 24 bit PCM sample (as stored in 24 bit
+/// WAVE files).
+struct PackedInt24 { unsigned char bytes[ 3 ]; };
+
+namespace Detail
+{
+    /// Size (in samples) of each of the stack buffers used by the adapters.
+    unsigned int const adapterChunkSize = 1024;
+
+    /// \return The compile time channel count if there is one (non-zero
+    /// FixedChannels), the runtime one otherwise.
+    template <unsigned int FixedChannels>
+    unsigned int channelCount( unsigned int const numberOfChannels ) { return FixedChannels ? FixedChannels : numberOfChannels; }
+
+    /// <B>Effect:</B> Calls <VAR>kernel.template run<FixedChannels>()</VAR>
+    /// with FixedChannels being 1, 2 or 0 (any other, runtime, channel count).<BR>
+    template <class Kernel>
+    void dispatch( unsigned int const numberOfChannels, Kernel const & kernel )
+    {
+        switch ( numberOfChannels )
+        {
+            case 1 : kernel.template run<1>(); break;
+            case 2 : kernel.template run<2>(); break;
+            default: kernel.template run<0>(); break;
+        }
+    }
+
+    template <unsigned int FixedChannels>
+    void interleave( PlanarInputData const pChannels, unsigned int const offset, float * LE_RESTRICT const pOutput, unsigned int const runtimeChannels, unsigned int const numberOfSamples )
+    {
+        unsigned int const numberOfChannels( channelCount<FixedChannels>( runtimeChannels ) );
+        for ( unsigned int channel( 0 ); channel < numberOfChannels; ++channel )
+        {
+            float const * LE_RESTRICT const pInput( pChannels[ channel ] + offset );
+            for ( unsigned int sample( 0 ); sample < numberOfSamples; ++sample )
+                pOutput[ sample * numberOfChannels + channel ] = pInput[ sample ];
+        }
+    }
+
+    template <unsigned int FixedChannels>
+    void deinterleave( float const * LE_RESTRICT const pInput, PlanarOutputData const pChannels, unsigned int const offset, unsigned int const runtimeChannels, unsigned int const numberOfSamples )
+    {
+        unsigned int const numberOfChannels( channelCount<FixedChannels>( runtimeChannels ) );
+        for ( unsigned int channel( 0 ); channel < numberOfChannels; ++channel )
+        {
+            float * LE_RESTRICT const pOutput( pChannels[ channel ] + offset );
+            for ( unsigned int sample( 0 ); sample < numberOfSamples; ++sample )
+                pOutput[ sample ] = pInput[ sample * numberOfChannels + channel ];
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Integer PCM <-> float conversion (full scale maps to [-1, 1), out of
+    // range output is clipped).
+    ////////////////////////////////////////////////////////////////////////////
+
+    inline float toFloat( std::int16_t const sample ) { return sample * ( 1.0f / 32768 ); }
+    inline float toFloat( PackedInt24  const sample )
+    {
+        std::int32_t const value( static_cast<std::int32_t>( ( sample.bytes[ 0 ] << 8 ) | ( sample.bytes[ 1 ] << 16 ) | ( static_cast<std::uint32_t>( sample.bytes[ 2 ] ) << 24 ) ) >> 8 );
+        return value * ( 1.0f / 8388608 );
+    }
+
+    inline std::int32_t quantize( float const sample, float const scale, std::int32_t const maximum )
+    {
+        float const scaled( std::floor( sample * scale + 0.5f ) );
+        return static_cast<std::int32_t>( std::max<float>( -scale, std::min<float>( scaled, static_cast<float>( maximum ) ) ) );
+    }
+
+    inline void fromFloat( float const sample, std::int16_t & output ) { output = static_cast<std::int16_t>( quantize( sample, 32768, 32767 ) ); }
+    inline void fromFloat( float const sample, PackedInt24  & output )
+    {
+        std::uint32_t const value( static_cast<std::uint32_t>( quantize( sample, 8388608, 8388607 ) ) );
+        output.bytes[ 0 ] = static_cast<unsigned char>( value       );
+        output.bytes[ 1 ] = static_cast<unsigned char>( value >>  8 );
+        output.bytes[ 2 ] = static_cast<unsigned char>( value >> 16 );
+    }
+
+    template <unsigned int FixedChannels, typename Sample>
+    void processPCM
+    (
+        Melodifyer const &       melodifyer     ,
+        Sample     const * const pVoiceData     ,
+        Sample     const * const pBackgroundData,
+        Sample           * const pOutputData    ,
+        unsigned int       const runtimeChannels,
+        unsigned int       const numberOfSamples
+    )
+    {
+        unsigned int const numberOfChannels( channelCount<FixedChannels>( runtimeChannels ) );
+
+        float voice     [ adapterChunkSize ];
+        float background[ adapterChunkSize ];
+        float output    [ adapterChunkSize ];
+
+        unsigned int const chunkFrames ( adapterChunkSize / numberOfChannels );
+        unsigned int const chunkSamples( chunkFrames      * numberOfChannels );
+        unsigned int const totalSamples( numberOfSamples  * numberOfChannels );
+        for ( unsigned int offset( 0 ); offset < totalSamples; offset += chunkSamples )
+        {
+            unsigned int const samples( std::min( chunkSamples, totalSamples - offset ) );
+            for ( unsigned int sample( 0 ); sample < samples; ++sample )
+                voice[ sample ] = toFloat( pVoiceData[ offset + sample ] );
+            if ( pBackgroundData )
+            {
+                for ( unsigned int sample( 0 ); sample < samples; ++sample )
+                    background[ sample ] = toFloat( pBackgroundData[ offset + sample ] );
+            }
+            melodifyer.process( voice, pBackgroundData ? background : nullptr, output, samples / numberOfChannels );
+            for ( unsigned int sample( 0 ); sample < samples; ++sample )
+                fromFloat( output[ sample ], pOutputData[ offset + sample ] );
+        }
+    }
+
+    template <unsigned int FixedChannels>
+    void processPlanar
+    (
+        Melodifyer       const &       melodifyer         ,
+        PlanarInputData          const pVoiceChannels     ,
+        PlanarInputData          const pBackgroundChannels,
+        PlanarOutputData         const pOutputChannels    ,
+        unsigned int             const runtimeChannels    ,
+        unsigned int             const numberOfSamples
+    )
+    {
+        unsigned int const numberOfChannels( channelCount<FixedChannels>( runtimeChannels ) );
+
+        float voice     [ adapterChunkSize ];
+        float background[ adapterChunkSize ];
+        float output    [ adapterChunkSize ];
+
+        unsigned int const chunkFrames( adapterChunkSize / numberOfChannels );
+        for ( unsigned int sample( 0 ); sample < numberOfSamples; sample += chunkFrames )
+        {
+            unsigned int const frames( std::min( chunkFrames, numberOfSamples - sample ) );
+            interleave<FixedChannels>( pVoiceChannels, sample, voice, numberOfChannels, frames );
+            if ( pBackgroundChannels )
+                interleave<FixedChannels>( pBackgroundChannels, sample, background, numberOfChannels, frames );
+            melodifyer.process( voice, pBackgroundChannels ? background : nullptr, output, frames );
+            deinterleave<FixedChannels>( output, pOutputChannels, sample, numberOfChannels, frames );
+        }
+    }
+
+    /// <B>Effect:</B> output[ frame ][ channel ] = voiceGain[ channel ] *
+    /// voice[ frame ] + background[ frame ][ channel ] for a mono voice and a
+    /// multichannel background (the output may be the same buffer as either
+    /// input: the frames are processed last to first).<BR>
+    template <unsigned int FixedChannels>
+    void mixIntoBed
+    (
+        float const * const pVoiceData        ,
+        float const * const pBackgroundData   ,
+        float       * const pOutputData       ,
+        float const * const pVoiceChannelGains,
+        unsigned int  const runtimeChannels   ,
+        unsigned int  const numberOfSamples
+    )
+    {
+        unsigned int const numberOfChannels( channelCount<FixedChannels>( runtimeChannels ) );
+        for ( unsigned int frame( numberOfSamples ); frame--; )
+        {
+            float const voice( pVoiceData[ frame ] );
+            for ( unsigned int channel( 0 ); channel < numberOfChannels; ++channel )
+            {
+                unsigned int const sample( frame * numberOfChannels + channel );
+                float        const gain  ( pVoiceChannelGains ? pVoiceChannelGains[ channel ] : 1.0f );
+                pOutputData[ sample ] = gain * voice + ( pBackgroundData ? pBackgroundData[ sample ] : 0.0f );
+            }
+        }
+    }
+
+    // Kernel functors for dispatch() (C++11 has no generic lambdas).
+
+    struct PlanarKernel
+    {
+        template <unsigned int FixedChannels>
+        void run() const { processPlanar<FixedChannels>( melodifyer, pVoice, pBackground, pOutput, numberOfChannels, numberOfSamples ); }
+
+        Melodifyer       const & melodifyer;
+        PlanarInputData          pVoice, pBackground;
+        PlanarOutputData         pOutput;
+        unsigned int             numberOfChannels, numberOfSamples;
+    }; // struct PlanarKernel
+
+    template <typename Sample>
+    struct PCMKernel
+    {
+        template <unsigned int FixedChannels>
+        void run() const { processPCM<FixedChannels>( melodifyer, pVoice, pBackground, pOutput, numberOfChannels, numberOfSamples ); }
+
+        Melodifyer const & melodifyer;
+        Sample     const * pVoice, * pBackground;
+        Sample           * pOutput;
+        unsigned int       numberOfChannels, numberOfSamples;
+    }; // struct PCMKernel
+
+    struct BedKernel
+    {
+        template <unsigned int FixedChannels>
+        void run() const { mixIntoBed<FixedChannels>( pVoice, pBackground, pOutput, pVoiceChannelGains, numberOfChannels, numberOfSamples ); }
+
+        float const * pVoice, * pBackground;
+        float       * pOutput;
+        float const * pVoiceChannelGains;
+        unsigned int  numberOfChannels, numberOfSamples;
+    }; // struct BedKernel
+} // namespace Detail
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// process()
+// ---------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Planar (non-interleaved) process function.
+///
+/// \param pVoiceChannels      Pointer to an array of pointers to input voice
+///                            channel data.
+/// \param pBackgroundChannels Pointer to an array of pointers to background
+///                            channel data (optional, may be nullptr).
+/// \param pOutputChannels     Pointer to an array of pointers to output channel
+///                            data.
+/// \param numberOfChannels    Must match the numberOfChannels parameter of
+///                            the last call to Melodifyer::setup().
+/// \param numberOfSamples     Number of sample frames to process (no limit).
+///
+/// The signature matches the layout of the AudioIO::Device non-interleaved
+/// (InputOutputCallback) data so that the planar buffers of a device callback
+/// can be passed directly.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline void process
+(
+    Melodifyer       const &       melodifyer         ,
+    PlanarInputData          const pVoiceChannels     ,
+    PlanarInputData          const pBackgroundChannels,
+    PlanarOutputData         const pOutputChannels    ,
+    unsigned int             const numberOfChannels   ,
+    unsigned int             const numberOfSamples
+)
+{
+    Detail::PlanarKernel const kernel = { melodifyer, pVoiceChannels, pBackgroundChannels, pOutputChannels, numberOfChannels, numberOfSamples };
+    Detail::dispatch( numberOfChannels, kernel );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// processInPlace()
+// ----------------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Interleaved process function that, unlike Melodifyer::process(),
+/// allows <VAR>pOutputData</VAR> to be the same buffer as either
+/// <VAR>pVoiceData</VAR> or <VAR>pBackgroundData</VAR> (partial overlaps are
+/// not supported).
+///
+/// The parameters have the same meaning as those of Melodifyer::process()
+/// with the addition of <VAR>numberOfChannels</VAR> which must match the
+/// numberOfChannels parameter of the last call to Melodifyer::setup().
+///
+/// The aliased input is copied, one small stack resident chunk at a time,
+/// before the corresponding output is produced so this saves a full length
+/// output buffer (e.g. in offline renders) and lets device callbacks process
+/// straight into the output buffer they are handed.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline void processInPlace
+(
+    Melodifyer const &       melodifyer      ,
+    float      const * const pVoiceData      ,
+    float      const * const pBackgroundData ,
+    float            * const pOutputData     ,
+    unsigned int       const numberOfChannels,
+    unsigned int       const numberOfSamples
+)
+{
+    using namespace Detail;
+
+    bool const voiceAliased     ( pOutputData == pVoiceData                         );
+    bool const backgroundAliased( pOutputData == pBackgroundData && pBackgroundData );
+    if ( !voiceAliased && !backgroundAliased )
+    {
+        melodifyer.process( pVoiceData, pBackgroundData, pOutputData, numberOfSamples );
+        return;
+    }
+
+    float input[ adapterChunkSize ];
+
+    unsigned int const chunkFrames ( adapterChunkSize / numberOfChannels );
+    unsigned int const chunkSamples( chunkFrames      * numberOfChannels );
+    for ( unsigned int offset( 0 ); offset < numberOfSamples * numberOfChannels; offset += chunkSamples )
+    {
+        unsigned int const samples( std::min( chunkSamples, numberOfSamples * numberOfChannels - offset ) );
+        std::copy_n( &pOutputData[ offset ], samples, input );
+        melodifyer.process
+        (
+            voiceAliased      ? input : &pVoiceData[ offset ],
+            backgroundAliased ? input : ( pBackgroundData ? &pBackgroundData[ offset ] : nullptr ),
+            &pOutputData[ offset ],
+            samples / numberOfChannels
+        );
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// process()
+// ---------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integer PCM (16 bit and packed 24 bit) interleaved process
+/// functions.
+///
+/// The parameters have the same meaning as those of Melodifyer::process()
+/// with the addition of <VAR>numberOfChannels</VAR> which must match the
+/// numberOfChannels parameter of the last call to Melodifyer::setup().
+///
+/// The conversions to and from float are fused with the processing, one
+/// small stack resident chunk at a time, so that integer PCM data (e.g. from
+/// and for WAVE files) can be processed without full length float buffers or
+/// separate conversion passes. The output is rounded and clipped and may be
+/// the same buffer as either input.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline void process
+(
+    Melodifyer   const &       melodifyer      ,
+    std::int16_t const * const pVoiceData      ,
+    std::int16_t const * const pBackgroundData ,
+    std::int16_t       * const pOutputData     ,
+    unsigned int         const numberOfChannels,
+    unsigned int         const numberOfSamples
+)
+{
+    Detail::PCMKernel<std::int16_t> const kernel = { melodifyer, pVoiceData, pBackgroundData, pOutputData, numberOfChannels, numberOfSamples };
+    Detail::dispatch( numberOfChannels, kernel );
+}
+
+inline void process ///< \overload
+(
+    Melodifyer  const &       melodifyer      ,
+    PackedInt24 const * const pVoiceData      ,
+    PackedInt24 const * const pBackgroundData ,
+    PackedInt24       * const pOutputData     ,
+    unsigned int        const numberOfChannels,
+    unsigned int        const numberOfSamples
+)
+{
+    Detail::PCMKernel<PackedInt24> const kernel = { melodifyer, pVoiceData, pBackgroundData, pOutputData, numberOfChannels, numberOfSamples };
+    Detail::dispatch( numberOfChannels, kernel );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// processMultichannel()
+// ---------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Melodifies a mono voice into a background bed with an arbitrary
+/// number of channels (e.g. 5.1).
+///
+/// \param melodifyer         Melodifyer set up for <B>one</B> channel.
+/// \param pVoiceData         Mono voice.
+/// \param pBackgroundData    Interleaved, <VAR>numberOfChannels</VAR> channel,
+///                           background (optional, may be nullptr), aligned
+///                           the same way as for Melodifyer::process().
+/// \param pOutputData        Interleaved, <VAR>numberOfChannels</VAR> channel,
+///                           output (may be the same buffer as the
+///                           background).
+/// \param pVoiceChannelGains The gain with which the melodified voice is
+///                           mixed into each output channel (e.g. only into
+///                           the centre channel of a 5.1 bed, see
+///                           centreVoiceGains()). Optional, the
+///                           voice goes into every channel at unity gain if
+///                           nullptr.
+///
+/// The Melodifyer itself processes mono or stereo data so the voice is
+/// melodified as mono (without the background, i.e. the automatic voice gain
+/// correction does not take the bed into account) and then mixed into the
+/// bed, one stack resident chunk at a time.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline void processMultichannel
+(
+    Melodifyer const &       melodifyer        ,
+    float      const * const pVoiceData        ,
+    float      const * const pBackgroundData   ,
+    float            * const pOutputData       ,
+    unsigned int       const numberOfChannels  ,
+    unsigned int       const numberOfSamples   ,
+    float      const * const pVoiceChannelGains = nullptr
+)
+{
+    using namespace Detail;
+
+    float voice[ adapterChunkSize ];
+    for ( unsigned int frame( 0 ); frame < numberOfSamples; frame += adapterChunkSize )
+    {
+        unsigned int const frames( std::min( adapterChunkSize, numberOfSamples - frame ) );
+        unsigned int const offset( frame * numberOfChannels                              );
+        melodifyer.process( &pVoiceData[ frame ], nullptr, voice, frames );
+        BedKernel const kernel = { voice, pBackgroundData ? &pBackgroundData[ offset ] : nullptr, &pOutputData[ offset ], pVoiceChannelGains, numberOfChannels, frames };
+        dispatch( numberOfChannels, kernel );
+    }
+}
+
+/// @} // group Melodify
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // adapters_hpp
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file batch.hpp
+/// ---------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef batch_hpp__E2BCE5E4_52A8_4404_8693_865C77E0F790
+#define batch_hpp__E2BCE5E4_52A8_4404_8693_865C77E0F790
+#pragma once
+//------------------------------------------------------------------------------
+#include "melodifyer.hpp"
+
+#include "le/utility/parallel.hpp"
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Melodify
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \struct MelodifyerStream
+///
+/// \brief One independent voice/background/output stream triple together with
+/// the Melodifyer instance that owns its processing state.
+///
+/// The data pointers follow the exact same rules as the parameters of
+/// Melodifyer::process() (interleaved channels, the number of channels given
+/// in the last setup() call of the corresponding Melodifyer, optional
+/// background). They are advanced by process() so that consecutive batch
+/// calls can be made with the same array of MelodifyerStream objects.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+struct MelodifyerStream
+{
+    Melodifyer const * pMelodifyer     ;
+    float      const * pVoiceData      ;
+    float      const * pBackgroundData ;
+    float            * pOutputData     ;
+    unsigned int       numberOfChannels;
+}; // struct MelodifyerStream
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// process()
+// ---------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Batch process function: processes <VAR>numberOfSamples</VAR> sample
+/// frames of each of the given streams in a single call.
+///
+/// \param pStreams        Pointer to an array of stream descriptors (all
+///                        the streams in a batch must refer to different
+///                        Melodifyer instances).
+/// \param numberOfStreams Number of elements in the <VAR>pStreams</VAR> array.
+/// \param numberOfSamples Number of sample frames to process in each stream.
+/// \param pWorkerPool     Optional, if not nullptr the streams are
+///                        distributed across the threads of the given pool.
+///
+/// The stream data pointers are advanced past the processed data.
+///
+/// \note The SpectrumWorx engine kernels are compiled into the SDK binary and
+/// operate on a single stream, so the batch is not vectorized across streams.
+/// The gain comes from amortizing the dispatch over the whole batch and from
+/// keeping all the cores of a server busy with one call per block.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline void process
+(
+    MelodifyerStream        * const pStreams       ,
+    unsigned int              const numberOfStreams,
+    unsigned int              const numberOfSamples,
+    Utility::WorkerPool     * const pWorkerPool = nullptr
+)
+{
+    struct StreamProcessor
+    {
+        void operator()( unsigned int const streamIndex ) const
+        {
+            MelodifyerStream & stream( pStreams[ streamIndex ] );
+            stream.pMelodifyer->process( stream.pVoiceData, stream.pBackgroundData, stream.pOutputData, numberOfSamples );
+
+            unsigned int const interleavedSamples( numberOfSamples * stream.numberOfChannels );
+            stream.pVoiceData  += interleavedSamples;
+            stream.pOutputData += interleavedSamples;
+            if ( stream.pBackgroundData ) stream.pBackgroundData += interleavedSamples;
+        }
+
+        MelodifyerStream * pStreams       ;
+        unsigned int       numberOfSamples;
+    } processor = { pStreams, numberOfSamples };
+
+    if ( pWorkerPool )
+        pWorkerPool->parallelFor( numberOfStreams, processor );
+    else
+        for ( unsigned int stream( 0 ); stream < numberOfStreams; ++stream )
+            processor( stream );
+}
+
+/// @} // group Melodify
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // batch_hpp
@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file compiledMelody.hpp
+/// ------------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef compiledMelody_hpp__3B8E2F61_0C4D_4A97_B5E2_9D1F6A7C3E84
+#define compiledMelody_hpp__3B8E2F61_0C4D_4A97_B5E2_9D1F6A7C3E84
+#pragma once
+//------------------------------------------------------------------------------
+#include "melodifyer.hpp"
+#include "midiMelody.hpp"
+
+#include "le/utility/filesystem.hpp"
+
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <tuple>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Melodify
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class CompiledMelody
+///
+/// \brief An immutable, reference counted melody that is parsed once and can
+/// then be attached to any number of Melodifyer instances.
+///
+/// A CompiledMelody holds the parsed MIDIMelody and a normalized MIDI file
+/// (in Utility::Temporaries) containing only the tempo map and the melody
+/// track. Attaching it therefore does not touch the original MIDI file at all,
+/// the Melodifyer only parses the (minimal) normalized file. The normalized
+/// file lives as long as the last reference to the CompiledMelody.
+///
+/// CompiledMelody objects are safe to share between threads.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class CompiledMelody
+{
+public:
+    typedef std::shared_ptr<CompiledMelody const> Ptr;
+
+    /// <B>Effect:</B> Compiles the given, already parsed, melody.<BR>
+    /// \return nullptr if successful, pointer to an error message string otherwise.
+    static char const * create( MIDIMelody const & melody, Ptr & pCompiledMelody )
+    {
+        pCompiledMelody.reset();
+        if ( !melody )
+            return "Invalid melody.";
+        std::string path( temporaryMelodyPath() );
+        if ( char const * const pError = melody.save( path.c_str() ) )
+            return pError;
+        CompiledMelody * const pNewMelody( new ( std::nothrow ) CompiledMelody( melody, path ) );
+        if ( !pNewMelody )
+        {
+            std::remove( path.c_str() );
+            return "Out of memory.";
+        }
+        pCompiledMelody.reset( pNewMelody );
+        return nullptr;
+    }
+
+    /// <B>Effect:</B> Loads and compiles the given melody track and channel from the given MIDI file.<BR>
+    /// \return nullptr if successful, pointer to an error message string otherwise.
+    template <Utility::SpecialLocations rootLocation>
+    static char const * create( char const * const fileName, unsigned int const melodyTrack, unsigned int const melodyChannel, Ptr & pCompiledMelody )
+    {
+        pCompiledMelody.reset();
+        MIDIMelody melody;
+        if ( char const * const pError = melody.load<rootLocation>( fileName, melodyTrack, melodyChannel ) )
+            return pError;
+        return create( melody, pCompiledMelody );
+    }
+
+    /// <B>Effect:</B> Parses (in place, without copying) and compiles the given melody track and channel from Standard MIDI File data held in memory.<BR>
+    /// \return nullptr if successful, pointer to an error message string otherwise.
+    static char const * create( char const * const pBegin, char const * const pEnd, unsigned int const melodyTrack, unsigned int const melodyChannel, Ptr & pCompiledMelody )
+    {
+        pCompiledMelody.reset();
+        MIDIMelody melody;
+        if ( char const * const pError = melody.parse( pBegin, pEnd, melodyTrack, melodyChannel ) )
+            return pError;
+        return create( melody, pCompiledMelody );
+    }
+
+    static char const * create( Utility::File::MemoryMapping const & mapping, unsigned int const melodyTrack, unsigned int const melodyChannel, Ptr & pCompiledMelody ) ///< \overload
+    {
+        return create( mapping.begin(), mapping.end(), melodyTrack, melodyChannel, pCompiledMelody );
+    }
+
+    ~CompiledMelody() { std::remove( path_.c_str() ); }
+
+    /// <B>Effect:</B> Sets this melody as the melody of the given Melodifyer (the equivalent of Melodifyer::setMelodyMIDIFile()).<BR>
+    /// \return nullptr if successful, pointer to an error message string otherwise.
+    char const * attachTo( Melodifyer & melodifyer ) const
+    {
+        return melodifyer.setMelodyMIDIFile<Utility::AbsolutePath>( path_.c_str(), MIDIMelody::track, melody_.channel() );
+    }
+
+    MIDIMelody const & melody() const { return melody_; }
+
+private:
+    CompiledMelody( MIDIMelody const & melody, std::string & path ) : melody_( melody ) { path_.swap( path ); }
+
+private: // noncopyable
+    CompiledMelody( CompiledMelody const & );
+    void operator=( CompiledMelody const & );
+
+private:
+    MIDIMelody  const melody_;
+    std::string       path_  ;
+}; // class CompiledMelody
+
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class MelodyCache
+///
+/// \brief A thread safe cache of CompiledMelody objects keyed by MIDI file,
+/// melody track and melody channel.
+///
+/// Intended for long running processes that repeatedly use the same set of
+/// melodies: only the first request for a given melody loads and compiles
+/// it, all subsequent requests share the same CompiledMelody.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class MelodyCache
+{
+public:
+    /// \return nullptr if successful, pointer to an error message string otherwise.
+    template <Utility::SpecialLocations rootLocation>
+    char const * get( char const * const fileName, unsigned int const melodyTrack, unsigned int const melodyChannel, CompiledMelody::Ptr & pCompiledMelody )
+    {
+        Key const key( rootLocation, fileName, melodyTrack, melodyChannel );
+        {
+            std::lock_guard<std::mutex> const lock( mutex_ );
+            Melodies::const_iterator const pCached( melodies_.find( key ) );
+            if ( pCached != melodies_.end() )
+            {
+                pCompiledMelody = pCached->second;
+                return nullptr;
+            }
+        }
+
+        // Compile outside of the lock (should two threads race to compile the
+        // same melody the first one to finish wins).
+        if ( char const * const pError = CompiledMelody::create<rootLocation>( fileName, melodyTrack, melodyChannel, pCompiledMelody ) )
+            return pError;
+
+        std::lock_guard<std::mutex> const lock( mutex_ );
+        pCompiledMelody = melodies_.insert( Melodies::value_type( key, pCompiledMelody ) ).first->second;
+        return nullptr;
+    }
+
+    /// <B>Effect:</B> Releases the cache's references to all the melodies (melodies still referenced elsewhere stay alive).<BR>
+    void clear()
+    {
+        std::lock_guard<std::mutex> const lock( mutex_ );
+        melodies_.clear();
+    }
+
+private:
+    typedef std::tuple<int, std::string, unsigned int, unsigned int> Key;
+    typedef std::map<Key, CompiledMelody::Ptr>                       Melodies;
+
+    std::mutex mutex_   ;
+    Melodies   melodies_;
+}; // class MelodyCache
+
+/// @} // group Melodify
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // compiledMelody_hpp
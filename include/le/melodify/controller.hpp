@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file controller.hpp
+/// --------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef controller_hpp__76AF8B5B_C4C4_4B45_BFBF_5E02911CF1A5
+#define controller_hpp__76AF8B5B_C4C4_4B45_BFBF_5E02911CF1A5
+#pragma once
+//------------------------------------------------------------------------------
+#include "adapters.hpp"
+#include "melodifyer.hpp"
+#include "midiMelody.hpp"
+
+#include "le/utility/assert.hpp"
+#include "le/utility/ringBuffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Melodify
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class MelodifyerController
+///
+/// \brief Applies setting changes and melody swaps to a Melodifyer that is
+/// being used for real time processing, without stopping the stream or
+/// blocking the audio thread.
+///
+/// The control thread issues commands through a wait-free
+/// Utility::RingBuffer; the audio thread (process()) applies them, in order,
+/// at block boundaries. A melody swap is prepared entirely on the control
+/// thread: a second Melodifyer is set up with the new melody positioned at
+/// the requested stream position and is then handed over to the audio thread
+/// which switches to it at exactly that position. During the switch both
+/// instances run for twice the latency: the output of the old one is used
+/// until the new one has produced latencyInSamples() of output and is then
+/// crossfaded into the new one over another latencyInSamples(). Retired
+/// instances are handed back and destroyed on the control thread so
+/// process() never allocates, frees, locks or touches files.
+///
+/// \note All the control functions must be called from the same (control)
+/// thread and process() from the same (audio) thread.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class MelodifyerController
+{
+public:
+    /// \param queueCapacity Maximum number of commands in flight.
+    MelodifyerController( unsigned int const sampleRate, unsigned int const numberOfChannels, unsigned int const queueCapacity = 64 )
+        :
+        sampleRate_                  ( sampleRate        ),
+        numberOfChannels_            ( numberOfChannels  ),
+        commands_                    ( queueCapacity     ),
+        retired_                     ( 2 * queueCapacity ),
+        automaticVoiceGainCorrection_( false             ),
+        extraVoiceGainCorrection_    ( 1                 ),
+        pActive_                     ( nullptr           ),
+        pOutgoing_                   ( nullptr           ),
+        transitionPosition_          ( 0                 ),
+        position_                    ( 0                 )
+    {}
+
+    ~MelodifyerController()
+    {
+        Command command;
+        while ( commands_.pop( command ) )
+            delete command.pMelodifyer;
+        collectGarbage();
+        delete pOutgoing_;
+        delete pActive_  ;
+    }
+
+    /// \name Control thread interface
+    /// @{
+
+    /// <B>Effect:</B> Sets up the initial Melodifyer instance (must be called
+    /// before streaming starts).<BR>
+    /// \return nullptr if successful, pointer to an error message string otherwise.
+    char const * initialize( MIDIMelody const & melody )
+    {
+        if ( !commands_ || !retired_ )
+            return "Out of memory.";
+        LE_ASSERT( !pActive_ );
+        return prepare( melody, 0, pActive_ );
+    }
+
+    /// <B>Effect:</B> Queues a melody swap that takes effect at the given
+    /// stream position (if the audio thread is already past it when the
+    /// command arrives, the swap happens immediately with the new melody
+    /// correspondingly late).<BR>
+    /// \return nullptr if successful, pointer to an error message string otherwise.
+    char const * swapMelody( MIDIMelody const & melody, std::uint32_t const atPosition )
+    {
+        collectGarbage();
+        Melodifyer * pMelodifyer;
+        if ( char const * const pError = prepare( melody, atPosition, pMelodifyer ) )
+            return pError;
+        Command const command = { Command::SwapMelody, 0, pMelodifyer, atPosition };
+        if ( !commands_.push( command ) )
+        {
+            delete pMelodifyer;
+            return "Command queue full.";
+        }
+        return nullptr;
+    }
+
+    /// \return False if the command queue is full (the command is not queued).
+    bool setAutomaticVoiceGainCorrection( bool const enabled )
+    {
+        Command const command = { Command::SetAutomaticVoiceGainCorrection, enabled ? 1.0f : 0.0f, nullptr, 0 };
+        if ( !commands_.push( command ) )
+            return false;
+        automaticVoiceGainCorrection_ = enabled;
+        return true;
+    }
+
+    /// \return False if the command queue is full (the command is not queued).
+    bool setExtraVoiceGainCorrection( float const linearValue )
+    {
+        Command const command = { Command::SetExtraVoiceGainCorrection, linearValue, nullptr, 0 };
+        if ( !commands_.push( command ) )
+            return false;
+        extraVoiceGainCorrection_ = linearValue;
+        return true;
+    }
+
+    /// <B>Effect:</B> Queues a Melodifyer::reset() which also restarts the stream position.<BR>
+    /// \return False if the command queue is full (the command is not queued).
+    bool reset()
+    {
+        Command const command = { Command::Reset, 0, nullptr, 0 };
+        return commands_.push( command );
+    }
+
+    /// <B>Effect:</B> Destroys the instances retired by the audio thread
+    /// (also done by swapMelody()).<BR>
+    void collectGarbage()
+    {
+        Melodifyer * pRetired;
+        while ( retired_.pop( pRetired ) )
+            delete pRetired;
+    }
+
+    /// \return The stream position (in sample frames) reached by the audio thread.
+    std::uint32_t position() const { return position_.load( std::memory_order_relaxed ); }
+    /// @}
+
+    /// \name Audio thread interface
+    /// @{
+
+    /// <B>Effect:</B> Applies the due commands and processes the given data
+    /// (same parameters as Melodifyer::process()).<BR>
+    void process
+    (
+        float const * const pVoiceData     ,
+        float const * const pBackgroundData,
+        float       * const pOutputData    ,
+        unsigned int  const numberOfSamples
+    )
+    {
+        LE_ASSERT( pActive_ );
+        unsigned int const chunkFrames( Detail::adapterChunkSize / numberOfChannels_ );
+        std::uint32_t position( position_.load( std::memory_order_relaxed ) );
+        for ( unsigned int frame( 0 ); frame < numberOfSamples; )
+        {
+            unsigned int frames( numberOfSamples - frame );
+            while ( Command const * const pCommand = commands_.front() )
+            {
+                if ( pCommand->type == Command::SwapMelody && pCommand->position > position )
+                {
+                    frames = std::min<std::uint32_t>( frames, pCommand->position - position );
+                    break;
+                }
+                Command command;
+                commands_.pop( command );
+                apply( command, position );
+            }
+
+            unsigned int const offset( frame * numberOfChannels_ );
+            float const * const pVoice     ( &pVoiceData[ offset ] );
+            float const * const pBackground( pBackgroundData ? &pBackgroundData[ offset ] : nullptr );
+            float       * const pOutput    ( &pOutputData[ offset ] );
+            if ( !pOutgoing_ )
+            {
+                pActive_->process( pVoice, pBackground, pOutput, frames );
+            }
+            else
+            {
+                unsigned int const latency( pActive_->latencyInSamples() );
+                frames = std::min( frames, std::min( chunkFrames, 2 * latency - transitionPosition_ ) );
+
+                float incoming[ Detail::adapterChunkSize ];
+                pOutgoing_->process( pVoice, pBackground, pOutput , frames );
+                pActive_  ->process( pVoice, pBackground, incoming, frames );
+                for ( unsigned int transitionFrame( 0 ); transitionFrame < frames; ++transitionFrame )
+                {
+                    unsigned int const transitionPosition( transitionPosition_ + transitionFrame );
+                    if ( transitionPosition < latency )
+                        continue;
+                    float const weight( ( transitionPosition - latency + 0.5f ) / latency );
+                    for ( unsigned int channel( 0 ); channel < numberOfChannels_; ++channel )
+                    {
+                        unsigned int const sample( transitionFrame * numberOfChannels_ + channel );
+                        pOutput[ sample ] += weight * ( incoming[ sample ] - pOutput[ sample ] );
+                    }
+                }
+                transitionPosition_ += frames;
+                if ( transitionPosition_ == 2 * latency )
+                    retireOutgoing();
+            }
+
+            frame    += frames;
+            position += frames;
+        }
+        position_.store( position, std::memory_order_relaxed );
+    }
+    /// @}
+
+private:
+    struct Command
+    {
+        enum Type { SetAutomaticVoiceGainCorrection, SetExtraVoiceGainCorrection, Reset, SwapMelody };
+
+        Type           type       ;
+        float          value      ;
+        Melodifyer   * pMelodifyer;
+        std::uint32_t  position   ;
+    }; // struct Command
+
+    char const * prepare( MIDIMelody const & melody, std::uint32_t const atPosition, Melodifyer * & pPrepared ) const
+    {
+        pPrepared = nullptr;
+        std::unique_ptr<Melodifyer> pMelodifyer( new ( std::nothrow ) Melodifyer );
+        if ( !pMelodifyer || !pMelodifyer->setup( sampleRate_, numberOfChannels_ ) )
+            return "Out of memory.";
+        pMelodifyer->setAutomaticVoiceGainCorrection( automaticVoiceGainCorrection_ );
+        pMelodifyer->setExtraVoiceGainCorrection    ( extraVoiceGainCorrection_     );
+        if ( char const * const pError = setMelody( *pMelodifyer, atPosition ? melody.trimmed( atPosition / double( sampleRate_ ) ) : melody ) )
+            return pError;
+        pPrepared = pMelodifyer.release();
+        return nullptr;
+    }
+
+    void apply( Command const & command, std::uint32_t & position )
+    {
+        switch ( command.type )
+        {
+            case Command::SetAutomaticVoiceGainCorrection: pActive_->setAutomaticVoiceGainCorrection( command.value != 0 ); break;
+            case Command::SetExtraVoiceGainCorrection    : pActive_->setExtraVoiceGainCorrection    ( command.value      ); break;
+            case Command::Reset:
+                retireOutgoing();
+                pActive_->reset();
+                position = 0;
+                break;
+            case Command::SwapMelody:
+                // A swap arriving during a transition cuts the transition short.
+                retireOutgoing();
+                pOutgoing_          = pActive_;
+                pActive_            = command.pMelodifyer;
+                transitionPosition_ = 0;
+                break;
+        }
+    }
+
+    void retireOutgoing()
+    {
+        if ( !pOutgoing_ )
+            return;
+        // The retired queue has room for every instance that can be in
+        // flight (see swapMelody()).
+        LE_VERIFY( retired_.push( pOutgoing_ ) );
+        pOutgoing_ = nullptr;
+    }
+
+private: // noncopyable
+    MelodifyerController( MelodifyerController const & );
+    void operator=( MelodifyerController const & );
+
+private:
+    unsigned int const sampleRate_      ;
+    unsigned int const numberOfChannels_;
+
+    Utility::RingBuffer<Command     > commands_; // control thread -> audio thread
+    Utility::RingBuffer<Melodifyer *> retired_ ; // audio thread   -> control thread
+
+    // Control thread state.
+    bool  automaticVoiceGainCorrection_;
+    float extraVoiceGainCorrection_    ;
+
+    // Audio thread state.
+    Melodifyer   * pActive_           ;
+    Melodifyer   * pOutgoing_         ;
+    unsigned int   transitionPosition_;
+
+    std::atomic<std::uint32_t> position_;
+}; // class MelodifyerController
+
+/// @} // group Melodify
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // controller_hpp
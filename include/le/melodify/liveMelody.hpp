@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file liveMelody.hpp
+/// --------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef liveMelody_hpp__0569E4EB_8F70_44A7_91B4_40F7982DD8AE
+#define liveMelody_hpp__0569E4EB_8F70_44A7_91B4_40F7982DD8AE
+#pragma once
+//------------------------------------------------------------------------------
+#include "controller.hpp"
+#include "melodifyer.hpp"
+#include "midiMelody.hpp"
+
+#include "le/utility/ringBuffer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Melodify
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \struct LiveNoteEvent
+///
+////////////////////////////////////////////////////////////////////////////////
+
+struct LiveNoteEvent
+{
+    std::uint32_t position; ///< Stream position (in sample frames since the start of processing) at which the event takes effect.
+    unsigned char note    ; ///< MIDI note number.
+    unsigned char velocity; ///< MIDI velocity (zero for note off).
+}; // struct LiveNoteEvent
+
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class LiveMelodyInput
+///
+/// \brief Real time safe intake of live (timestamped) note events that drive
+/// the melody of a MelodifyerController.
+///
+/// A control thread post()s note events, the audio thread runs its stream
+/// through process() which consumes the posted events (stamping each with the
+/// stream position at which it takes effect: its own position or, for late
+/// events, the start of the block in which it is consumed) and then
+/// processes the block through the controller. The control thread of the
+/// controller periodically update()s: it collects the consumed events into a
+/// MIDIMelody (whose timeline is the stream position) and has the controller
+/// swap to it <VAR>lookahead</VAR> sample frames past the current position.
+/// Both hand-overs go through wait-free Utility::RingBuffer queues so
+/// process() never locks or allocates.
+///
+/// Once a swap is posted, the event log drops the events before the swap
+/// position except for the notes still sounding there (so that the next swap
+/// can still retrigger them). The work and memory of update(), and the
+/// preparation time of the swap it posts, therefore depend only on the
+/// events in flight, not on the length of the session.
+///
+/// The prebuilt Melodifyer only takes melodies as MIDI files, on a non real
+/// time thread, so a melody swap (see MelodifyerController) is the only way
+/// for live events to reach the DSP. This determines the latency:
+/// - an event stamped at least <VAR>lookahead</VAR> + 2 x
+///   Melodifyer::latencyInSamples() past the position at which update()
+///   picks it up takes effect exactly at its own position (the swap and the
+///   crossfade into the new melody are complete by then)
+/// - any other (e.g. late) event takes effect at the swap: with update()
+///   called after every block of B frames and a <VAR>lookahead</VAR> of k
+///   blocks (k must cover the time swapMelody() needs to prepare a
+///   Melodifyer), the new melody starts to fade in (k + 1) blocks +
+///   latencyInSamples() after the start of the block in which the event was
+///   consumed and is fully in effect another latencyInSamples() later.
+///
+/// \note process() and MelodifyerController::process() share the stream
+/// position so the controller must not be driven (or reset) otherwise.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class LiveMelodyInput
+{
+public:
+    /// \param capacity Maximum number of events in flight (in each of the two
+    ///                 queues).
+    explicit LiveMelodyInput( unsigned int const capacity = 1024 )
+        : pending_( capacity ), consumed_( capacity ), position_( 0 ), logChanged_( false ) {}
+
+    bool operator!() const { return !pending_ || !consumed_; }
+
+    /// <B>Effect:</B> Queues an event (control thread, wait-free).<BR>
+    /// \return False if the queue is full (the event is not queued), i.e. if
+    /// update() or collect() are not called often enough.
+    bool post( LiveNoteEvent const & event ) { return pending_.push( event ); }
+
+    /// <B>Effect:</B> Consumes the posted events and processes the next
+    /// <VAR>numberOfSamples</VAR> sample frames through the controller (audio
+    /// thread, wait-free, allocation free).<BR>
+    void process
+    (
+        MelodifyerController &       controller     ,
+        float          const * const pVoiceData     ,
+        float          const * const pBackgroundData,
+        float                * const pOutputData    ,
+        unsigned int           const numberOfSamples
+    )
+    {
+        // Events that do not fit stay pending (and are stamped later).
+        for ( unsigned int room( consumed_.freeSpace() ); room; --room )
+        {
+            LiveNoteEvent event;
+            if ( !pending_.pop( event ) )
+                break;
+            event.position = std::max( event.position, position_ );
+            consumed_.push( event );
+        }
+        controller.process( pVoiceData, pBackgroundData, pOutputData, numberOfSamples );
+        position_ += numberOfSamples;
+    }
+
+    /// \return The current stream position (audio thread).
+    std::uint32_t position() const { return position_; }
+
+    /// <B>Effect:</B> If events were consumed since the last swap, swaps the
+    /// controller to the melody of all the consumed events at
+    /// <VAR>lookahead</VAR> sample frames past its current position (control
+    /// thread of the controller, see the class description for the resulting
+    /// latency).<BR>
+    /// \return nullptr if successful, pointer to an error message string otherwise.
+    char const * update( MelodifyerController & controller, unsigned int const sampleRate, std::uint32_t const lookahead, unsigned int const melodyChannel = 0 )
+    {
+        drain();
+        if ( !logChanged_ )
+            return nullptr;
+        MIDIMelody melody;
+        if ( char const * const pError = build( melody, sampleRate, melodyChannel ) )
+            return pError;
+        std::uint32_t const swapPosition( controller.position() + lookahead );
+        if ( char const * const pError = controller.swapMelody( melody, swapPosition ) )
+            return pError;
+        prune( swapPosition );
+        logChanged_ = false;
+        return nullptr;
+    }
+
+    /// <B>Effect:</B> Adds the events consumed since the last call to the
+    /// event log and converts the log into a melody (e.g. to record a session
+    /// when update() is not used, update() prunes the log). The melody's
+    /// timeline starts at stream position zero with one MIDI tick per sample
+    /// frame.<BR>
+    /// \return nullptr if successful, pointer to an error message string otherwise.
+    char const * collect( MIDIMelody & melody, unsigned int const sampleRate, unsigned int const melodyChannel = 0 )
+    {
+        drain();
+        return build( melody, sampleRate, melodyChannel );
+    }
+
+    /// <B>Effect:</B> Restarts the stream position and clears the event log
+    /// (must not be called concurrently with any other member function).<BR>
+    void reset()
+    {
+        LiveNoteEvent event;
+        while ( pending_ .pop( event ) ) {}
+        while ( consumed_.pop( event ) ) {}
+        log_.clear();
+        position_   = 0;
+        logChanged_ = false;
+    }
+
+private:
+    void drain()
+    {
+        // Late events are stamped with the position at which they were
+        // consumed so they can precede earlier consumed (early) ones: each
+        // one is inserted in order (after any events at the same position),
+        // usually at the end.
+        LiveNoteEvent event;
+        while ( consumed_.pop( event ) )
+        {
+            std::vector<LiveNoteEvent>::iterator const pInsert
+            (
+                std::upper_bound
+                (
+                    log_.begin(), log_.end(), event,
+                    []( LiveNoteEvent const & left, LiveNoteEvent const & right ) { return left.position < right.position; }
+                )
+            );
+            log_.insert( pInsert, event );
+            logChanged_ = true;
+        }
+    }
+
+    /// Drops the logged events before the given (swap) position except for
+    /// the note ons still sounding at it.
+    void prune( std::uint32_t const swapPosition )
+    {
+        std::size_t const notFound( ~std::size_t( 0 ) );
+        std::size_t soundingNoteOn[ 128 ];
+        std::fill_n( soundingNoteOn, 128, notFound );
+        std::size_t end( 0 );
+        while ( end < log_.size() && log_[ end ].position < swapPosition )
+        {
+            LiveNoteEvent const & event( log_[ end ] );
+            soundingNoteOn[ event.note & 0x7F ] = event.velocity ? end : notFound;
+            ++end;
+        }
+        std::size_t kept( 0 );
+        for ( std::size_t index( 0 ); index < log_.size(); ++index )
+            if ( index >= end || soundingNoteOn[ log_[ index ].note & 0x7F ] == index )
+                log_[ kept++ ] = log_[ index ];
+        log_.resize( kept );
+    }
+
+    char const * build( MIDIMelody & melody, unsigned int const sampleRate, unsigned int const melodyChannel ) const
+    {
+        // One tick per sample: division / tempo = sampleRate / 1e6 with both
+        // integers.
+        std::uint32_t divisor( 1000000 );
+        for ( std::uint32_t remainder( sampleRate ); remainder; )
+        {
+            std::uint32_t const next( divisor % remainder );
+            divisor   = remainder;
+            remainder = next;
+        }
+        std::uint32_t const division                  ( sampleRate / divisor );
+        std::uint32_t const microsecondsPerQuarterNote( 1000000    / divisor );
+        if ( !sampleRate || division > 0x7FFF )
+            return "Unsupported sample rate.";
+
+        if ( char const * const pError = melody.reset( static_cast<std::uint16_t>( division ), microsecondsPerQuarterNote, melodyChannel ) )
+            return pError;
+        for ( LiveNoteEvent const & logged : log_ )
+            melody.append( logged.position, logged.velocity ? 0x90 : 0x80, logged.note, logged.velocity );
+        return nullptr;
+    }
+
+private: // noncopyable
+    LiveMelodyInput( LiveMelodyInput const & );
+    void operator=( LiveMelodyInput const & );
+
+private:
+    Utility::RingBuffer<LiveNoteEvent> pending_   ; // control thread -> audio thread
+    Utility::RingBuffer<LiveNoteEvent> consumed_  ; // audio thread   -> collector (controller control) thread
+    std::uint32_t                      position_  ; // audio thread
+    std::vector<LiveNoteEvent>         log_       ; // collector thread
+    bool                               logChanged_; // collector thread
+}; // class LiveMelodyInput
+
+/// @} // group Melodify
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // liveMelody_hpp
@@ -50,7 +50,14 @@ namespace SW
 ///     - tuned and melodified voice mixed with the, optional, background.
 ///
 /// \note Except for the gain and latency related functions, none of the member
-/// functions are reentrant or thread safe with respect to each other.
+/// functions are reentrant or thread safe with respect to each other. To change
+/// settings or the melody while a real time stream is running use a
+/// MelodifyerController (see controller.hpp).
+///
+/// \note Melodifyer objects are noncopyable: the internal DSP state refers to
+/// separately allocated buffers so a (bitwise) copy would share, and later
+/// double free, them. To continue a render from an arbitrary point in a new
+/// instance use primeAt() (see timeline.hpp) instead.
 ///
 /// \nosubgrouping
 ///
@@ -160,6 +167,13 @@ public:
     /// purpose (the current version of the Melodify SDK has a fixed latency of
     /// 1024 samples in all circumstances).
     ///
+    /// \note The analysis frame and hop sizes (and with them the latency) are
+    /// fixed by the SpectrumWorx engine build in the SDK binary and cannot be
+    /// selected at setup time. For live monitoring through an AudioIO::Device
+    /// the total latency is latencyInSamples() + Device::latency().first, so
+    /// the remaining tunable is the device buffer size (the
+    /// <VAR>latencyInSamples</VAR> hint of Device::setup()).
+    ///
     ////////////////////////////////////////////////////////////////////////////
 
     LE_NOTHROWNOALIAS unsigned int LE_FASTCALL_ABI latencyInSamples() const;
@@ -213,6 +227,10 @@ public:
     LE_NOTHROWNOALIAS void LE_FASTCALL_ABI reset(); ///< Reset the Melodifyer instance (e.g. before processing a new stream of data).
 
     /// @}
+
+private: // noncopyable
+    Melodifyer( Melodifyer const & );
+    void operator=( Melodifyer const & );
 }; // class Melodifyer
 
 /// @} // group Melodify
@@ -0,0 +1,591 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file midiMelody.hpp
+/// --------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef midiMelody_hpp__04A07670_86AA_48F5_A1B0_F5AD8ACBFD04
+#define midiMelody_hpp__04A07670_86AA_48F5_A1B0_F5AD8ACBFD04
+#pragma once
+//------------------------------------------------------------------------------
+#include "melodifyer.hpp"
+
+#include "le/utility/assert.hpp"
+#include "le/utility/filesystem.hpp"
+#include "le/utility/temporaries.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Melodify
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class MIDIMelody
+///
+/// \brief An in-memory copy of a single melody (one track + channel) from a
+/// Standard MIDI File together with the file's tempo map.
+///
+/// The class exists so that a melody can be manipulated (e.g. trimmed to start
+/// at an arbitrary point in time) before it is handed over to a Melodifyer. As
+/// the Melodifyer only accepts melodies in the form of MIDI files, a
+/// MIDIMelody is passed to it through a small, normalized scratch MIDI file
+/// (see setMelody()) in which the melody always lives in track
+/// MIDIMelody::track.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class MIDIMelody
+{
+public:
+    static unsigned int const track = 1; ///< The melody track in files produced by serialize()/save() (track 0 holds the tempo map).
+
+    MIDIMelody() : division_( 0 ), channel_( 0 ) {}
+
+    /// <B>Effect:</B> Parses the Standard MIDI File data in [<VAR>pBegin</VAR>, <VAR>pEnd</VAR>) and extracts the channel messages of the given track and channel (and the tempo map of the whole file).<BR>
+    /// \return nullptr if successful, pointer to an error message string otherwise.
+    /// The data is parsed in place (it is not copied) and need not outlive the
+    /// call.
+    char const * parse( unsigned char const * pBegin, unsigned char const * pEnd, unsigned int melodyTrack, unsigned int melodyChannel );
+    char const * parse( char const * const pBegin, char const * const pEnd, unsigned int const melodyTrack, unsigned int const melodyChannel ) ///< \overload
+    {
+        return parse( reinterpret_cast<unsigned char const *>( pBegin ), reinterpret_cast<unsigned char const *>( pEnd ), melodyTrack, melodyChannel );
+    }
+    char const * parse( Utility::File::MemoryMapping const & mapping, unsigned int const melodyTrack, unsigned int const melodyChannel ) ///< \overload
+    {
+        return parse( mapping.begin(), mapping.end(), melodyTrack, melodyChannel );
+    }
+
+    /// <B>Effect:</B> Memory maps and parse()s the given MIDI file.<BR>
+    template <Utility::SpecialLocations rootLocation>
+    char const * load( char const * const fileName, unsigned int const melodyTrack, unsigned int const melodyChannel )
+    {
+        auto const mapping( Utility::File::map<rootLocation>( fileName ) );
+        if ( !mapping )
+            return "Unable to open the MIDI file.";
+        return parse( mapping.begin(), mapping.begin() + mapping.size(), melodyTrack, melodyChannel );
+    }
+
+    /// <B>Effect:</B> Empties the melody and gives it a constant tempo
+    /// timeline, e.g. for building a melody with append().<BR>
+    /// \return nullptr if successful, pointer to an error message string otherwise.
+    char const * reset( std::uint16_t division, std::uint32_t microsecondsPerQuarterNote, unsigned int melodyChannel );
+
+    /// <B>Effect:</B> Appends a channel message (sent on the melody channel)
+    /// at the given tick, which must not precede the tick of the last event.<BR>
+    void append( std::uint32_t tick, unsigned char status, unsigned char data1, unsigned char data2 = 0 );
+
+    /// \return A copy of this melody shifted so that the given point in time
+    /// becomes its start. Notes sounding at that point are retriggered and the
+    /// last controller, program, pressure and pitch bend values are carried
+    /// over. The tick resolution is increased as much as the format allows so
+    /// that the cut lands within a fraction of a sample at audio rates.
+    MIDIMelody trimmed( double offsetInSeconds ) const;
+
+    /// \return The melody as a format 1 Standard MIDI File.
+    std::vector<unsigned char> serialize() const;
+
+    /// <B>Effect:</B> Writes serialize()d melody to the given absolute path.<BR>
+    char const * save( char const * absolutePath ) const;
+
+    double secondsFromTicks( double ticks   ) const;
+    double ticksFromSeconds( double seconds ) const;
+
+    double       lengthInSeconds() const { return events_.empty() ? 0 : secondsFromTicks( events_.back().tick ); }
+    unsigned int channel        () const { return channel_; }
+    bool         operator!      () const { return division_ == 0; }
+
+private:
+    struct Event
+    {
+        std::uint32_t tick;
+        unsigned char status;
+        unsigned char data[ 2 ];
+    };
+
+    struct TempoChange
+    {
+        std::uint32_t tick;
+        std::uint32_t microsecondsPerQuarterNote;
+    };
+
+    bool smpte() const { return ( division_ & 0x8000 ) != 0; }
+
+    static unsigned int messageLength( unsigned char const status ) { return ( ( status & 0xF0 ) == 0xC0 || ( status & 0xF0 ) == 0xD0 ) ? 1 : 2; }
+
+private:
+    std::vector<Event      > events_  ;
+    std::vector<TempoChange> tempoMap_;
+    std::uint16_t            division_;
+    unsigned int             channel_ ;
+}; // class MIDIMelody
+
+
+namespace Detail
+{
+    inline std::uint32_t readBigEndian( unsigned char const * const p, unsigned int const bytes )
+    {
+        std::uint32_t value( 0 );
+        for ( unsigned int byte( 0 ); byte < bytes; ++byte )
+            value = ( value << 8 ) | p[ byte ];
+        return value;
+    }
+
+    inline bool readVariableLength( unsigned char const * & p, unsigned char const * const pEnd, std::uint32_t & value )
+    {
+        value = 0;
+        for ( unsigned int byte( 0 ); byte < 4; ++byte )
+        {
+            if ( p == pEnd )
+                return false;
+            unsigned char const c( *p++ );
+            value = ( value << 7 ) | ( c & 0x7F );
+            if ( !( c & 0x80 ) )
+                return true;
+        }
+        return false;
+    }
+
+    inline void writeBigEndian( std::vector<unsigned char> & output, std::uint32_t const value, unsigned int const bytes )
+    {
+        for ( unsigned int byte( bytes ); byte--; )
+            output.push_back( static_cast<unsigned char>( value >> ( byte * 8 ) ) );
+    }
+
+    inline void writeVariableLength( std::vector<unsigned char> & output, std::uint32_t const value )
+    {
+        unsigned int bytes( 1 );
+        while ( bytes < 4 && ( value >> ( 7 * bytes ) ) ) ++bytes;
+        while ( --bytes )
+            output.push_back( static_cast<unsigned char>( ( ( value >> ( 7 * bytes ) ) & 0x7F ) | 0x80 ) );
+        output.push_back( static_cast<unsigned char>( value & 0x7F ) );
+    }
+} // namespace Detail
+
+
+inline char const * MIDIMelody::parse( unsigned char const * p, unsigned char const * const pEnd, unsigned int const melodyTrack, unsigned int const melodyChannel )
+{
+    using namespace Detail;
+
+    events_  .clear();
+    tempoMap_.clear();
+    division_ = 0;
+    channel_  = melodyChannel;
+
+    if ( melodyChannel > 15 )
+        return "Invalid MIDI channel.";
+
+    if ( pEnd - p < 14 || !std::equal( p, p + 4, "MThd" ) || readBigEndian( p + 4, 4 ) < 6 )
+        return "Not a Standard MIDI File.";
+    unsigned int  const numberOfTracks( readBigEndian( p + 10, 2 ) );
+    std::uint16_t const division      ( static_cast<std::uint16_t>( readBigEndian( p + 12, 2 ) ) );
+    if ( !division )
+        return "Invalid MIDI time division.";
+    if ( melodyTrack >= numberOfTracks )
+        return "The MIDI file does not contain the requested melody track.";
+    if ( static_cast<std::uint32_t>( pEnd - p - 8 ) < readBigEndian( p + 4, 4 ) )
+        return "Truncated MIDI file.";
+    p += 8 + readBigEndian( p + 4, 4 );
+
+    for ( unsigned int trackIndex( 0 ); trackIndex < numberOfTracks; ++trackIndex )
+    {
+        if ( pEnd - p < 8 )
+            return "Truncated MIDI file.";
+        std::uint32_t const chunkLength( readBigEndian( p + 4, 4 ) );
+        if ( static_cast<std::uint32_t>( pEnd - p - 8 ) < chunkLength )
+            return "Truncated MIDI file.";
+        bool const isTrack( std::equal( p, p + 4, "MTrk" ) );
+        unsigned char const *       pEvent   ( p + 8               );
+        unsigned char const * const pTrackEnd( p + 8 + chunkLength );
+        p = pTrackEnd;
+        if ( !isTrack )
+        {   // Alien chunks are to be skipped and do not count as tracks.
+            --trackIndex;
+            continue;
+        }
+
+        std::uint32_t tick         ( 0 );
+        unsigned char runningStatus( 0 );
+        while ( pEvent < pTrackEnd )
+        {
+            std::uint32_t delta;
+            if ( !readVariableLength( pEvent, pTrackEnd, delta ) || pEvent == pTrackEnd )
+                return "Corrupt MIDI track.";
+            tick += delta;
+
+            unsigned char status( *pEvent );
+            if ( status & 0x80 ) ++pEvent;
+            else                 status = runningStatus;
+
+            if ( status == 0xFF )
+            {
+                runningStatus = 0; // (meta and sysex events cancel the running status)
+                if ( pEvent == pTrackEnd )
+                    return "Corrupt MIDI track.";
+                unsigned char const type( *pEvent++ );
+                std::uint32_t length;
+                if ( !readVariableLength( pEvent, pTrackEnd, length ) || static_cast<std::uint32_t>( pTrackEnd - pEvent ) < length )
+                    return "Corrupt MIDI track.";
+                if ( type == 0x51 && length == 3 )
+                {
+                    TempoChange const tempoChange = { tick, readBigEndian( pEvent, 3 ) };
+                    tempoMap_.push_back( tempoChange );
+                }
+                pEvent += length;
+                if ( type == 0x2F )
+                    break;
+            }
+            else
+            if ( status == 0xF0 || status == 0xF7 )
+            {
+                runningStatus = 0;
+                std::uint32_t length;
+                if ( !readVariableLength( pEvent, pTrackEnd, length ) || static_cast<std::uint32_t>( pTrackEnd - pEvent ) < length )
+                    return "Corrupt MIDI track.";
+                pEvent += length;
+            }
+            else
+            {
+                if ( !( status & 0x80 ) || status >= 0xF0 )
+                    return "Corrupt MIDI track.";
+                runningStatus = status;
+                unsigned int const length( messageLength( status ) );
+                if ( static_cast<unsigned int>( pTrackEnd - pEvent ) < length )
+                    return "Corrupt MIDI track.";
+                if ( trackIndex == melodyTrack && ( status & 0x0F ) == melodyChannel )
+                {
+                    Event const event = { tick, status, { pEvent[ 0 ], static_cast<unsigned char>( length == 2 ? pEvent[ 1 ] : 0 ) } };
+                    events_.push_back( event );
+                }
+                pEvent += length;
+            }
+        }
+    }
+
+    std::stable_sort
+    (
+        tempoMap_.begin(), tempoMap_.end(),
+        []( TempoChange const & left, TempoChange const & right ) { return left.tick < right.tick; }
+    );
+    division_ = division;
+    return nullptr;
+}
+
+
+inline double MIDIMelody::secondsFromTicks( double const ticks ) const
+{
+    if ( smpte() )
+    {
+        unsigned int const timeCode     ( 256 - ( division_ >> 8 ) );
+        unsigned int const ticksPerFrame( division_ & 0xFF          );
+        double       const framesPerSecond( timeCode == 29 ? 30000.0 / 1001 : timeCode ); // 29 = 30 drop frame
+        return ticks / ( framesPerSecond * ticksPerFrame );
+    }
+
+    double        seconds            ( 0      );
+    double        segmentStart       ( 0      );
+    std::uint32_t microsecondsPerBeat( 500000 );
+    for ( TempoChange const & tempoChange : tempoMap_ )
+    {
+        if ( tempoChange.tick >= ticks )
+            break;
+        seconds            += ( tempoChange.tick - segmentStart ) * microsecondsPerBeat / ( 1000000.0 * division_ );
+        segmentStart        = tempoChange.tick;
+        microsecondsPerBeat = tempoChange.microsecondsPerQuarterNote;
+    }
+    return seconds + ( ticks - segmentStart ) * microsecondsPerBeat / ( 1000000.0 * division_ );
+}
+
+
+inline double MIDIMelody::ticksFromSeconds( double const seconds ) const
+{
+    if ( smpte() )
+        return seconds / secondsFromTicks( 1 );
+
+    double        segmentStartSeconds( 0      );
+    double        segmentStart       ( 0      );
+    std::uint32_t microsecondsPerBeat( 500000 );
+    for ( TempoChange const & tempoChange : tempoMap_ )
+    {
+        double const tempoChangeSeconds( segmentStartSeconds + ( tempoChange.tick - segmentStart ) * microsecondsPerBeat / ( 1000000.0 * division_ ) );
+        if ( tempoChangeSeconds >= seconds )
+            break;
+        segmentStartSeconds = tempoChangeSeconds;
+        segmentStart        = tempoChange.tick;
+        microsecondsPerBeat = tempoChange.microsecondsPerQuarterNote;
+    }
+    return segmentStart + ( seconds - segmentStartSeconds ) * ( 1000000.0 * division_ ) / microsecondsPerBeat;
+}
+
+
+inline MIDIMelody MIDIMelody::trimmed( double const offsetInSeconds ) const
+{
+    MIDIMelody result;
+    result.channel_ = channel_;
+
+    // Increase the resolution as much as the 15 bit PPQN field allows (SMPTE
+    // time codes are left as they are) so that the rounding of the cut point
+    // becomes negligible.
+    std::uint32_t const scale( smpte() ? 1 : std::max<std::uint32_t>( 0x7FFF / division_, 1 ) );
+    result.division_ = static_cast<std::uint16_t>( smpte() ? division_ : division_ * scale );
+
+    double        const exactCut( ticksFromSeconds( std::max( offsetInSeconds, 0.0 ) ) * scale );
+    std::uint64_t const cut     ( static_cast<std::uint64_t>( std::floor( exactCut + 0.5 ) ) );
+
+    std::uint32_t tempoAtCut( 500000 );
+    for ( TempoChange const & tempoChange : tempoMap_ )
+    {
+        std::uint64_t const tick( std::uint64_t( tempoChange.tick ) * scale );
+        if ( tick <= cut )
+            tempoAtCut = tempoChange.microsecondsPerQuarterNote;
+        else
+        {
+            TempoChange const shifted = { static_cast<std::uint32_t>( tick - cut ), tempoChange.microsecondsPerQuarterNote };
+            result.tempoMap_.push_back( shifted );
+        }
+    }
+    if ( !smpte() )
+    {
+        TempoChange const initialTempo = { 0, tempoAtCut };
+        result.tempoMap_.insert( result.tempoMap_.begin(), initialTempo );
+    }
+
+    // Chase the channel state up to the cut point.
+    unsigned char noteVelocities[ 128 ] = { 0     };
+    unsigned char controllers   [ 128 ] = { 0     };
+    bool          controllerSet [ 128 ] = { false };
+    Event         program               = { 0, 0, { 0, 0 } };
+    Event         pressure              = { 0, 0, { 0, 0 } };
+    Event         pitchBend             = { 0, 0, { 0, 0 } };
+
+    std::vector<Event>::const_iterator pEvent( events_.begin() );
+    for ( ; pEvent != events_.end() && std::uint64_t( pEvent->tick ) * scale < cut; ++pEvent )
+    {
+        unsigned char const key( pEvent->data[ 0 ] & 0x7F );
+        switch ( pEvent->status & 0xF0 )
+        {
+            case 0x80: noteVelocities[ key ] = 0;                                              break;
+            case 0x90: noteVelocities[ key ] = pEvent->data[ 1 ];                              break;
+            case 0xB0: controllers   [ key ] = pEvent->data[ 1 ]; controllerSet[ key ] = true; break;
+            case 0xC0: program   = *pEvent; break;
+            case 0xD0: pressure  = *pEvent; break;
+            case 0xE0: pitchBend = *pEvent; break;
+        }
+    }
+
+    unsigned char const channel( static_cast<unsigned char>( channel_ ) );
+    for ( unsigned char controller( 0 ); controller < 128; ++controller )
+    {
+        if ( !controllerSet[ controller ] ) continue;
+        Event const event = { 0, static_cast<unsigned char>( 0xB0 | channel ), { controller, controllers[ controller ] } };
+        result.events_.push_back( event );
+    }
+    if ( program  .status ) { program  .tick = 0; result.events_.push_back( program   ); }
+    if ( pressure .status ) { pressure .tick = 0; result.events_.push_back( pressure  ); }
+    if ( pitchBend.status ) { pitchBend.tick = 0; result.events_.push_back( pitchBend ); }
+    for ( unsigned char key( 0 ); key < 128; ++key )
+    {
+        if ( !noteVelocities[ key ] ) continue;
+        Event const event = { 0, static_cast<unsigned char>( 0x90 | channel ), { key, noteVelocities[ key ] } };
+        result.events_.push_back( event );
+    }
+
+    for ( ; pEvent != events_.end(); ++pEvent )
+    {
+        Event event( *pEvent );
+        event.tick = static_cast<std::uint32_t>( std::uint64_t( event.tick ) * scale - cut );
+        result.events_.push_back( event );
+    }
+
+    return result;
+}
+
+
+inline char const * MIDIMelody::reset( std::uint16_t const division, std::uint32_t const microsecondsPerQuarterNote, unsigned int const melodyChannel )
+{
+    events_  .clear();
+    tempoMap_.clear();
+    division_ = 0;
+    channel_  = melodyChannel;
+    if ( melodyChannel > 15 )
+        return "Invalid MIDI channel.";
+    if ( !division || ( division & 0x8000 ) || !microsecondsPerQuarterNote || microsecondsPerQuarterNote > 0xFFFFFF )
+        return "Invalid MIDI time division.";
+    TempoChange const tempo = { 0, microsecondsPerQuarterNote };
+    tempoMap_.push_back( tempo );
+    division_ = division;
+    return nullptr;
+}
+
+
+inline void MIDIMelody::append( std::uint32_t const tick, unsigned char const status, unsigned char const data1, unsigned char const data2 )
+{
+    LE_ASSERT( events_.empty() || events_.back().tick <= tick );
+    Event const event = { tick, static_cast<unsigned char>( ( status & 0xF0 ) | channel_ ), { static_cast<unsigned char>( data1 & 0x7F ), static_cast<unsigned char>( data2 & 0x7F ) } };
+    events_.push_back( event );
+}
+
+
+inline std::vector<unsigned char> MIDIMelody::serialize() const
+{
+    using namespace Detail;
+
+    std::vector<unsigned char> file;
+    file.reserve( 64 + tempoMap_.size() * 8 + events_.size() * 4 );
+
+    static unsigned char const header[] = { 'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1, 0, 2 };
+    file.insert( file.end(), header, header + sizeof( header ) );
+    writeBigEndian( file, division_, 2 );
+
+    static unsigned char const trackHeader[] = { 'M', 'T', 'r', 'k', 0, 0, 0, 0 };
+    static unsigned char const endOfTrack [] = { 0xFF, 0x2F, 0x00 };
+
+    // Tempo track.
+    std::size_t trackStart( file.size() );
+    file.insert( file.end(), trackHeader, trackHeader + sizeof( trackHeader ) );
+    std::uint32_t previousTick( 0 );
+    for ( TempoChange const & tempoChange : tempoMap_ )
+    {
+        writeVariableLength( file, tempoChange.tick - previousTick );
+        file.push_back( 0xFF ); file.push_back( 0x51 ); file.push_back( 0x03 );
+        writeBigEndian( file, tempoChange.microsecondsPerQuarterNote, 3 );
+        previousTick = tempoChange.tick;
+    }
+    file.push_back( 0 );
+    file.insert( file.end(), endOfTrack, endOfTrack + sizeof( endOfTrack ) );
+    for ( unsigned int byte( 0 ); byte < 4; ++byte )
+        file[ trackStart + 4 + byte ] = static_cast<unsigned char>( ( file.size() - trackStart - 8 ) >> ( 24 - 8 * byte ) );
+
+    // Melody track.
+    trackStart = file.size();
+    file.insert( file.end(), trackHeader, trackHeader + sizeof( trackHeader ) );
+    previousTick = 0;
+    for ( Event const & event : events_ )
+    {
+        writeVariableLength( file, event.tick - previousTick );
+        file.push_back( event.status   );
+        file.push_back( event.data[ 0 ] );
+        if ( messageLength( event.status ) == 2 )
+            file.push_back( event.data[ 1 ] );
+        previousTick = event.tick;
+    }
+    file.push_back( 0 );
+    file.insert( file.end(), endOfTrack, endOfTrack + sizeof( endOfTrack ) );
+    for ( unsigned int byte( 0 ); byte < 4; ++byte )
+        file[ trackStart + 4 + byte ] = static_cast<unsigned char>( ( file.size() - trackStart - 8 ) >> ( 24 - 8 * byte ) );
+
+    return file;
+}
+
+
+inline char const * MIDIMelody::save( char const * const absolutePath ) const
+{
+    std::vector<unsigned char> const file( serialize() );
+    std::FILE * const pFile( std::fopen( absolutePath, "wb" ) );
+    if ( !pFile )
+        return "Unable to create the MIDI file.";
+    bool const success( std::fwrite( &file[ 0 ], 1, file.size(), pFile ) == file.size() );
+    return ( std::fclose( pFile ) == 0 && success ) ? nullptr : "Unable to write the MIDI file.";
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// temporaryMelodyPath()
+// ---------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns a unique absolute path (within Utility::Temporaries) for a
+/// scratch MIDI file.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline std::string temporaryMelodyPath()
+{
+    return Utility::temporaryPath( ( "LE_Melody_" + Utility::uniqueTag() + ".mid" ).c_str() );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// setMelody()
+// -----------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Passes the given melody to the given Melodifyer (through a scratch
+/// MIDI file that is deleted as soon as the Melodifyer is done parsing it).
+///
+/// \return nullptr if successful, pointer to an error message string
+/// otherwise.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline char const * setMelody( Melodifyer & melodifyer, MIDIMelody const & melody )
+{
+    std::string const path( temporaryMelodyPath() );
+    if ( char const * const pError = melody.save( path.c_str() ) )
+        return pError;
+    char const * const pError( melodifyer.setMelodyMIDIFile<Utility::AbsolutePath>( path.c_str(), MIDIMelody::track, melody.channel() ) );
+    std::remove( path.c_str() );
+    return pError;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// setMelodyMIDIData()
+// -------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief The in-memory equivalent of Melodifyer::setMelodyMIDIFile(): sets
+/// the melody from Standard MIDI File data held in memory (e.g. received over
+/// the network or from a blob store, or a Utility::File::MemoryMapping).
+///
+/// The data is parsed in place, only the extracted melody reaches the
+/// filesystem (as a small scratch file, see setMelody()).
+///
+/// \return nullptr if successful, pointer to an error message string
+/// otherwise.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline char const * setMelodyMIDIData( Melodifyer & melodifyer, char const * const pBegin, char const * const pEnd, unsigned int const melodyTrack, unsigned int const melodyChannel )
+{
+    MIDIMelody melody;
+    if ( char const * const pError = melody.parse( pBegin, pEnd, melodyTrack, melodyChannel ) )
+        return pError;
+    return setMelody( melodifyer, melody );
+}
+
+inline char const * setMelodyMIDIData( Melodifyer & melodifyer, Utility::File::MemoryMapping const & mapping, unsigned int const melodyTrack, unsigned int const melodyChannel ) ///< \overload
+{
+    return setMelodyMIDIData( melodifyer, mapping.begin(), mapping.end(), melodyTrack, melodyChannel );
+}
+
+/// @} // group Melodify
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // midiMelody_hpp
@@ -0,0 +1,623 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file offlineRenderer.hpp
+/// -------------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef offlineRenderer_hpp__1D7C3B2E_5F0A_4C8E_9B61_2A4E8F3D7C10
+#define offlineRenderer_hpp__1D7C3B2E_5F0A_4C8E_9B61_2A4E8F3D7C10
+#pragma once
+//------------------------------------------------------------------------------
+#include "melodifyer.hpp"
+#include "midiMelody.hpp"
+#include "statistics.hpp"
+#include "timeline.hpp"
+
+#include "le/utility/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Melodify
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \struct OfflineRenderSettings
+///
+/// \brief Parameters of renderOffline().
+///
+////////////////////////////////////////////////////////////////////////////////
+
+struct OfflineRenderSettings
+{
+    OfflineRenderSettings()
+        :
+        numberOfSegments            ( 0       ),
+        preRollInSamples            ( 4096    ),
+        crossfadeInSamples          ( 1024    ),
+        automaticVoiceGainCorrection( false   ),
+        extraVoiceGainCorrection    ( 1       ),
+        voiceActivityThreshold      ( 0       ),
+        pStatistics                 ( nullptr )
+    {}
+
+    unsigned int           numberOfSegments            ; ///< Number of independently rendered segments (zero selects one per WorkerPool thread).
+    unsigned int           preRollInSamples            ; ///< Amount of input fed to a segment's Melodifyer ahead of the segment start (zero selects recommendedPreRollInSamples()).
+    unsigned int           crossfadeInSamples          ; ///< Length of the linear crossfade at segment joins (zero gives sample-exact hard cuts).
+    bool                   automaticVoiceGainCorrection; ///< \see Melodifyer::setAutomaticVoiceGainCorrection()
+    float                  extraVoiceGainCorrection    ; ///< \see Melodifyer::setExtraVoiceGainCorrection()
+    float                  voiceActivityThreshold      ; ///< Voice RMS level (linear, full scale = 1) below which the Melodifyer is bypassed and only the background is output (zero disables the bypass).
+    ProcessingStatistics * pStatistics                 ; ///< Optional per stage timing counters (nullptr disables the instrumentation).
+}; // struct OfflineRenderSettings
+
+
+namespace Detail
+{
+    inline char const * renderWithBypass
+    (
+        MIDIMelody            const &       melody          ,
+        unsigned int                  const sampleRate      ,
+        unsigned int                  const numberOfChannels,
+        float                 const * const pVoiceData      ,
+        float                 const * const pBackgroundData ,
+        float                       * const pOutputData     ,
+        unsigned int                  const numberOfSamples ,
+        Utility::WorkerPool           &     workerPool      ,
+        OfflineRenderSettings const &       settings
+    );
+} // namespace Detail
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// renderOffline()
+// ---------------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Renders a whole (arbitrarily long) voice + background pair against
+/// a melody, splitting the timeline into segments that are processed in
+/// parallel, each by its own Melodifyer instance.
+///
+/// Each segment worker seek()s its Melodifyer to its segment start and
+/// processes the pre-roll plus the fixed Melodifyer latency worth of input
+/// before its output is used. The
+/// output is latency compensated: <VAR>pOutputData</VAR>[ n ] corresponds to
+/// <VAR>pVoiceData</VAR>[ n ] (unlike with Melodifyer::process() there is no
+/// need to pad the background or skip the beginning of the output).
+///
+/// \param pVoiceData      Interleaved voice input, <VAR>numberOfSamples</VAR>
+///                        sample frames long.
+/// \param pBackgroundData Interleaved background input, the same length as
+///                        the voice input (optional, may be nullptr).
+/// \param pOutputData     Interleaved output, the same length as the voice
+///                        input. May be the same buffer as
+///                        <VAR>pVoiceData</VAR> or <VAR>pBackgroundData</VAR>
+///                        (in-place rendering).
+///
+/// With a non-zero OfflineRenderSettings::voiceActivityThreshold the voice
+/// is first scanned for activity and only the active spans (padded so that
+/// the Melodifyer output has settled back to the plain background at their
+/// ends) are rendered, the silent regions in between are bypassed (the
+/// background alone is copied to the output) and the span edges are
+/// crossfaded with the background over OfflineRenderSettings::crossfadeInSamples.
+/// The melody is restarted at the start of each span so it stays in sync.
+/// The bypassed sample frames are counted in the ProcessingStatistics::Bypass
+/// stage.
+///
+/// \return nullptr if successful, pointer to an error message string
+/// otherwise.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline char const * renderOffline
+(
+    MIDIMelody            const &       melody          ,
+    unsigned int                  const sampleRate      ,
+    unsigned int                  const numberOfChannels,
+    float                 const * const pVoiceData      ,
+    float                 const * const pBackgroundData ,
+    float                       * const pOutputData     ,
+    unsigned int                  const numberOfSamples ,
+    Utility::WorkerPool           &     workerPool      ,
+    OfflineRenderSettings const &       settings = OfflineRenderSettings()
+)
+{
+    if ( !melody )
+        return "Invalid melody.";
+    if ( !numberOfSamples )
+        return nullptr;
+    if ( settings.voiceActivityThreshold > 0 )
+        return Detail::renderWithBypass( melody, sampleRate, numberOfChannels, pVoiceData, pBackgroundData, pOutputData, numberOfSamples, workerPool, settings );
+
+    unsigned int latency;
+    unsigned int preRoll;
+    {
+        Melodifyer probe;
+        if ( !probe.setup( sampleRate, numberOfChannels ) )
+            return "Out of memory.";
+        latency = probe.latencyInSamples();
+        preRoll = settings.preRollInSamples ? settings.preRollInSamples : recommendedPreRollInSamples( probe );
+    }
+
+    unsigned int const crossfade( settings.crossfadeInSamples );
+
+    // Do not let the per segment overhead (pre-roll + latency + crossfade)
+    // dominate.
+    unsigned int const minimumSegmentLength( 4 * ( preRoll + crossfade + 4096 ) );
+    unsigned int       numberOfSegments    ( settings.numberOfSegments ? settings.numberOfSegments : workerPool.numberOfThreads() );
+    numberOfSegments = std::max( 1U, std::min( numberOfSegments, numberOfSamples / minimumSegmentLength ) );
+
+    // Segment workers read input outside of their own segments (the pre-roll
+    // before and the crossfade + latency after it) which, for in-place
+    // rendering, other workers overwrite with their output. Snapshots of the
+    // input around each join are therefore taken up front.
+    unsigned int const snapshotLength( preRoll + 2 * latency + crossfade );
+    unsigned int const snapshotsSize ( std::max( 1U, ( numberOfSegments - 1 ) * snapshotLength * numberOfChannels ) );
+    unsigned int const tailsSize     ( std::max( 1U, ( numberOfSegments - 1 ) * crossfade      * numberOfChannels ) );
+    std::unique_ptr<float[]> const pScratch( new ( std::nothrow ) float[ tailsSize + 2 * snapshotsSize ] );
+    if ( !pScratch )
+        return "Out of memory.";
+    float * const pTails              ( &pScratch[ 0                         ] );
+    float * const pVoiceSnapshots     ( &pScratch[ tailsSize                 ] );
+    float * const pBackgroundSnapshots( &pScratch[ tailsSize + snapshotsSize ] );
+
+    struct SegmentRenderer
+    {
+        unsigned int segmentBoundary( unsigned int const segment ) const
+        {
+            return static_cast<unsigned int>( static_cast<unsigned long long>( numberOfSamples ) * segment / numberOfSegments );
+        }
+
+        unsigned int snapshotBegin( unsigned int const join ) const
+        {
+            unsigned int const boundary( segmentBoundary( join ) );
+            return boundary - std::min( boundary, preRoll + latency );
+        }
+
+        void takeSnapshots() const
+        {
+            for ( unsigned int join( 1 ); join < numberOfSegments; ++join )
+            {
+                unsigned int const begin ( snapshotBegin( join )                                );
+                unsigned int const length( std::min( snapshotLength, numberOfSamples - begin ) );
+                unsigned int const offset( ( join - 1 ) * snapshotLength * numberOfChannels    );
+                std::copy_n( &pVoiceData[ begin * numberOfChannels ], length * numberOfChannels, &pVoiceSnapshots[ offset ] );
+                if ( pBackgroundData )
+                    std::copy_n( &pBackgroundData[ begin * numberOfChannels ], length * numberOfChannels, &pBackgroundSnapshots[ offset ] );
+            }
+        }
+
+        /// Returns the input frame at the given position as seen by the given
+        /// segment's worker (nullptr for positions past the end of the input).
+        float const * inputFrame( float const * const pData, float const * const pSnapshots, unsigned int const segment, unsigned int const position ) const
+        {
+            if ( position >= numberOfSamples )
+                return nullptr;
+            if ( position >= segmentBoundary( segment ) && position < segmentBoundary( segment + 1 ) )
+                return &pData[ position * numberOfChannels ];
+            unsigned int const join( position < segmentBoundary( segment ) ? segment : segment + 1 );
+            return &pSnapshots[ ( ( join - 1 ) * snapshotLength + position - snapshotBegin( join ) ) * numberOfChannels ];
+        }
+
+        void operator()( unsigned int const segment ) const
+        {
+            if ( pError ) return;
+
+            Melodifyer melodifyer;
+            if ( !melodifyer.setup( sampleRate, numberOfChannels ) ) { pError = "Out of memory."; return; }
+            melodifyer.setAutomaticVoiceGainCorrection( settings.automaticVoiceGainCorrection );
+            melodifyer.setExtraVoiceGainCorrection    ( settings.extraVoiceGainCorrection     );
+
+            unsigned int const begin    ( segmentBoundary( segment     )                                                            );
+            unsigned int const end      ( segmentBoundary( segment + 1 )                                                            );
+            unsigned int const renderEnd( segment + 1 == numberOfSegments ? end : std::min( end + crossfade, numberOfSamples ) );
+
+            unsigned int segmentPreRoll( preRoll );
+            {
+                ProcessingStatistics::Timer const timer( settings.pStatistics, ProcessingStatistics::MelodyPositioning, 0 );
+                if ( char const * const pSeekError = seek( melodifyer, melody, sampleRate, begin, segmentPreRoll ) ) { pError = pSeekError; return; }
+            }
+            unsigned int const renderBegin( begin - segmentPreRoll );
+
+            unsigned int const blockSize( 4096 );
+            std::unique_ptr<float[]> const pBuffers( new ( std::nothrow ) float[ 3 * blockSize * numberOfChannels ] );
+            if ( !pBuffers ) { pError = "Out of memory."; return; }
+            float * const pVoice     ( &pBuffers[ 0                              ] );
+            float * const pBackground( &pBuffers[ 1 * blockSize * numberOfChannels ] );
+            float * const pOutput    ( &pBuffers[ 2 * blockSize * numberOfChannels ] );
+
+            // Stream position 0 corresponds to the voice sample renderBegin and
+            // the background is delayed by the latency so that it lines up with
+            // the processed voice at the output.
+            unsigned int const streamLength( renderEnd - renderBegin + latency );
+            for ( unsigned int position( 0 ); position < streamLength; position += blockSize )
+            {
+                unsigned int const blockLength( std::min( blockSize, streamLength - position ) );
+                {
+                    ProcessingStatistics::Timer const timer( settings.pStatistics, ProcessingStatistics::InputPreparation, blockLength );
+                    for ( unsigned int frame( 0 ); frame < blockLength; ++frame )
+                    {
+                        unsigned int  const voiceIndex      ( renderBegin + position + frame );
+                        float const * const pVoiceFrame     ( inputFrame( pVoiceData, pVoiceSnapshots, segment, voiceIndex ) );
+                        float const * const pBackgroundFrame
+                        (
+                            ( pBackgroundData && voiceIndex >= latency )
+                                ? inputFrame( pBackgroundData, pBackgroundSnapshots, segment, voiceIndex - latency )
+                                : nullptr
+                        );
+                        for ( unsigned int channel( 0 ); channel < numberOfChannels; ++channel )
+                        {
+                            pVoice     [ frame * numberOfChannels + channel ] = pVoiceFrame      ? pVoiceFrame     [ channel ] : 0;
+                            pBackground[ frame * numberOfChannels + channel ] = pBackgroundFrame ? pBackgroundFrame[ channel ] : 0;
+                        }
+                    }
+                }
+
+                {
+                    ProcessingStatistics::Timer const timer( settings.pStatistics, ProcessingStatistics::Melodify, blockLength );
+                    melodifyer.process( pVoice, pBackgroundData ? pBackground : nullptr, pOutput, blockLength );
+                }
+
+                {
+                    ProcessingStatistics::Timer const timer( settings.pStatistics, ProcessingStatistics::OutputAssembly, blockLength );
+                    for ( unsigned int frame( 0 ); frame < blockLength; ++frame )
+                    {
+                        unsigned int const streamPosition( position + frame );
+                        if ( renderBegin + streamPosition < begin + latency ) continue;
+                        unsigned int const outputIndex( renderBegin + streamPosition - latency );
+                        float * const pTarget
+                        (
+                            outputIndex < end
+                                ? &pOutputData[ outputIndex * numberOfChannels ]
+                                : &pTails[ ( segment * crossfade + outputIndex - end ) * numberOfChannels ]
+                        );
+                        std::copy_n( &pOutput[ frame * numberOfChannels ], numberOfChannels, pTarget );
+                    }
+                }
+            }
+        }
+
+        MIDIMelody            const &       melody          ;
+        OfflineRenderSettings const &       settings        ;
+        float                 const * const pVoiceData      ;
+        float                 const * const pBackgroundData ;
+        float                       * const pOutputData     ;
+        float                       * const pTails              ;
+        float                       * const pVoiceSnapshots     ;
+        float                       * const pBackgroundSnapshots;
+        unsigned int                  const sampleRate          ;
+        unsigned int                  const numberOfChannels    ;
+        unsigned int                  const numberOfSamples     ;
+        unsigned int                  const numberOfSegments    ;
+        unsigned int                  const crossfade           ;
+        unsigned int                  const latency             ;
+        unsigned int                  const preRoll             ;
+        unsigned int                  const snapshotLength      ;
+
+        mutable std::atomic<char const *> pError;
+    } renderer =
+    {
+        melody, settings,
+        pVoiceData, pBackgroundData, pOutputData, pTails, pVoiceSnapshots, pBackgroundSnapshots,
+        sampleRate, numberOfChannels, numberOfSamples, numberOfSegments, crossfade, latency, preRoll, snapshotLength,
+        { nullptr }
+    };
+
+    renderer.takeSnapshots();
+    workerPool.parallelFor( numberOfSegments, renderer );
+    if ( char const * const pError = renderer.pError.load() )
+        return pError;
+
+    // Blend the tail of each segment into the start of the next one.
+    ProcessingStatistics::Timer const crossfadeTimer( settings.pStatistics, ProcessingStatistics::OutputAssembly, ( numberOfSegments - 1 ) * crossfade );
+    for ( unsigned int segment( 0 ); segment + 1 < numberOfSegments; ++segment )
+    {
+        unsigned int const join  ( renderer.segmentBoundary( segment + 1 )            );
+        unsigned int const length( std::min( crossfade, numberOfSamples - join )      );
+        float const * const pTail( &pTails[ segment * crossfade * numberOfChannels ] );
+        float       * const pHead( &pOutputData[ join * numberOfChannels ]           );
+        for ( unsigned int frame( 0 ); frame < length; ++frame )
+        {
+            float const headWeight( ( frame + 0.5f ) / crossfade );
+            for ( unsigned int channel( 0 ); channel < numberOfChannels; ++channel )
+            {
+                unsigned int const sample( frame * numberOfChannels + channel );
+                pHead[ sample ] = pTail[ sample ] + headWeight * ( pHead[ sample ] - pTail[ sample ] );
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// renderVariations()
+// ------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Renders one voice take (and background) against several melodies.
+///
+/// The voice analysis happens inside Melodifyer::process() and depends on the
+/// melody so it cannot be shared between the renders. What is shared is the
+/// (read-only) input and the parallelism: with at least as many melodies as
+/// WorkerPool threads each melody is rendered, start to finish, by a single
+/// Melodifyer (no pre-roll or crossfade overhead and no segment joins) with
+/// the melodies processed concurrently; otherwise each melody is rendered in
+/// turn with the segmented renderOffline().
+///
+/// \param pMelodies        Array of <VAR>numberOfMelodies</VAR> pointers to
+///                         the melodies.
+/// \param pOutputs         Array of <VAR>numberOfMelodies</VAR> pointers to
+///                         the (latency compensated, interleaved) output
+///                         buffers, each <VAR>numberOfSamples</VAR> sample
+///                         frames long. The buffers must be distinct and must
+///                         not alias the inputs.
+///
+/// The remaining parameters are the same as for renderOffline().
+///
+/// \return nullptr if successful, pointer to an error message string
+/// otherwise.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline char const * renderVariations
+(
+    MIDIMelody            const * const * pMelodies       ,
+    float                       * const * pOutputs        ,
+    unsigned int                  const   numberOfMelodies,
+    unsigned int                  const   sampleRate      ,
+    unsigned int                  const   numberOfChannels,
+    float                 const * const   pVoiceData      ,
+    float                 const * const   pBackgroundData ,
+    unsigned int                  const   numberOfSamples ,
+    Utility::WorkerPool           &       workerPool      ,
+    OfflineRenderSettings const &         settings = OfflineRenderSettings()
+)
+{
+    if ( numberOfMelodies < workerPool.numberOfThreads() )
+    {
+        for ( unsigned int melody( 0 ); melody < numberOfMelodies; ++melody )
+        {
+            if ( char const * const pError = renderOffline( *pMelodies[ melody ], sampleRate, numberOfChannels, pVoiceData, pBackgroundData, pOutputs[ melody ], numberOfSamples, workerPool, settings ) )
+                return pError;
+        }
+        return nullptr;
+    }
+
+    struct MelodyRenderer
+    {
+        void operator()( unsigned int const melody ) const
+        {
+            if ( pError ) return;
+            // A single thread pool spawns no threads.
+            Utility::WorkerPool serialPool( 1 );
+            if ( char const * const pMelodyError = renderOffline( *pMelodies[ melody ], sampleRate, numberOfChannels, pVoiceData, pBackgroundData, pOutputs[ melody ], numberOfSamples, serialPool, settings ) )
+                pError = pMelodyError;
+        }
+
+        MIDIMelody            const * const * pMelodies       ;
+        float                       * const * pOutputs        ;
+        unsigned int                  const   sampleRate      ;
+        unsigned int                  const   numberOfChannels;
+        float                 const * const   pVoiceData      ;
+        float                 const * const   pBackgroundData ;
+        unsigned int                  const   numberOfSamples ;
+        OfflineRenderSettings                 settings        ;
+
+        mutable std::atomic<char const *> pError;
+    } renderer =
+    {
+        pMelodies, pOutputs, sampleRate, numberOfChannels, pVoiceData, pBackgroundData, numberOfSamples, settings,
+        { nullptr }
+    };
+    renderer.settings.numberOfSegments = 1;
+
+    workerPool.parallelFor( numberOfMelodies, renderer );
+    return renderer.pError.load();
+}
+
+
+inline char const * Detail::renderWithBypass
+(
+    MIDIMelody            const &       melody          ,
+    unsigned int                  const sampleRate      ,
+    unsigned int                  const numberOfChannels,
+    float                 const * const pVoiceData      ,
+    float                 const * const pBackgroundData ,
+    float                       * const pOutputData     ,
+    unsigned int                  const numberOfSamples ,
+    Utility::WorkerPool           &     workerPool      ,
+    OfflineRenderSettings const &       settings
+)
+{
+    unsigned int latency;
+    unsigned int preRoll;
+    {
+        Melodifyer probe;
+        if ( !probe.setup( sampleRate, numberOfChannels ) )
+            return "Out of memory.";
+        latency = probe.latencyInSamples();
+        preRoll = settings.preRollInSamples ? settings.preRollInSamples : recommendedPreRollInSamples( probe );
+    }
+    unsigned int const crossfade( settings.crossfadeInSamples );
+
+    struct Span { unsigned int begin, end; };
+    std::vector<Span> spans;
+
+    // Voice activity detection: the energy of each latency long analysis
+    // frame is compared against the threshold. Active frames are padded by
+    // twice the latency (the reach of the Melodifyer analysis window) plus
+    // the crossfade and gaps too short to pay for restarting the melody
+    // (a pre-roll) are not bypassed.
+    {
+        ProcessingStatistics::Timer const timer( settings.pStatistics, ProcessingStatistics::InputPreparation, numberOfSamples );
+        unsigned int const analysisFrame       ( std::max( latency, 1U )                                                );
+        unsigned int const margin              ( 2 * latency + crossfade                                                );
+        unsigned int const minimumBypassLength ( preRoll + 2 * crossfade                                                );
+        float        const thresholdEnergy     ( settings.voiceActivityThreshold * settings.voiceActivityThreshold * numberOfChannels );
+        for ( unsigned int frameBegin( 0 ); frameBegin < numberOfSamples; frameBegin += analysisFrame )
+        {
+            unsigned int const frameEnd( std::min( frameBegin + analysisFrame, numberOfSamples ) );
+            float energy( 0 );
+            for ( unsigned int sample( frameBegin * numberOfChannels ); sample < frameEnd * numberOfChannels; ++sample )
+                energy += pVoiceData[ sample ] * pVoiceData[ sample ];
+            if ( energy <= thresholdEnergy * ( frameEnd - frameBegin ) )
+                continue;
+            Span const span = { frameBegin - std::min( frameBegin, margin ), std::min( frameEnd + margin, numberOfSamples ) };
+            if ( !spans.empty() && span.begin <= spans.back().end + minimumBypassLength )
+                spans.back().end = span.end;
+            else
+                spans.push_back( span );
+        }
+    }
+
+    // Background samples under the crossfaded span edges (taken before the
+    // rendering in case the output overwrites the background in place).
+    unsigned int const edgeSize( crossfade * numberOfChannels );
+    std::unique_ptr<float[]> const pEdges( new ( std::nothrow ) float[ std::max<std::size_t>( 1, 2 * edgeSize * spans.size() ) ] );
+    if ( !pEdges )
+        return "Out of memory.";
+    for ( std::size_t span( 0 ); span < spans.size(); ++span )
+    {
+        float * const pHeadEdge( &pEdges[ ( 2 * span     ) * edgeSize ] );
+        float * const pTailEdge( &pEdges[ ( 2 * span + 1 ) * edgeSize ] );
+        unsigned int const length( std::min( crossfade, spans[ span ].end - spans[ span ].begin ) );
+        std::fill_n( pHeadEdge, 2 * edgeSize, 0.0f );
+        if ( pBackgroundData )
+        {
+            std::copy_n( &pBackgroundData[ spans[ span ].begin          * numberOfChannels ], length * numberOfChannels, pHeadEdge );
+            std::copy_n( &pBackgroundData[ ( spans[ span ].end - length ) * numberOfChannels ], length * numberOfChannels, pTailEdge );
+        }
+    }
+
+    // The bypass.
+    {
+        unsigned int bypassed( 0 );
+        for ( std::size_t span( 0 ); span <= spans.size(); ++span )
+            bypassed += ( span < spans.size() ? spans[ span ].begin : numberOfSamples ) - ( span ? spans[ span - 1 ].end : 0 );
+        ProcessingStatistics::Timer const timer( settings.pStatistics, ProcessingStatistics::Bypass, bypassed );
+        for ( std::size_t span( 0 ); span <= spans.size(); ++span )
+        {
+            unsigned int const begin( ( span ? spans[ span - 1 ].end : 0 ) * numberOfChannels );
+            unsigned int const end  ( ( span < spans.size() ? spans[ span ].begin : numberOfSamples ) * numberOfChannels );
+            if ( !pBackgroundData )
+                std::fill( &pOutputData[ begin ], &pOutputData[ end ], 0.0f );
+            else if ( pBackgroundData != pOutputData )
+                std::copy( &pBackgroundData[ begin ], &pBackgroundData[ end ], &pOutputData[ begin ] );
+        }
+    }
+
+    // The active spans are independent (and do not overlap): as in
+    // renderVariations(), with at least as many spans as WorkerPool threads
+    // each span is rendered by a single Melodifyer with the spans processed
+    // concurrently, otherwise each span is rendered in turn with the
+    // segmented renderer.
+    struct SpanRenderer
+    {
+        char const * render( std::size_t const span, Utility::WorkerPool & pool ) const
+        {
+            unsigned int const begin ( spans[ span ].begin       );
+            unsigned int const length( spans[ span ].end - begin );
+            unsigned int const offset( begin * numberOfChannels  );
+            if ( char const * const pError = renderOffline
+            (
+                begin ? melody.trimmed( begin / double( sampleRate ) ) : melody,
+                sampleRate,
+                numberOfChannels,
+                &pVoiceData[ offset ],
+                pBackgroundData ? &pBackgroundData[ offset ] : nullptr,
+                &pOutputData[ offset ],
+                length,
+                pool,
+                spanSettings
+            ) )
+                return pError;
+
+            // Crossfade from and back to the plain background.
+            unsigned int const fadeLength( std::min( crossfade, length ) );
+            float const * const pHeadEdge( &pEdges[ ( 2 * span     ) * crossfade * numberOfChannels ] );
+            float const * const pTailEdge( &pEdges[ ( 2 * span + 1 ) * crossfade * numberOfChannels ] );
+            float       * const pHead    ( &pOutputData[ offset ]                                        );
+            float       * const pTail    ( &pOutputData[ offset + ( length - fadeLength ) * numberOfChannels ] );
+            for ( unsigned int frame( 0 ); frame < fadeLength; ++frame )
+            {
+                float const headWeight( ( frame + 0.5f ) / crossfade );
+                float const tailWeight( ( fadeLength - frame - 0.5f ) / crossfade );
+                for ( unsigned int channel( 0 ); channel < numberOfChannels; ++channel )
+                {
+                    unsigned int const sample( frame * numberOfChannels + channel );
+                    if ( begin                            ) pHead[ sample ] = pHeadEdge[ sample ] + headWeight * ( pHead[ sample ] - pHeadEdge[ sample ] );
+                    if ( begin + length < numberOfSamples ) pTail[ sample ] = pTailEdge[ sample ] + tailWeight * ( pTail[ sample ] - pTailEdge[ sample ] );
+                }
+            }
+            return nullptr;
+        }
+
+        void operator()( unsigned int const span ) const
+        {
+            if ( pError ) return;
+            // A single thread pool spawns no threads.
+            Utility::WorkerPool serialPool( 1 );
+            if ( char const * const pSpanError = render( span, serialPool ) )
+                pError = pSpanError;
+        }
+
+        MIDIMelody        const &       melody          ;
+        std::vector<Span> const &       spans           ;
+        float             const * const pEdges          ;
+        float             const * const pVoiceData      ;
+        float             const * const pBackgroundData ;
+        float                   * const pOutputData     ;
+        unsigned int              const sampleRate      ;
+        unsigned int              const numberOfChannels;
+        unsigned int              const numberOfSamples ;
+        unsigned int              const crossfade       ;
+        OfflineRenderSettings           spanSettings    ;
+
+        mutable std::atomic<char const *> pError;
+    } renderer =
+    {
+        melody, spans, pEdges.get(), pVoiceData, pBackgroundData, pOutputData, sampleRate, numberOfChannels, numberOfSamples, crossfade, settings,
+        { nullptr }
+    };
+    renderer.spanSettings.voiceActivityThreshold = 0;
+
+    if ( spans.size() < workerPool.numberOfThreads() )
+    {
+        for ( std::size_t span( 0 ); span < spans.size(); ++span )
+        {
+            if ( char const * const pError = renderer.render( span, workerPool ) )
+                return pError;
+        }
+        return nullptr;
+    }
+    renderer.spanSettings.numberOfSegments = 1;
+    workerPool.parallelFor( static_cast<unsigned int>( spans.size() ), renderer );
+    return renderer.pError.load();
+}
+
+/// @} // group Melodify
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // offlineRenderer_hpp
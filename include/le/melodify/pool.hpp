@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file pool.hpp
+/// --------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef pool_hpp__D74F6E3A_865D_4618_92D8_3612B4009932
+#define pool_hpp__D74F6E3A_865D_4618_92D8_3612B4009932
+#pragma once
+//------------------------------------------------------------------------------
+#include "melodifyer.hpp"
+
+#include "le/utility/assert.hpp"
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Melodify
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class MelodifyerPool
+///
+/// \brief A thread safe pool of Melodifyer instances already set up for a
+/// given sample rate and number of channels.
+///
+/// Melodifyer::setup() allocates the DSP buffers internally (the allocator
+/// used by the SDK binary cannot be replaced) so, for applications that
+/// start and end sessions frequently, the allocations are instead amortized
+/// by recycling instances: once the pool is warmed up (see reserve()),
+/// acquiring and releasing an instance performs no memory allocation and no
+/// setup() call, which gives deterministic memory use and allocation-free
+/// session starts.
+///
+/// \note The pool must outlive all the Handles acquired from it.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class MelodifyerPool
+{
+private:
+    struct Releaser
+    {
+        void operator()( Melodifyer * const pMelodifyer ) const { pPool->release( pMelodifyer ); }
+        MelodifyerPool * pPool;
+    }; // struct Releaser
+
+public:
+    /// A Melodifyer exclusively owned by the holder and returned to the pool
+    /// on destruction.
+    typedef std::unique_ptr<Melodifyer, Releaser> Handle;
+
+    MelodifyerPool( unsigned int const sampleRate, unsigned int const numberOfChannels )
+        : sampleRate_( sampleRate ), numberOfChannels_( numberOfChannels ), numberOfInstances_( 0 ) {}
+
+    ~MelodifyerPool()
+    {
+        LE_ASSERT( idle_.size() == numberOfInstances_ );
+        for ( Melodifyer * const pMelodifyer : idle_ )
+            delete pMelodifyer;
+    }
+
+    /// <B>Effect:</B> Creates and sets up instances until the pool holds (at
+    /// least) <VAR>numberOfInstances</VAR> of them.<BR>
+    /// \return nullptr if successful, pointer to an error message string otherwise.
+    char const * reserve( unsigned int const numberOfInstances )
+    {
+        std::lock_guard<std::mutex> const lock( mutex_ );
+        if ( numberOfInstances <= numberOfInstances_ )
+            return nullptr;
+        // Room for every instance (including the checked out ones) so that
+        // release() never allocates.
+        idle_.reserve( numberOfInstances );
+        while ( numberOfInstances_ < numberOfInstances )
+        {
+            Melodifyer * const pMelodifyer( create() );
+            if ( !pMelodifyer )
+                return "Out of memory.";
+            idle_.push_back( pMelodifyer );
+            ++numberOfInstances_;
+        }
+        return nullptr;
+    }
+
+    /// <B>Effect:</B> Hands out an idle instance (or creates a new one if
+    /// there are none). The instance is reset, has the default gain settings
+    /// and still has the melody of its previous user set (i.e. a melody
+    /// should be attached before processing).<BR>
+    /// \return nullptr if successful, pointer to an error message string otherwise.
+    char const * acquire( Handle & handle )
+    {
+        Releaser const releaser = { this };
+        handle.reset();
+        Melodifyer * pMelodifyer( nullptr );
+        {
+            std::lock_guard<std::mutex> const lock( mutex_ );
+            if ( !idle_.empty() )
+            {
+                pMelodifyer = idle_.back();
+                idle_.pop_back();
+            }
+            else
+            {
+                // Make room for the instance's return up front so that
+                // release() never allocates.
+                idle_.reserve( numberOfInstances_ + 1 );
+                pMelodifyer = create();
+                if ( !pMelodifyer )
+                    return "Out of memory.";
+                ++numberOfInstances_;
+            }
+        }
+        pMelodifyer->reset();
+        pMelodifyer->setAutomaticVoiceGainCorrection( false );
+        pMelodifyer->setExtraVoiceGainCorrection    ( 1     );
+        handle = Handle( pMelodifyer, releaser );
+        return nullptr;
+    }
+
+    /// \return The total number of instances owned by the pool (idle and acquired).
+    unsigned int numberOfInstances() const
+    {
+        std::lock_guard<std::mutex> const lock( mutex_ );
+        return numberOfInstances_;
+    }
+
+    /// \return The number of instances available without creating new ones.
+    unsigned int numberOfIdleInstances() const
+    {
+        std::lock_guard<std::mutex> const lock( mutex_ );
+        return static_cast<unsigned int>( idle_.size() );
+    }
+
+    unsigned int sampleRate      () const { return sampleRate_      ; }
+    unsigned int numberOfChannels() const { return numberOfChannels_; }
+
+private:
+    Melodifyer * create() const
+    {
+        Melodifyer * const pMelodifyer( new ( std::nothrow ) Melodifyer );
+        if ( pMelodifyer && !pMelodifyer->setup( sampleRate_, numberOfChannels_ ) )
+        {
+            delete pMelodifyer;
+            return nullptr;
+        }
+        return pMelodifyer;
+    }
+
+    void release( Melodifyer * const pMelodifyer )
+    {
+        std::lock_guard<std::mutex> const lock( mutex_ );
+        idle_.push_back( pMelodifyer );
+    }
+
+private: // noncopyable
+    MelodifyerPool( MelodifyerPool const & );
+    void operator=( MelodifyerPool const & );
+
+private:
+    unsigned int const sampleRate_      ;
+    unsigned int const numberOfChannels_;
+
+    mutable std::mutex         mutex_            ;
+    std::vector<Melodifyer *>  idle_             ;
+    unsigned int               numberOfInstances_;
+}; // class MelodifyerPool
+
+/// @} // group Melodify
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // pool_hpp
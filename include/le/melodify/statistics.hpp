@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file statistics.hpp
+/// --------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef statistics_hpp__CDD7548B_2D62_4F9D_A53B_8EE3118A4559
+#define statistics_hpp__CDD7548B_2D62_4F9D_A53B_8EE3118A4559
+#pragma once
+//------------------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Melodify
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class ProcessingStatistics
+///
+/// \brief Cumulative, per stage, timing counters for Melodifyer based
+/// processing pipelines.
+///
+/// The counters are lock-free atomics so they can be updated concurrently
+/// (e.g. by the workers of renderOffline()) and read (e.g. by a UI thread)
+/// while processing is running. Instrumented functions take a (nullable)
+/// ProcessingStatistics pointer: passing nullptr disables the instrumentation
+/// at the cost of a single branch per measured stage (no clock is read).
+///
+/// The internals of Melodifyer::process() (analysis, pitch detection,
+/// resynthesis, voice gain correction and background mixing) run as one
+/// indivisible call into the SDK so they are reported as the single
+/// Melodify stage.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class ProcessingStatistics
+{
+public:
+    enum Stage
+    {
+        MelodyPositioning, ///< Restarting the melody timeline (seek()).
+        InputPreparation , ///< Gathering, delaying and converting input data.
+        Melodify         , ///< Melodifyer::process() itself.
+        OutputAssembly   , ///< Writing out, compensating and crossfading output data.
+        Bypass           , ///< Outputting the background alone for voice inactive regions (the sample count is the number of bypassed sample frames).
+
+        NumberOfStages
+    };
+
+    struct Counters
+    {
+        std::uint64_t nanoseconds; ///< Cumulative time spent in the stage.
+        std::uint64_t calls      ; ///< Number of times the stage was entered.
+        std::uint64_t samples    ; ///< Cumulative number of sample frames processed by the stage.
+    }; // struct Counters
+
+    ProcessingStatistics() { reset(); }
+
+    /// <B>Effect:</B> Zeroes all the counters (not atomic with respect to concurrent updates).<BR>
+    void reset()
+    {
+        for ( unsigned int stage( 0 ); stage < NumberOfStages; ++stage )
+        {
+            stages_[ stage ].nanoseconds.store( 0, std::memory_order_relaxed );
+            stages_[ stage ].calls      .store( 0, std::memory_order_relaxed );
+            stages_[ stage ].samples    .store( 0, std::memory_order_relaxed );
+        }
+    }
+
+    void add( Stage const stage, std::uint64_t const nanoseconds, std::uint64_t const samples )
+    {
+        stages_[ stage ].nanoseconds.fetch_add( nanoseconds, std::memory_order_relaxed );
+        stages_[ stage ].calls      .fetch_add( 1          , std::memory_order_relaxed );
+        stages_[ stage ].samples    .fetch_add( samples    , std::memory_order_relaxed );
+    }
+
+    /// \return A (per counter consistent) copy of the given stage's counters.
+    Counters counters( Stage const stage ) const
+    {
+        Counters const result =
+        {
+            stages_[ stage ].nanoseconds.load( std::memory_order_relaxed ),
+            stages_[ stage ].calls      .load( std::memory_order_relaxed ),
+            stages_[ stage ].samples    .load( std::memory_order_relaxed )
+        };
+        return result;
+    }
+
+    static char const * stageName( Stage const stage )
+    {
+        static char const * const names[ NumberOfStages ] = { "melody positioning", "input preparation", "melodify", "output assembly", "bypass" };
+        return names[ stage ];
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \class Timer
+    ///
+    /// \brief Scoped measurement of a single stage invocation (a no-op for a
+    /// null ProcessingStatistics pointer).
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+
+    class Timer
+    {
+    public:
+        Timer( ProcessingStatistics * const pStatistics, Stage const stage, unsigned int const numberOfSamples )
+            :
+            pStatistics_    ( pStatistics     ),
+            stage_          ( stage           ),
+            numberOfSamples_( numberOfSamples )
+        {
+            if ( pStatistics_ )
+                start_ = Clock::now();
+        }
+
+        ~Timer()
+        {
+            if ( pStatistics_ )
+                pStatistics_->add( stage_, std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - start_ ).count(), numberOfSamples_ );
+        }
+
+    private: // noncopyable
+        Timer( Timer const & );
+        void operator=( Timer const & );
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        ProcessingStatistics * const pStatistics_    ;
+        Stage                  const stage_          ;
+        unsigned int           const numberOfSamples_;
+        Clock::time_point            start_          ;
+    }; // class Timer
+
+private: // noncopyable
+    ProcessingStatistics( ProcessingStatistics const & );
+    void operator=( ProcessingStatistics const & );
+
+private:
+    struct AtomicCounters
+    {
+        std::atomic<std::uint64_t> nanoseconds;
+        std::atomic<std::uint64_t> calls      ;
+        std::atomic<std::uint64_t> samples    ;
+    }; // struct AtomicCounters
+
+    AtomicCounters stages_[ NumberOfStages ];
+}; // class ProcessingStatistics
+
+/// @} // group Melodify
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // statistics_hpp
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file stems.hpp
+/// ---------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef stems_hpp__A7539624_E4A2_492C_970F_61A9E93CE19A
+#define stems_hpp__A7539624_E4A2_492C_970F_61A9E93CE19A
+#pragma once
+//------------------------------------------------------------------------------
+#include "adapters.hpp"
+#include "offlineRenderer.hpp"
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Melodify
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// renderVoiceStem()
+// -----------------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Renders the dry (unmixed) melodified voice stem.
+///
+/// The stem is rendered at unity gain with the automatic voice gain
+/// correction disabled (the correction is computed from, and applied
+/// together with, the background mix inside the SDK so its gain curve is not
+/// available separately). The final mix, at any voice and background levels,
+/// is then a cheap remix() instead of a full re-render.
+///
+/// The parameters are the same as for renderOffline() minus the background.
+/// <VAR>pStemData</VAR> may be the same buffer as <VAR>pVoiceData</VAR>.
+///
+/// \return nullptr if successful, pointer to an error message string
+/// otherwise.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline char const * renderVoiceStem
+(
+    MIDIMelody            const &       melody          ,
+    unsigned int                  const sampleRate      ,
+    unsigned int                  const numberOfChannels,
+    float                 const * const pVoiceData      ,
+    float                       * const pStemData       ,
+    unsigned int                  const numberOfSamples ,
+    Utility::WorkerPool           &     workerPool      ,
+    OfflineRenderSettings const &       settings = OfflineRenderSettings()
+)
+{
+    OfflineRenderSettings stemSettings( settings );
+    stemSettings.automaticVoiceGainCorrection = false;
+    stemSettings.extraVoiceGainCorrection     = 1;
+    return renderOffline( melody, sampleRate, numberOfChannels, pVoiceData, nullptr, pStemData, numberOfSamples, workerPool, stemSettings );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// remix()
+// -------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Mixes a voice stem (as produced by renderVoiceStem()) with a
+/// background:
+/// output = voiceGain * stem + backgroundGain * background.
+///
+/// \param pStemData       Interleaved voice stem.
+/// \param pBackgroundData Interleaved background, aligned with the stem
+///                        (i.e. without the latency padding required by
+///                        Melodifyer::process()). Optional, may be nullptr.
+/// \param pOutputData     Interleaved output (may be the same buffer as either
+///                        input).
+/// \param numberOfSamples Number of samples (sample frames times the number of
+///                        channels).
+///
+/// The loop is a plain, branch free multiply-add that compilers auto-vectorize.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline void remix
+(
+    float const * const pStemData      ,
+    float const * const pBackgroundData,
+    float       * const pOutputData    ,
+    unsigned int  const numberOfSamples,
+    float         const voiceGain      ,
+    float         const backgroundGain = 1
+)
+{
+    if ( pBackgroundData )
+    {
+        for ( unsigned int sample( 0 ); sample < numberOfSamples; ++sample )
+            pOutputData[ sample ] = voiceGain * pStemData[ sample ] + backgroundGain * pBackgroundData[ sample ];
+    }
+    else
+    {
+        for ( unsigned int sample( 0 ); sample < numberOfSamples; ++sample )
+            pOutputData[ sample ] = voiceGain * pStemData[ sample ];
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// remixIntoBed()
+// --------------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Mixes a mono voice stem (as produced by renderVoiceStem() for one
+/// channel) into a background bed with an arbitrary number of channels
+/// (e.g. 5.1).
+///
+/// \param pStemData          Mono voice stem.
+/// \param pBackgroundData    Interleaved background bed, aligned with the
+///                           stem. Optional, may be nullptr.
+/// \param pOutputData        Interleaved output (may be the same buffer as
+///                           either input, the stem buffer then has to hold
+///                           numberOfChannels * numberOfSamples samples).
+/// \param numberOfSamples    Number of sample frames.
+/// \param pVoiceChannelGains Per output channel voice gains (see
+///                           processMultichannel()).
+///
+/// \note Without <VAR>pVoiceChannelGains</VAR> the voice goes into every
+/// channel at unity gain, i.e. also into the LFE and surround channels, so
+/// on a 5.1 bed it ends up about 7.8 dB louder than on a mono or stereo one.
+/// The recommended layout is the usual dialogue one: the voice only in the
+/// centre channel, at unity gain (or, for beds without a centre channel, as
+/// an equal power phantom centre in the front left and right channels), see
+/// centreVoiceGains().
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline void remixIntoBed
+(
+    float const * const pStemData         ,
+    float const * const pBackgroundData   ,
+    float       * const pOutputData       ,
+    unsigned int  const numberOfChannels  ,
+    unsigned int  const numberOfSamples   ,
+    float const * const pVoiceChannelGains = nullptr
+)
+{
+    Detail::BedKernel const kernel = { pStemData, pBackgroundData, pOutputData, pVoiceChannelGains, numberOfChannels, numberOfSamples };
+    Detail::dispatch( numberOfChannels, kernel );
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// centreVoiceGains()
+// ------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Fills the recommended remixIntoBed() (and processMultichannel())
+/// voice gains for a bed in the default WAVE channel order (front left,
+/// front right, front centre, LFE, ...).
+///
+/// Beds with a centre channel (3 or 5 or more channels, e.g. L R C, 5.0, 5.1,
+/// 7.1) get the voice in the centre only, other beds (e.g. quad) get it in
+/// the front left and right channels at -3 dB each.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline void centreVoiceGains( unsigned int const numberOfChannels, float * const pVoiceChannelGains )
+{
+    std::fill_n( pVoiceChannelGains, numberOfChannels, 0.0f );
+    bool const hasCentre( numberOfChannels == 3 || numberOfChannels >= 5 );
+    if ( hasCentre )
+        pVoiceChannelGains[ 2 ] = 1;
+    else if ( numberOfChannels >= 2 )
+        pVoiceChannelGains[ 0 ] = pVoiceChannelGains[ 1 ] = 0.70710678f;
+    else if ( numberOfChannels == 1 )
+        pVoiceChannelGains[ 0 ] = 1;
+}
+
+/// @} // group Melodify
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // stems_hpp
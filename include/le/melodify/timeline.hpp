@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file timeline.hpp
+/// ------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef timeline_hpp__A4F1C6D2_7E3B_4D85_8C0A_5B9E2D4F6A13
+#define timeline_hpp__A4F1C6D2_7E3B_4D85_8C0A_5B9E2D4F6A13
+#pragma once
+//------------------------------------------------------------------------------
+#include "melodifyer.hpp"
+#include "midiMelody.hpp"
+
+#include <algorithm>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Melodify
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// recommendedPreRollInSamples()
+// -----------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief The amount of input after which the output of a freshly reset
+/// Melodifyer is expected to no longer (audibly) depend on whether it was
+/// started at that point or earlier.
+///
+/// This is a heuristic (four times the latency), not a documented property
+/// of the SDK: how quickly the internal state forgets its starting point is
+/// not specified. benchmark/prerollCheck measures the residual difference
+/// between restarted and continuous renders for a range of pre-rolls (see
+/// the README); rerun it for new SDK drops and adjust this value to its
+/// result.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline unsigned int recommendedPreRollInSamples( Melodifyer const & melodifyer ) { return 4 * melodifyer.latencyInSamples(); }
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// seek()
+// ------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Positions the melody timeline of a Melodifyer for processing that
+/// starts at an arbitrary point in time (rather than at the beginning of the
+/// melody as after reset()).
+///
+/// \param melodifyer       A Melodifyer for which setup() was already called.
+/// \param offsetInSamples  The point in the voice stream (and the melody) to
+///                         seek to.
+/// \param preRollInSamples [in] The desired pre-roll (zero selects
+///                         recommendedPreRollInSamples()).<BR>
+///                         [out] The actual pre-roll (less than desired when
+///                         seeking close to the start).
+///
+/// <B>Postconditions:</B> The Melodifyer is reset and the melody starts at
+/// <VAR>offsetInSamples</VAR> - <VAR>preRollInSamples</VAR>. The caller must
+/// process (and discard the output of) the <VAR>preRollInSamples</VAR>
+/// sample frames of input preceding <VAR>offsetInSamples</VAR> after which
+/// the output approximates that of processing started from the beginning
+/// (how closely depends on the pre-roll, see recommendedPreRollInSamples()).
+/// As always, the output lags the input by latencyInSamples().
+///
+/// This enables partial re-renders of edited regions and preview scrubbing
+/// without processing everything before the point of interest.
+///
+/// \return nullptr if successful, pointer to an error message string
+/// otherwise.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline char const * seek
+(
+    Melodifyer         &       melodifyer      ,
+    MIDIMelody   const &       melody          ,
+    unsigned int         const sampleRate      ,
+    unsigned int         const offsetInSamples ,
+    unsigned int       &       preRollInSamples
+)
+{
+    if ( !preRollInSamples )
+        preRollInSamples = recommendedPreRollInSamples( melodifyer );
+    preRollInSamples = std::min( preRollInSamples, offsetInSamples );
+    unsigned int const start( offsetInSamples - preRollInSamples );
+
+    melodifyer.reset();
+    return setMelody( melodifyer, start ? melody.trimmed( start / double( sampleRate ) ) : melody );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// primeAt()
+// ---------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Brings a Melodifyer into (an approximation of) the state another
+/// Melodifyer would be in after processing the given voice and background
+/// streams from their start up to <VAR>position</VAR> without reprocessing
+/// that whole prefix.
+///
+/// The internal state of a Melodifyer cannot be copied (see the Melodifyer
+/// class notes) but, apart from the melody position, it is assumed to depend
+/// mostly on the most recent input (the residual dependence on older input
+/// is what recommendedPreRollInSamples() bounds, see there). The melody is
+/// therefore restarted (trimmed) at
+/// <VAR>position</VAR> - <VAR>preRollInSamples</VAR> and only the pre-roll
+/// part of the input is (re)processed. This makes cheap forked renders
+/// possible: any number of instances, e.g. with different gain settings or
+/// backgrounds, can continue from a common point at the cost of
+/// <VAR>preRollInSamples</VAR> each.
+///
+/// \param melodifyer       A Melodifyer for which setup() was already called
+///                         (its gain settings are left untouched).
+/// \param pVoiceData       The voice stream (interleaved, as it is passed to
+///                         Melodifyer::process()), at least
+///                         <VAR>position</VAR> sample frames long.
+/// \param pBackgroundData  The background stream (optional, may be nullptr)
+///                         with the same length and layout.
+/// \param position         The position (in sample frames) from which the
+///                         next process() call continues the streams.
+/// \param preRollInSamples The amount of input to process before
+///                         <VAR>position</VAR> (zero selects
+///                         recommendedPreRollInSamples()).
+///
+/// \return nullptr if successful, pointer to an error message string
+/// otherwise.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline char const * primeAt
+(
+    Melodifyer         &       melodifyer      ,
+    MIDIMelody   const &       melody          ,
+    unsigned int         const sampleRate      ,
+    unsigned int         const numberOfChannels,
+    float        const * const pVoiceData      ,
+    float        const * const pBackgroundData ,
+    unsigned int         const position        ,
+    unsigned int         const preRollInSamples = 0
+)
+{
+    unsigned int preRoll( preRollInSamples );
+    if ( char const * const pError = seek( melodifyer, melody, sampleRate, position, preRoll ) )
+        return pError;
+    unsigned int const start( position - preRoll );
+
+    float discardedOutput[ 1024 ];
+    unsigned int const chunkFrames( sizeof( discardedOutput ) / sizeof( discardedOutput[ 0 ] ) / numberOfChannels );
+    for ( unsigned int frame( start ); frame < position; frame += chunkFrames )
+    {
+        unsigned int const frames( std::min( chunkFrames, position - frame ) );
+        melodifyer.process
+        (
+            &pVoiceData[ frame * numberOfChannels ],
+            pBackgroundData ? &pBackgroundData[ frame * numberOfChannels ] : nullptr,
+            discardedOutput,
+            frames
+        );
+    }
+    return nullptr;
+}
+
+/// @} // group Melodify
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // timeline_hpp
@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file parallel.hpp
+/// ------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef parallel_hpp__EE5F48F8_DA1B_48EC_A436_7B580083A3B8
+#define parallel_hpp__EE5F48F8_DA1B_48EC_A436_7B580083A3B8
+#pragma once
+//------------------------------------------------------------------------------
+#include "abi.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace Utility
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Utility
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class WorkerPool
+///
+/// \brief A minimal persistent thread pool for fork-join style batch jobs.
+///
+/// The worker threads are created once (in the constructor) and then sleep
+/// between jobs so that repeated parallelFor() calls (e.g. one per processing
+/// block) do not pay the thread creation cost. The calling thread always
+/// participates in the work so a pool created with one thread does not spawn
+/// any additional threads at all.
+///
+/// \note parallelFor() is not reentrant: only one thread may submit work to a
+/// given WorkerPool instance at a time.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class WorkerPool
+{
+public:
+    /// \param numberOfThreads Total number of threads (including the calling
+    ///                        thread) that will execute the submitted work.
+    ///                        Zero selects the number of hardware threads.
+    explicit WorkerPool( unsigned int numberOfThreads = 0 )
+        :
+        pJob_         ( nullptr ),
+        pContext_     ( nullptr ),
+        jobSize_      ( 0       ),
+        nextItem_     ( 0       ),
+        activeWorkers_( 0       ),
+        generation_   ( 0       ),
+        stop_         ( false   )
+    {
+        if ( !numberOfThreads )
+            numberOfThreads = std::max( std::thread::hardware_concurrency(), 1U );
+        workers_.reserve( numberOfThreads - 1 );
+        for ( unsigned int worker( 1 ); worker < numberOfThreads; ++worker )
+            workers_.push_back( std::thread( &WorkerPool::workerLoop, this ) );
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> const lock( mutex_ );
+            stop_ = true;
+        }
+        wakeUp_.notify_all();
+        for ( std::thread & worker : workers_ )
+            worker.join();
+    }
+
+    unsigned int numberOfThreads() const { return static_cast<unsigned int>( workers_.size() ) + 1; }
+
+    /// <B>Effect:</B> Calls <VAR>functor</VAR>( index ) for every index in
+    /// [0, <VAR>numberOfItems</VAR>) distributing the calls across the pool
+    /// threads and blocks until all of them have completed.<BR>
+    /// Items are handed out dynamically (one at a time) so unevenly sized
+    /// items still keep all threads busy.
+    template <typename Functor>
+    void parallelFor( unsigned int const numberOfItems, Functor & functor )
+    {
+        if ( workers_.empty() || numberOfItems < 2 )
+        {
+            for ( unsigned int item( 0 ); item < numberOfItems; ++item )
+                functor( item );
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> const lock( mutex_ );
+            pJob_          = &invoke<Functor>;
+            pContext_      = &functor;
+            jobSize_       = numberOfItems;
+            nextItem_      = 0;
+            activeWorkers_ = static_cast<unsigned int>( workers_.size() );
+            ++generation_;
+        }
+        wakeUp_.notify_all();
+
+        runJob();
+
+        std::unique_lock<std::mutex> lock( mutex_ );
+        jobDone_.wait( lock, [this]{ return activeWorkers_ == 0; } );
+        pJob_     = nullptr;
+        pContext_ = nullptr;
+    }
+
+private:
+    typedef void (*Job)( void * pContext, unsigned int item );
+
+    template <typename Functor>
+    static void invoke( void * const pContext, unsigned int const item ) { ( *static_cast<Functor *>( pContext ) )( item ); }
+
+    void runJob()
+    {
+        for ( unsigned int item( nextItem_++ ); item < jobSize_; item = nextItem_++ )
+            pJob_( pContext_, item );
+    }
+
+    void workerLoop()
+    {
+        unsigned int seenGeneration( 0 );
+        std::unique_lock<std::mutex> lock( mutex_ );
+        for ( ; ; )
+        {
+            wakeUp_.wait( lock, [&]{ return stop_ || generation_ != seenGeneration; } );
+            if ( stop_ )
+                return;
+            seenGeneration = generation_;
+            lock.unlock();
+            runJob();
+            lock.lock();
+            if ( --activeWorkers_ == 0 )
+                jobDone_.notify_one();
+        }
+    }
+
+private: // noncopyable
+    WorkerPool( WorkerPool const & );
+    void operator=( WorkerPool const & );
+
+private:
+    std::vector<std::thread>  workers_;
+    std::mutex                mutex_  ;
+    std::condition_variable   wakeUp_ ;
+    std::condition_variable   jobDone_;
+
+    Job                       pJob_         ;
+    void                    * pContext_     ;
+    unsigned int              jobSize_      ;
+    std::atomic<unsigned int> nextItem_     ;
+    unsigned int              activeWorkers_;
+    unsigned int              generation_   ;
+    bool                      stop_         ;
+}; // class WorkerPool
+
+/// @} // group Utility
+
+//------------------------------------------------------------------------------
+} // namespace Utility
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // parallel_hpp
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file ringBuffer.hpp
+/// --------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef ringBuffer_hpp__BEE4B658_8A86_4DA6_B68A_656A2FC146CA
+#define ringBuffer_hpp__BEE4B658_8A86_4DA6_B68A_656A2FC146CA
+#pragma once
+//------------------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace Utility
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Utility
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class RingBuffer
+///
+/// \brief A fixed capacity, wait-free, single producer single consumer FIFO.
+///
+/// The storage is allocated once, in the constructor, so none of the
+/// producer or consumer operations lock or allocate which makes the class
+/// suitable for passing data to and from real time (audio) threads. Exactly
+/// one thread may call the producer functions (push(), write(), freeSpace())
+/// and exactly one (possibly different) thread may call the consumer functions
+/// (pop(), read(), front(), size()) at any one time.
+///
+/// \note T should be a trivially copyable type (elements are copied in and
+/// out, the storage is never destroyed element by element).
+///
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+class RingBuffer
+{
+public:
+    /// \param capacity Minimum number of elements the buffer can hold (rounded
+    ///                 up to a power of two). Check with operator!() whether
+    ///                 the storage allocation succeeded.
+    explicit RingBuffer( unsigned int const capacity )
+        :
+        mask_( roundUpToPowerOfTwo( std::max( capacity, 1U ) ) - 1 ),
+        pStorage_( new ( std::nothrow ) T[ mask_ + 1 ] ),
+        writePosition_( 0 ),
+        readPosition_ ( 0 )
+    {}
+
+    bool operator!() const { return !pStorage_; }
+
+    unsigned int capacity() const { return mask_ + 1; }
+
+    /// \name Producer interface
+    /// @{
+    unsigned int freeSpace() const { return capacity() - ( writePosition_.load( std::memory_order_relaxed ) - readPosition_.load( std::memory_order_acquire ) ); }
+
+    /// \return False if the buffer is full (the element is not added).
+    bool push( T const & element ) { return write( &element, 1 ) == 1; }
+
+    /// <B>Effect:</B> Appends as many of the given elements as there is room for.<BR>
+    /// \return The number of elements actually written.
+    unsigned int write( T const * const pElements, unsigned int const numberOfElements )
+    {
+        unsigned int const position( writePosition_.load( std::memory_order_relaxed ) );
+        unsigned int const count   ( std::min( numberOfElements, freeSpace() )        );
+        unsigned int const first   ( std::min( count, capacity() - ( position & mask_ ) ) );
+        std::copy_n( pElements        , first        , &pStorage_[ position & mask_ ] );
+        std::copy_n( pElements + first, count - first, &pStorage_[ 0              ] );
+        writePosition_.store( position + count, std::memory_order_release );
+        return count;
+    }
+    /// @}
+
+    /// \name Consumer interface
+    /// @{
+    unsigned int size() const { return writePosition_.load( std::memory_order_acquire ) - readPosition_.load( std::memory_order_relaxed ); }
+
+    /// \return The oldest element (without removing it) or nullptr if the
+    /// buffer is empty.
+    T const * front() const { return size() ? &pStorage_[ readPosition_.load( std::memory_order_relaxed ) & mask_ ] : nullptr; }
+
+    /// \return False if the buffer is empty.
+    bool pop( T & element ) { return read( &element, 1 ) == 1; }
+
+    /// <B>Effect:</B> Removes up to <VAR>numberOfElements</VAR> of the oldest elements.<BR>
+    /// \return The number of elements actually read.
+    unsigned int read( T * const pElements, unsigned int const numberOfElements )
+    {
+        unsigned int const position( readPosition_.load( std::memory_order_relaxed )  );
+        unsigned int const count   ( std::min( numberOfElements, size() )             );
+        unsigned int const first   ( std::min( count, capacity() - ( position & mask_ ) ) );
+        std::copy_n( &pStorage_[ position & mask_ ], first        , pElements         );
+        std::copy_n( &pStorage_[ 0               ], count - first, pElements + first );
+        readPosition_.store( position + count, std::memory_order_release );
+        return count;
+    }
+    /// @}
+
+private:
+    static unsigned int roundUpToPowerOfTwo( unsigned int value )
+    {
+        --value;
+        for ( unsigned int shift( 1 ); shift < sizeof( value ) * 8; shift *= 2 )
+            value |= value >> shift;
+        return value + 1;
+    }
+
+private: // noncopyable
+    RingBuffer( RingBuffer const & );
+    void operator=( RingBuffer const & );
+
+private:
+    unsigned int              const mask_    ;
+    std::unique_ptr<T[]>      const pStorage_;
+
+    // The (free running, wrapping) positions live on separate cache lines so
+    // that the producer and the consumer do not falsely share them.
+    alignas( 64 ) std::atomic<unsigned int> writePosition_;
+    alignas( 64 ) std::atomic<unsigned int> readPosition_ ;
+}; // class RingBuffer
+
+/// @} // group Utility
+
+//------------------------------------------------------------------------------
+} // namespace Utility
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // ringBuffer_hpp
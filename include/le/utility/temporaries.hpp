@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file temporaries.hpp
+/// ---------------------
+///
+/// Copyright (c) 2015. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef temporaries_hpp__0E15C4D2_F386_4B6A_946D_DC43F6CA5C12
+#define temporaries_hpp__0E15C4D2_F386_4B6A_946D_DC43F6CA5C12
+#pragma once
+//------------------------------------------------------------------------------
+#include "filesystem.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif // _WIN32
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace Utility
+{
+//------------------------------------------------------------------------------
+
+/// \addtogroup Utility
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns the full path of the given name within Temporaries.
+///
+/// fullPath() returns a pointer to a shared buffer so all callers in the
+/// process are serialized (by a single, process wide mutex) and get a copy.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline std::string temporaryPath( char const * const name )
+{
+    static std::mutex fullPathMutex;
+    std::lock_guard<std::mutex> const lock( fullPathMutex );
+    return fullPath<Temporaries>( name );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns a "<process ID>_<counter>" tag that is different for every
+/// call (from any thread of any process) for use in scratch file names.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+inline std::string uniqueTag()
+{
+    static std::atomic<unsigned int> counter( 0 );
+#ifdef _WIN32
+    unsigned int const processID( static_cast<unsigned int>( ::_getpid() ) );
+#else
+    unsigned int const processID( static_cast<unsigned int>( ::getpid () ) );
+#endif // _WIN32
+    char tag[ 24 ];
+    std::snprintf( tag, sizeof( tag ), "%u_%u", processID, counter++ );
+    return tag;
+}
+
+/// @} // group Utility
+
+//------------------------------------------------------------------------------
+} // namespace Utility
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // temporaries_hpp